@@ -0,0 +1,176 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_api.cpp
+//  project4
+//
+//  Per-call overhead of the solver library versus launching the drone
+//  executable once per instance (the way the dispatcher used to call it).
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_api.cpp binary_input.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp neighbor_graph.cpp mst_engines.cpp spatial.cpp online_tour.cpp -o bench_api
+//      ./bench_api ./drone [num_locations] [iterations]
+//
+
+#include "drone.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <random>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+
+// Runs the executable once with input_path on stdin and stdout discarded
+static bool launch_once(const char *exe_path, const char *mode, const char *input_path) {
+    
+    pid_t pid = fork();
+    
+    if (pid == 0) {
+        
+        int in_fd = open(input_path, O_RDONLY);
+        int out_fd = open("/dev/null", O_WRONLY);
+        
+        if (in_fd < 0 || out_fd < 0) {
+            
+            _exit(127);
+            
+        }
+        
+        dup2(in_fd, 0);
+        dup2(out_fd, 1);
+        
+        execl(exe_path, exe_path, "--mode", mode, static_cast<char *>(nullptr));
+        
+        _exit(127);
+        
+    }
+    
+    int status = 0;
+    
+    return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    
+}
+
+template <typename Solve>
+static double time_library(Solve solve, size_t iterations) {
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    for (size_t i = 0; i < iterations; i++) {
+        
+        solve();
+        
+    }
+    
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(iterations);
+    
+}
+
+int main(int argc, char** argv) {
+    
+    if (argc < 2) {
+        
+        std::cerr << "Usage: " << argv[0] << " <path to drone> [num_locations] [iterations]\n";
+        
+        return 1;
+        
+    }
+    
+    const char *exe_path = argv[1];
+    size_t num_locations = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 10;
+    size_t iterations = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 200;
+    
+    // Normal locations only, so MST mode never hits an unreachable pair
+    std::mt19937 rng(281);
+    std::uniform_int_distribution<int> coord(0, 1000);
+    
+    std::vector<Coordinate> coords(num_locations);
+    
+    for (Coordinate &c : coords) {
+        
+        c.x = coord(rng);
+        c.y = coord(rng);
+        
+    }
+    
+    char input_path[] = "/tmp/bench_api_XXXXXX";
+    int fd = mkstemp(input_path);
+    
+    if (fd < 0) {
+        
+        std::cerr << "Error: could not create temporary input file\n";
+        
+        return 1;
+        
+    }
+    
+    std::string text = std::to_string(num_locations) + "\n";
+    
+    for (const Coordinate &c : coords) {
+        
+        text += std::to_string(c.x) + " " + std::to_string(c.y) + "\n";
+        
+    }
+    
+    if (write(fd, text.data(), text.size()) != static_cast<ssize_t>(text.size())) {
+        
+        std::cerr << "Error: could not write temporary input file\n";
+        
+        return 1;
+        
+    }
+    
+    close(fd);
+    
+    Drone drone;
+    
+    struct Case {
+        
+        const char *mode;
+        double library_us;
+        
+    };
+    
+    std::vector<Case> cases = {
+        { "MST", time_library([&]() { drone.solve_mst(coords.data(), coords.size()); }, iterations) },
+        { "FASTTSP", time_library([&]() { drone.solve_fast_tsp(coords.data(), coords.size()); }, iterations) },
+        { "OPTTSP", time_library([&]() { drone.solve_opt_tsp(coords.data(), coords.size()); }, iterations) }
+    };
+    
+    std::cout << "locations: " << num_locations << ", iterations: " << iterations << "\n";
+    std::cout << "mode        library (us/call)    process (us/call)\n";
+    
+    for (const Case &c : cases) {
+        
+        auto start = std::chrono::steady_clock::now();
+        
+        for (size_t i = 0; i < iterations; i++) {
+            
+            if (!launch_once(exe_path, c.mode, input_path)) {
+                
+                std::cerr << "Error: " << exe_path << " failed\n";
+                
+                unlink(input_path);
+                
+                return 1;
+                
+            }
+            
+        }
+        
+        double process_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(iterations);
+        
+        std::printf("%-10s %18.2f %20.2f\n", c.mode, c.library_us, process_us);
+        
+    }
+    
+    unlink(input_path);
+    
+    return 0;
+    
+}
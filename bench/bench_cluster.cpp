@@ -0,0 +1,117 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_cluster.cpp
+//  project4
+//
+//  Clustered FASTTSP (Drone::set_clusters()) against the monolithic
+//  insertion tour: stage timings, total time and tour length relative to
+//  the monolithic one, for several cluster counts. Uniform and clustered
+//  locations.
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_cluster.cpp binary_input.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp neighbor_graph.cpp mst_engines.cpp online_tour.cpp spatial.cpp -o bench_cluster
+//      ./bench_cluster [num_locations]
+//
+//  Above 100000 locations the monolithic tour (quadratic) is skipped.
+//
+
+#include "drone.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+const size_t cluster_counts[] = { 4, 16, 64, 256, 1024 };
+
+}
+
+int main(int argc, char** argv) {
+    
+    size_t num_locations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    
+    std::mt19937 rng(41);
+    std::uniform_int_distribution<int> coord(-1000000, 1000000);
+    std::normal_distribution<double> spread(0, 20000);
+    
+    for (int clustered = 0; clustered < 2; clustered++) {
+        
+        std::vector<Coordinate> coords(num_locations);
+        std::vector<Coordinate> centers(64);
+        
+        for (Coordinate &c : centers) {
+            
+            c = { coord(rng), coord(rng) };
+            
+        }
+        
+        for (size_t i = 0; i < num_locations; i++) {
+            
+            const Coordinate &center = centers[i % centers.size()];
+            
+            coords[i] = clustered ? Coordinate{ center.x + static_cast<int>(spread(rng)), center.y + static_cast<int>(spread(rng)) }
+            : Coordinate{ coord(rng), coord(rng) };
+            
+        }
+        
+        std::printf("%s, %zu locations\n", clustered ? "clustered" : "uniform", num_locations);
+        std::printf("  clusters  partition s  sub-tours s  stitch s   total s        length  vs monolithic\n");
+        
+        Drone drone;
+        
+        double monolithic = 0;
+        
+        if (num_locations <= 100000) {
+            
+            auto start = std::chrono::steady_clock::now();
+            
+            monolithic = drone.solve_fast_tsp(coords.data(), coords.size()).total_distance;
+            
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            
+            std::printf("  %8s  %11s  %11s  %8s  %8.3f  %12.0f\n", "1", "-", "-", "-", seconds, monolithic);
+            
+        }
+        
+        for (size_t clusters : cluster_counts) {
+            
+            if (clusters * 3 > num_locations) {
+                
+                break;
+                
+            }
+            
+            drone.set_clusters(clusters);
+            
+            auto start = std::chrono::steady_clock::now();
+            
+            double length = drone.solve_fast_tsp(coords.data(), coords.size()).total_distance;
+            
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            
+            const ClusterStats &stats = drone.get_cluster_stats();
+            
+            std::printf("  %8zu  %11.3f  %11.3f  %8.3f  %8.3f  %12.0f", stats.num_clusters, stats.partition_seconds,
+                        stats.subtour_seconds, stats.stitch_seconds, seconds, length);
+            
+            if (monolithic > 0) {
+                
+                std::printf("  %+12.2f%%", 100 * (length / monolithic - 1));
+                
+            }
+            
+            std::printf("\n");
+            
+        }
+        
+        drone.set_clusters(0);
+        
+    }
+    
+    return 0;
+    
+}
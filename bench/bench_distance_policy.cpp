@@ -0,0 +1,107 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_distance_policy.cpp
+//  project4
+//
+//  One solve per distance policy (distance_policy.hpp): Prim on locations
+//  without Medical ones (EuclideanDistance) and on locations in every zone
+//  with Border locations on both axes (ZoneDistance), arbitrary insertion
+//  (EuclideanDistance) and OPTTSP (MatrixDistance). Prints the best of
+//  three run times and the total of each; run the same file against an
+//  older build of the library for the before column of distance_policy.hpp.
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_distance_policy.cpp binary_input.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp mst_engines.cpp neighbor_graph.cpp online_tour.cpp spatial.cpp -o bench_distance_policy
+//      ./bench_distance_policy [num_locations] [opt_locations]
+//
+//  Defaults: 20000 locations for MST and FASTTSP, 18 for OPTTSP.
+//
+
+#include "drone.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+const int runs = 3;
+
+std::vector<Coordinate> make_locations(size_t count, int min_coord, bool borders, unsigned seed) {
+    
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coord(min_coord, 1000000);
+    
+    std::vector<Coordinate> coords;
+    
+    // Border locations joining Medical to Normal
+    for (int i = 1; borders && i <= 100; i++) {
+        
+        coords.push_back({ -i * 10000, 0 });
+        coords.push_back({ 0, -i * 10000 });
+        
+    }
+    
+    while (coords.size() < count) {
+        
+        coords.push_back({ coord(rng), coord(rng) });
+        
+    }
+    
+    return coords;
+    
+}
+
+// Best of runs wall times; total is the solve's result
+void time_solve(const char *name, const std::function<double()> &solve) {
+    
+    double best = 0;
+    double total = 0;
+    
+    for (int run = 0; run < runs; run++) {
+        
+        auto start = std::chrono::steady_clock::now();
+        
+        total = solve();
+        
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        best = (run == 0) ? seconds : std::min(best, seconds);
+        
+    }
+    
+    std::printf("%-32s %8.3f s   %.2f\n", name, best, total);
+    
+}
+
+}
+
+int main(int argc, char** argv) {
+    
+    size_t num_locations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    size_t opt_locations = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 18;
+    
+    std::vector<Coordinate> no_medical = make_locations(num_locations, 0, false, 50);
+    std::vector<Coordinate> all_zones = make_locations(num_locations, -1000000, true, 50);
+    std::vector<Coordinate> small = make_locations(opt_locations, -1000000, false, 50);
+    
+    Drone drone;
+    
+    std::printf("%zu locations (OPTTSP %zu), best of %d\n", num_locations, opt_locations, runs);
+    
+    time_solve("MST, no Medical", [&]() { return drone.solve_mst(no_medical.data(), no_medical.size()).total_weight; });
+    
+    time_solve("MST, all zones", [&]() { return drone.solve_mst(all_zones.data(), all_zones.size()).total_weight; });
+    
+    time_solve("FASTTSP", [&]() { return drone.solve_fast_tsp(all_zones.data(), all_zones.size()).total_distance; });
+    
+    time_solve("OPTTSP", [&]() { return drone.solve_opt_tsp(small.data(), small.size()).total_distance; });
+    
+    return 0;
+    
+}
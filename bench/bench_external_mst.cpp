@@ -0,0 +1,145 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_external_mst.cpp
+//  project4
+//
+//  The out-of-core MST (external_mst.hpp) at a few memory limits against
+//  the in-memory Borůvka engine, on uniform and clustered locations in all
+//  four quadrants (with Border locations on both axes). Each row prints the
+//  tiles, split passes, tiles loaded by cross-tile searches and run edges,
+//  and fails if the total differs from Borůvka's. The input is a binary
+//  file in memory, so the spool pass costs a copy; spill files go to
+//  $TMPDIR (default /tmp).
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_external_mst.cpp binary_input.cpp external_mst.cpp mst_engines.cpp spatial.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp neighbor_graph.cpp online_tour.cpp -o bench_external_mst
+//      ./bench_external_mst [num_locations]
+//
+
+#include "drone.hpp"
+#include "binary_input.hpp"
+#include "external_mst.hpp"
+#include "mst_engines.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+}
+
+void make_locations(size_t count, bool clustered, std::vector<Coordinate> &coords) {
+    
+    std::mt19937 rng(49);
+    std::uniform_int_distribution<int> coord(-1000000, 1000000);
+    std::normal_distribution<double> spread(0, 20000);
+    
+    coords.clear();
+    
+    // Border locations along both axes
+    for (int i = 1; i <= 100; i++) {
+        
+        coords.push_back({ -i * 10000, 0 });
+        coords.push_back({ 0, -i * 10000 });
+        
+    }
+    
+    std::vector<Coordinate> centers(100);
+    
+    for (Coordinate &center : centers) {
+        
+        center = { coord(rng), coord(rng) };
+        
+    }
+    
+    while (coords.size() < count) {
+        
+        if (clustered) {
+            
+            const Coordinate &center = centers[coords.size() % centers.size()];
+            
+            coords.push_back({ center.x + static_cast<int>(std::lround(spread(rng))),
+                               center.y + static_cast<int>(std::lround(spread(rng))) });
+            
+        }
+        
+        else {
+            
+            coords.push_back({ coord(rng), coord(rng) });
+            
+        }
+        
+    }
+    
+}
+
+}
+
+int main(int argc, char** argv) {
+    
+    size_t num_locations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    
+    const char *spill_dir = std::getenv("TMPDIR");
+    
+    bool ok = true;
+    
+    for (bool clustered : { false, true }) {
+        
+        std::vector<Coordinate> coords;
+        
+        make_locations(num_locations, clustered, coords);
+        
+        std::ostringstream binary;
+        
+        write_binary_input(binary, coords.data(), coords.size(), false);
+        
+        std::string bytes = binary.str();
+        
+        MSTResult in_memory;
+        
+        auto start = std::chrono::steady_clock::now();
+        
+        boruvka_mst(coords.data(), coords.size(), in_memory);
+        
+        std::printf("%zu %s locations: boruvka %.2f s, weight %.2f\n", coords.size(), clustered ? "clustered" : "uniform",
+                    seconds_since(start), in_memory.total_weight);
+        std::printf("  limit      seconds   tiles   passes   loads   run edges   weight\n");
+        
+        for (double megabytes : { 1.0, 4.0, 16.0, 64.0, 256.0 }) {
+            
+            std::istringstream input(bytes);
+            ExternalMSTStats stats;
+            
+            start = std::chrono::steady_clock::now();
+            
+            double weight = external_mst_weight(input, static_cast<uint64_t>(megabytes * 1024 * 1024),
+                                                (spill_dir != nullptr) ? spill_dir : "/tmp", &stats);
+            
+            double seconds = seconds_since(start);
+            
+            bool same = std::fabs(weight - in_memory.total_weight) <= 1e-9 * in_memory.total_weight;
+            
+            std::printf("  %6.0f MB  %7.2f   %5zu   %6zu   %5zu   %9llu   %.2f%s\n", megabytes, seconds, stats.num_tiles,
+                        stats.split_passes, stats.tile_loads, static_cast<unsigned long long>(stats.run_edges), weight,
+                        same ? "" : "  MISMATCH");
+            
+            ok = ok && same;
+            
+        }
+        
+    }
+    
+    return ok ? 0 : 1;
+    
+}
@@ -0,0 +1,176 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_ingest.cpp
+//  project4
+//
+//  End-to-end latency (read + solve) of parse-then-solve (read_input())
+//  against the pipelined reader (read_input_pipelined(), whose Hilbert keys
+//  the Drone reuses). The input text is generated in memory, so this
+//  measures parsing rather than the disk or pipe. Then the same locations
+//  as a binary file (binary_input.hpp): read from a stream, and mapped in
+//  place (the time to map plus one pass over the coordinates).
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_ingest.cpp binary_input.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp mst_engines.cpp neighbor_graph.cpp online_tour.cpp pipelined_input.cpp spatial.cpp -o bench_ingest
+//      ./bench_ingest [num_locations]
+//
+
+#include "drone.hpp"
+#include "binary_input.hpp"
+#include "pipelined_input.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+}
+
+}
+
+int main(int argc, char** argv) {
+    
+    size_t num_locations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    
+    std::mt19937 rng(46);
+    std::uniform_int_distribution<int> coord(-1000000, 1000000);
+    
+    // Two Border locations, so SFCTSP can cross between the zones
+    std::string text = std::to_string(num_locations) + "\n-5 0\n0 -5\n";
+    
+    for (size_t i = 2; i < num_locations; i++) {
+        
+        text += std::to_string(coord(rng)) + " " + std::to_string(coord(rng)) + "\n";
+        
+    }
+    
+    std::printf("%zu locations, %.1f MB of text\n", num_locations, static_cast<double>(text.size()) / 1e6);
+    std::printf("  mode                      parse    + solve   pipelined    + solve\n");
+    
+    struct Run {
+        
+        const char *name;
+        
+        std::function<double(Drone &, const std::vector<Coordinate> &)> solve;
+        
+    };
+    
+    Run runs[] = {
+        { "MST boruvka, reorder", [](Drone &drone, const std::vector<Coordinate> &coords) {
+            drone.set_mst_engine(MSTEngine::Boruvka);
+            drone.set_reorder(true);
+            return drone.solve_mst(coords.data(), coords.size()).total_weight;
+        } },
+        { "FASTTSP greedy", [](Drone &drone, const std::vector<Coordinate> &coords) {
+            drone.set_tour_engine(TourEngine::Greedy);
+            return drone.solve_fast_tsp(coords.data(), coords.size()).total_distance;
+        } },
+        { "SFCTSP", [](Drone &drone, const std::vector<Coordinate> &coords) {
+            return drone.solve_sfc_tsp(coords.data(), coords.size()).total_distance;
+        } },
+    };
+    
+    for (const Run &run : runs) {
+        
+        double parse[2], total[2], result[2];
+        
+        for (int pipelined = 0; pipelined < 2; pipelined++) {
+            
+            std::istringstream is(text);
+            
+            std::vector<Coordinate> coords;
+            std::vector<uint64_t> keys;
+            
+            Drone drone;
+            
+            auto start = std::chrono::steady_clock::now();
+            
+            if (pipelined) {
+                
+                read_input_pipelined(is, coords, keys);
+                
+                drone.set_hilbert_keys(keys.data(), keys.size());
+                
+            }
+            
+            else {
+                
+                read_input(is, coords);
+                
+            }
+            
+            parse[pipelined] = seconds_since(start);
+            
+            result[pipelined] = run.solve(drone, coords);
+            
+            total[pipelined] = seconds_since(start);
+            
+        }
+        
+        std::printf("  %-22s  %7.3f  %9.3f  %10.3f  %9.3f%s\n", run.name, parse[0], total[0], parse[1], total[1],
+                    (result[0] == result[1]) ? "" : "  (results differ)");
+        
+    }
+    
+    std::vector<Coordinate> coords;
+    
+    {
+        std::istringstream is(text);
+        
+        read_input(is, coords);
+    }
+    
+    std::ostringstream binary;
+    
+    write_binary_input(binary, coords.data(), coords.size(), false);
+    
+    std::string bytes = binary.str();
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    std::istringstream is(bytes);
+    
+    read_input(is, coords);
+    
+    std::printf("  binary, read_input      %7.3f\n", seconds_since(start));
+    
+    std::FILE *file = std::tmpfile();
+    
+    std::fwrite(bytes.data(), 1, bytes.size(), file);
+    std::fflush(file);
+    
+    start = std::chrono::steady_clock::now();
+    
+    MappedInput mapped;
+    
+    int64_t sum = 0;
+    
+    if (mapped.map(fileno(file))) {
+        
+        for (size_t i = 0; i < mapped.size(); i++) {
+            
+            sum += mapped.get_coords()[i].x;
+            
+        }
+        
+    }
+    
+    std::printf("  binary, mapped          %7.3f  (checksum %lld)\n", seconds_since(start), static_cast<long long>(sum));
+    
+    std::fclose(file);
+    
+    return 0;
+    
+}
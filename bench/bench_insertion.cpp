@@ -0,0 +1,101 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_insertion.cpp
+//  project4
+//
+//  FASTTSP construction engines (--tour-engine): time and tour length of
+//  farthest and cheapest insertion and greedy edge against arbitrary
+//  insertion, on uniform and clustered locations.
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_insertion.cpp binary_input.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp mst_engines.cpp neighbor_graph.cpp online_tour.cpp spatial.cpp -o bench_insertion
+//      ./bench_insertion [num_locations]
+//
+//  Above 50000 locations arbitrary insertion (quadratic) is skipped.
+//
+
+#include "drone.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+int main(int argc, char** argv) {
+    
+    size_t num_locations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    
+    std::mt19937 rng(43);
+    std::uniform_int_distribution<int> coord(-1000000, 1000000);
+    std::normal_distribution<double> spread(0, 20000);
+    
+    const char *names[] = { "arbitrary", "farthest", "cheapest", "greedy" };
+    
+    for (int clustered = 0; clustered < 2; clustered++) {
+        
+        std::vector<Coordinate> coords(num_locations);
+        std::vector<Coordinate> centers(64);
+        
+        for (Coordinate &c : centers) {
+            
+            c = { coord(rng), coord(rng) };
+            
+        }
+        
+        for (size_t i = 0; i < num_locations; i++) {
+            
+            const Coordinate &center = centers[i % centers.size()];
+            
+            coords[i] = clustered ? Coordinate{ center.x + static_cast<int>(spread(rng)), center.y + static_cast<int>(spread(rng)) }
+            : Coordinate{ coord(rng), coord(rng) };
+            
+        }
+        
+        std::printf("%s, %zu locations\n", clustered ? "clustered" : "uniform", num_locations);
+        std::printf("  engine         seconds        length  vs arbitrary\n");
+        
+        double arbitrary = 0;
+        
+        for (TourEngine engine : { TourEngine::Arbitrary, TourEngine::Farthest, TourEngine::Cheapest, TourEngine::Greedy }) {
+            
+            if (engine == TourEngine::Arbitrary && num_locations > 50000) {
+                
+                continue;
+                
+            }
+            
+            Drone drone;
+            
+            drone.set_tour_engine(engine);
+            
+            auto start = std::chrono::steady_clock::now();
+            
+            double length = drone.solve_fast_tsp(coords.data(), coords.size()).total_distance;
+            
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            
+            if (engine == TourEngine::Arbitrary) {
+                
+                arbitrary = length;
+                
+            }
+            
+            std::printf("  %-10s  %10.3f  %12.0f", names[static_cast<int>(engine)], seconds, length);
+            
+            if (arbitrary > 0) {
+                
+                std::printf("  %+11.2f%%", 100 * (length / arbitrary - 1));
+                
+            }
+            
+            std::printf("\n");
+            
+        }
+        
+    }
+    
+    return 0;
+    
+}
@@ -0,0 +1,62 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_knn.cpp
+//  project4
+//
+//  Build time and memory of the k-NN candidate graph (NeighborGraph) for
+//  uniform random locations in all four quadrants (zones on).
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_knn.cpp binary_input.cpp neighbor_graph.cpp mst_engines.cpp spatial.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp online_tour.cpp -o bench_knn
+//      ./bench_knn [num_locations] [k] [threads]
+//
+
+#include "neighbor_graph.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+int main(int argc, char** argv) {
+    
+    size_t num_locations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t k = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 10;
+    size_t num_threads = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 0;
+    
+    std::mt19937 rng(53);
+    std::uniform_int_distribution<int> coord(-1000000, 1000000);
+    
+    std::vector<Coordinate> coords(num_locations);
+    
+    for (Coordinate &c : coords) {
+        
+        c.x = coord(rng);
+        c.y = coord(rng);
+        
+    }
+    
+    // Some Border locations on both axes
+    for (size_t i = 0; i < num_locations; i += 500) {
+        
+        coords[i] = (i % 1000 == 0) ? Coordinate{ -coord(rng) / 2 - 1, 0 } : Coordinate{ 0, -coord(rng) / 2 - 1 };
+        
+    }
+    
+    NeighborGraph graph;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    graph.build(coords.data(), coords.size(), k, true, num_threads);
+    
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::printf("%zu locations, k = %zu: %.3f s, %zu edges, %.1f MB (%.1f bytes per location)\n",
+                num_locations, k, seconds, graph.num_edges(), static_cast<double>(graph.memory_bytes()) / 1e6,
+                static_cast<double>(graph.memory_bytes()) / static_cast<double>(num_locations));
+    
+    return 0;
+    
+}
@@ -0,0 +1,90 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_lk.cpp
+//  project4
+//
+//  FASTTSP improvement (--improve): time and tour length of the greedy edge
+//  tour alone, then improved locally and with kicks, on uniform and
+//  clustered locations. The time limit (default 10 s) bounds both; kicks
+//  run until it is reached.
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_lk.cpp binary_input.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp mst_engines.cpp neighbor_graph.cpp online_tour.cpp spatial.cpp -o bench_lk
+//      ./bench_lk [num_locations] [time_limit]
+//
+
+#include "drone.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+int main(int argc, char** argv) {
+    
+    size_t num_locations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    double time_limit = (argc > 2) ? std::strtod(argv[2], nullptr) : 10.0;
+    
+    std::mt19937 rng(45);
+    std::uniform_int_distribution<int> coord(-1000000, 1000000);
+    std::normal_distribution<double> spread(0, 20000);
+    
+    const char *names[] = { "none", "local", "kicks" };
+    
+    for (int clustered = 0; clustered < 2; clustered++) {
+        
+        std::vector<Coordinate> coords(num_locations);
+        std::vector<Coordinate> centers(64);
+        
+        for (Coordinate &c : centers) {
+            
+            c = { coord(rng), coord(rng) };
+            
+        }
+        
+        for (size_t i = 0; i < num_locations; i++) {
+            
+            const Coordinate &center = centers[i % centers.size()];
+            
+            coords[i] = clustered ? Coordinate{ center.x + static_cast<int>(spread(rng)), center.y + static_cast<int>(spread(rng)) }
+            : Coordinate{ coord(rng), coord(rng) };
+            
+        }
+        
+        std::printf("%s, %zu locations\n", clustered ? "clustered" : "uniform", num_locations);
+        std::printf("  improve        seconds        length   vs greedy\n");
+        
+        double greedy = 0;
+        
+        for (Improvement improvement : { Improvement::None, Improvement::Local, Improvement::Kicks }) {
+            
+            Drone drone;
+            
+            drone.set_tour_engine(TourEngine::Greedy);
+            drone.set_improvement(improvement);
+            drone.set_time_limit(time_limit);
+            
+            auto start = std::chrono::steady_clock::now();
+            
+            double length = drone.solve_fast_tsp(coords.data(), coords.size()).total_distance;
+            
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            
+            if (improvement == Improvement::None) {
+                
+                greedy = length;
+                
+            }
+            
+            std::printf("  %-10s  %10.3f  %12.0f  %+9.2f%%\n", names[static_cast<int>(improvement)], seconds, length,
+                        100 * (length / greedy - 1));
+            
+        }
+        
+    }
+    
+    return 0;
+    
+}
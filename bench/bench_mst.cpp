@@ -0,0 +1,111 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_mst.cpp
+//  project4
+//
+//  MST engines on random locations in all four quadrants: Borůvka at
+//  1, 2, 4, ... threads (up to max_threads) for the scaling curve, the
+//  approximate engine at a few epsilons (with its certified gap), and the
+//  Prim engines where they finish (up to 50k locations).
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_mst.cpp binary_input.cpp mst_engines.cpp spatial.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp neighbor_graph.cpp online_tour.cpp -o bench_mst
+//      ./bench_mst [num_locations] [max_threads]
+//
+
+#include "drone.hpp"
+#include "mst_engines.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+template <typename Solve>
+double seconds_for(Solve solve) {
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    solve();
+    
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+}
+
+}
+
+int main(int argc, char** argv) {
+    
+    size_t num_locations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    size_t max_threads = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    
+    std::mt19937 rng(71);
+    std::uniform_int_distribution<int> coord(-1000000, 1000000);
+    
+    std::vector<Coordinate> coords(num_locations);
+    
+    for (Coordinate &c : coords) {
+        
+        c.x = coord(rng);
+        c.y = coord(rng);
+        
+    }
+    
+    for (size_t i = 0; i < num_locations; i += 500) {
+        
+        coords[i] = (i % 1000 == 0) ? Coordinate{ -coord(rng) / 2 - 1, 0 } : Coordinate{ 0, -coord(rng) / 2 - 1 };
+        
+    }
+    
+    MSTResult result;
+    
+    double one_thread = 0;
+    
+    for (size_t threads = 1; threads <= std::max<size_t>(max_threads, 1); threads *= 2) {
+        
+        double seconds = seconds_for([&]() { boruvka_mst(coords.data(), coords.size(), result, threads); });
+        
+        if (threads == 1) {
+            
+            one_thread = seconds;
+            
+        }
+        
+        std::printf("boruvka  %3zu threads %9.3f s  speedup %5.2f  total %.2f\n", threads, seconds,
+                    one_thread / seconds, result.total_weight);
+        
+    }
+    
+    for (double epsilon : { 0.001, 0.01, 0.1 }) {
+        
+        double lower_bound = 0;
+        
+        double seconds = seconds_for([&]() { approximate_mst(coords.data(), coords.size(), epsilon, result, lower_bound, max_threads); });
+        
+        std::printf("approx   eps %5.3f   %9.3f s  gap %6.3f%%   total %.2f\n", epsilon, seconds,
+                    100 * (result.total_weight / lower_bound - 1), result.total_weight);
+        
+    }
+    
+    if (num_locations <= 50000) {
+        
+        double seconds = seconds_for([&]() { zone_prim_mst(coords.data(), coords.size(), result); });
+        
+        std::printf("zones                %9.3f s                 total %.2f\n", seconds, result.total_weight);
+        
+        Drone drone;
+        
+        seconds = seconds_for([&]() { result = drone.solve_mst(coords.data(), coords.size()); });
+        
+        std::printf("prim                 %9.3f s                 total %.2f\n", seconds, result.total_weight);
+        
+    }
+    
+    return 0;
+    
+}
@@ -0,0 +1,182 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_online.cpp
+//  project4
+//
+//  Per-update latency of the online tour service on a large tour, and of
+//  the tour and the online MST (seeded from Borůvka) when far outliers
+//  arrive. Exits with 1 if an outlier update takes longer than
+//  far_limit_us: the grid searches once walked every empty ring of cells
+//  between an outlier and the other locations, taking seconds to minutes
+//  per update.
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_online.cpp binary_input.cpp online_mst.cpp online_tour.cpp mst_engines.cpp spatial.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp neighbor_graph.cpp -o bench_online
+//      ./bench_online [num_locations] [num_updates]
+//
+
+#include "online_mst.hpp"
+#include "online_tour.hpp"
+#include "mst_engines.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+// Within +-2^30, where squared distances are exact; none is Medical, so the
+// tree stays connected
+const Coordinate far_locations[] = {
+    { 10000000, 5 }, { 1000000000, 5 }, { -1000000000, 1000000000 }, { 5, -1000000000 }, { 1000000000, 1000000000 }
+};
+
+const double far_limit_us = 100000;
+
+double micros_since(std::chrono::steady_clock::time_point start) {
+    
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    
+}
+
+}
+
+int main(int argc, char** argv) {
+    
+    size_t num_locations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t num_updates = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 20000;
+    
+    std::mt19937 rng(281);
+    std::uniform_int_distribution<int> coord(0, 1000000);
+    
+    std::vector<Coordinate> coords(num_locations);
+    
+    for (Coordinate &c : coords) {
+        
+        c.x = coord(rng);
+        c.y = coord(rng);
+        
+    }
+    
+    bool ok = true;
+    
+    for (int repair = 0; repair < 2; repair++) {
+        
+        OnlineTour tour;
+        
+        auto build_start = std::chrono::steady_clock::now();
+        
+        tour.build(coords.data(), coords.size());
+        
+        double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+        
+        tour.set_repair(repair == 1);
+        
+        std::vector<size_t> live(num_locations);
+        
+        for (size_t i = 0; i < num_locations; i++) {
+            
+            live[i] = i;
+            
+        }
+        
+        double worst_us = 0;
+        
+        auto start = std::chrono::steady_clock::now();
+        
+        // Alternate inserting a new location and removing a random live one
+        for (size_t u = 0; u < num_updates; u++) {
+            
+            auto update_start = std::chrono::steady_clock::now();
+            
+            if (u % 2 == 0) {
+                
+                live.push_back(tour.add_location({ coord(rng), coord(rng) }));
+                
+            }
+            
+            else {
+                
+                size_t pick = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+                
+                tour.remove_location(live[pick]);
+                
+                live[pick] = live.back();
+                live.pop_back();
+                
+            }
+            
+            worst_us = std::max(worst_us, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - update_start).count());
+            
+        }
+        
+        double mean_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(num_updates);
+        
+        std::printf("repair %-3s  stops %zu  build %.1f ms  update mean %.2f us  worst %.2f us  length %.2f\n",
+                    repair ? "on" : "off", tour.size(), build_ms, mean_us, worst_us, tour.get_total_distance());
+        
+        double far_worst_us = 0;
+        
+        for (const Coordinate &c : far_locations) {
+            
+            auto update_start = std::chrono::steady_clock::now();
+            
+            tour.add_location(c);
+            
+            far_worst_us = std::max(far_worst_us, micros_since(update_start));
+            
+        }
+        
+        std::printf("repair %-3s  far outliers: worst add %.2f us  length %.2f\n", repair ? "on" : "off", far_worst_us,
+                    tour.get_total_distance());
+        
+        ok = ok && far_worst_us < far_limit_us;
+        
+    }
+    
+    OnlineMST mst;
+    MSTResult seed_tree;
+    
+    boruvka_mst(coords.data(), coords.size(), seed_tree);
+    
+    mst.seed(coords.data(), coords.size(), seed_tree);
+    
+    double far_worst_us = 0;
+    
+    for (const Coordinate &c : far_locations) {
+        
+        auto update_start = std::chrono::steady_clock::now();
+        
+        mst.add_location(c);
+        
+        far_worst_us = std::max(far_worst_us, micros_since(update_start));
+        
+    }
+    
+    // Ordinary adds with the outliers in the tree
+    double after_worst_us = 0;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    for (size_t u = 0; u < 100; u++) {
+        
+        auto update_start = std::chrono::steady_clock::now();
+        
+        mst.add_location({ coord(rng), coord(rng) });
+        
+        after_worst_us = std::max(after_worst_us, micros_since(update_start));
+        
+    }
+    
+    std::printf("MST far outliers: worst add %.2f us; then adds mean %.2f us  worst %.2f us  weight %.2f\n", far_worst_us,
+                micros_since(start) / 100, after_worst_us, mst.get_total_weight());
+    
+    ok = ok && far_worst_us < far_limit_us;
+    
+    return ok ? 0 : 1;
+    
+}
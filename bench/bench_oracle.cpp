@@ -0,0 +1,676 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_oracle.cpp
+//  project4
+//
+//  Differential check of every engine against a brute-force oracle on
+//  small seeded instances, with the time each takes:
+//
+//      MST      Kruskal over all pairs (MST distance rules) against Prim
+//               (double and float), the zone, Borůvka and approximate
+//               engines. Exact engines must match the weight and return a
+//               spanning tree of that weight with no Medical - Normal edge;
+//               the approximate one must bracket it with its bound. An
+//               instance the oracle can't span must throw everywhere.
+//      OPTTSP   every (n - 1)! tour from location 0 against branch and bound
+//               (genPerms() / is_promising()) in double, float, reordered
+//               and with an improved first incumbent.
+//      FASTTSP  every construction engine, alone and improved: tours must
+//               be valid and no shorter than the optimum; the mean and
+//               worst excess over it are reported.
+//
+//  Instances mix uniform locations with the edge cases: tiny grids full
+//  of ties and duplicates, Medical and Normal locations with no Border
+//  location (MST can't span them), exactly one Border location at the
+//  origin, locations on the Border axes only, locations spread over the
+//  whole int range (squares past int64) and a fixed three-location
+//  instance whose squared distances overflowed int64 before. The oracles
+//  measure distances in double, independently of the solvers' squared
+//  distance keys.
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_oracle.cpp binary_input.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp mst_engines.cpp neighbor_graph.cpp online_tour.cpp spatial.cpp -o bench_oracle
+//      ./bench_oracle [seed] [instances]
+//
+//  Runs are deterministic for a seed (default 48). With the default 1000
+//  instances per mode it takes a few seconds; exits with 1 on any
+//  disagreement.
+//
+
+#include "drone.hpp"
+#include "spatial.hpp"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+const double tolerance = 1e-6;
+
+// Largest OPTTSP instance (the oracle tries (n - 1)! tours)
+const size_t max_opt_locations = 10;
+
+const size_t max_mst_locations = 60;
+
+const size_t num_kinds = 7;
+
+// MST 2492593760.96 and tours of 5321020889.95 while int64 squares
+// overflowed; 7300563081.75 and 11772699036.30
+const Coordinate overflow_instance[] = { { 2000000000, 2000000000 }, { -2000000000, 5 }, { 1, -2000000000 } };
+
+struct Instance {
+    
+    std::string kind;
+    
+    std::vector<Coordinate> coords;
+    
+};
+
+Instance make_instance(size_t kind, size_t count, std::mt19937 &rng) {
+    
+    auto uniform = [&](int low, int high) { return std::uniform_int_distribution<int>(low, high)(rng); };
+    
+    Instance instance;
+    
+    if (kind == 6) {
+        
+        instance.kind = "overflow";
+        instance.coords.assign(std::begin(overflow_instance), std::end(overflow_instance));
+        
+        return instance;
+        
+    }
+    
+    instance.coords.resize(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        Coordinate &c = instance.coords[i];
+        
+        switch (kind) {
+            
+            case 0:
+            
+                instance.kind = "uniform";
+                c = { uniform(-1000000, 1000000), uniform(-1000000, 1000000) };
+            
+                break;
+            
+            case 1:
+            
+                instance.kind = "ties";
+                c = { uniform(-3, 3), uniform(-3, 3) };
+            
+                break;
+            
+            // Medical and Normal only (off the axes)
+            case 2:
+            
+                instance.kind = "no-border";
+                c = { uniform(1, 1000) * (uniform(0, 1) ? 1 : -1), 0 };
+                c.y = (c.x < 0) ? -uniform(1, 1000) : uniform(1, 1000);
+            
+                break;
+            
+            case 3:
+            
+                instance.kind = "one-border";
+                c = (i == count / 2) ? Coordinate{ 0, 0 } : Coordinate{ uniform(1, 1000), uniform(1, 1000) };
+            
+                if (i % 2 == 1 && i != count / 2) {
+                
+                    c = { -c.x, -c.y };
+                
+                }
+            
+                break;
+            
+            case 4:
+            
+                instance.kind = "axes";
+                c = uniform(0, 1) ? Coordinate{ -uniform(0, 50), 0 } : Coordinate{ 0, -uniform(0, 50) };
+            
+                break;
+            
+            // Normal and Border locations across the whole int range
+            default:
+            
+                instance.kind = "wide";
+                c = { uniform(INT_MIN, INT_MAX), uniform(INT_MIN, INT_MAX) };
+            
+                if (c.x < 0 && c.y < 0) {
+                
+                    c.x = -(c.x + 1);
+                
+                }
+            
+                break;
+            
+        }
+        
+    }
+    
+    return instance;
+    
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+}
+
+double distance(const Coordinate &a, const Coordinate &b) {
+    
+    double dx = static_cast<double>(b.x) - a.x;
+    double dy = static_cast<double>(b.y) - a.y;
+    
+    return std::sqrt(dx * dx + dy * dy);
+    
+}
+
+bool close(double a, double b) {
+    
+    return std::abs(a - b) <= tolerance * std::max(1.0, std::abs(b));
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    Oracles
+// ----------------------------------------------------------------------------
+
+// Kruskal over every reachable pair; returns false if they don't span
+bool oracle_mst(const std::vector<Coordinate> &coords, double &weight) {
+    
+    size_t n = coords.size();
+    
+    std::vector<std::pair<double, std::pair<size_t, size_t>>> edges;
+    
+    for (size_t a = 0; a < n; a++) {
+        
+        for (size_t b = a + 1; b < n; b++) {
+            
+            if (zones_compatible(zone_of(coords[a]), zone_of(coords[b]))) {
+                
+                edges.push_back({ distance(coords[a], coords[b]), { a, b } });
+                
+            }
+            
+        }
+        
+    }
+    
+    std::sort(edges.begin(), edges.end());
+    
+    std::vector<size_t> root(n);
+    
+    std::iota(root.begin(), root.end(), 0);
+    
+    std::function<size_t(size_t)> find = [&](size_t x) { return (root[x] == x) ? x : (root[x] = find(root[x])); };
+    
+    size_t joined = 0;
+    
+    weight = 0;
+    
+    for (const auto &edge : edges) {
+        
+        size_t a = find(edge.second.first), b = find(edge.second.second);
+        
+        if (a != b) {
+            
+            root[a] = b;
+            
+            weight += edge.first;
+            
+            joined++;
+            
+        }
+        
+    }
+    
+    return joined + 1 >= n;
+    
+}
+
+// Shortest of every tour from location 0 (both directions of each, which
+// is cheaper than skipping one at this size)
+double oracle_tsp(const std::vector<Coordinate> &coords) {
+    
+    std::vector<size_t> order(coords.size());
+    
+    std::iota(order.begin(), order.end(), 0);
+    
+    double best = std::numeric_limits<double>::infinity();
+    
+    do {
+        
+        double length = distance(coords[order.back()], coords[0]);
+        
+        for (size_t i = 1; i < order.size() && length < best; i++) {
+            
+            length += distance(coords[order[i - 1]], coords[order[i]]);
+            
+        }
+        
+        best = std::min(best, length);
+        
+    } while (std::next_permutation(order.begin() + 1, order.end()));
+    
+    return best;
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    Result Checks
+// ----------------------------------------------------------------------------
+
+// parents must be a tree rooted at 0 of reachable edges summing to the total
+bool valid_tree(const std::vector<Coordinate> &coords, const MSTResult &result) {
+    
+    size_t n = coords.size();
+    
+    if (result.parents.size() != n || (n > 0 && result.parents[0] != 0)) {
+        
+        return false;
+        
+    }
+    
+    double weight = 0;
+    
+    for (size_t v = 1; v < n; v++) {
+        
+        size_t parent = result.parents[v];
+        
+        if (parent >= n || !zones_compatible(zone_of(coords[v]), zone_of(coords[parent]))) {
+            
+            return false;
+            
+        }
+        
+        weight += distance(coords[v], coords[parent]);
+        
+        // Following parents must reach 0 within n steps
+        size_t steps = 0;
+        
+        for (size_t u = v; u != 0 && steps <= n; u = result.parents[u], steps++) {}
+        
+        if (steps > n) {
+            
+            return false;
+            
+        }
+        
+    }
+    
+    return close(weight, result.total_weight);
+    
+}
+
+// path must visit every location once, from 0, with the reported length
+bool valid_tour(const std::vector<Coordinate> &coords, const TourResult &result) {
+    
+    size_t n = coords.size();
+    
+    if (result.path.size() != n || result.path[0] != 0) {
+        
+        return false;
+        
+    }
+    
+    std::vector<bool> seen(n, false);
+    
+    double length = 0;
+    
+    for (size_t i = 0; i < n; i++) {
+        
+        size_t v = result.path[i];
+        
+        if (v >= n || seen[v]) {
+            
+            return false;
+            
+        }
+        
+        seen[v] = true;
+        
+        length += distance(coords[v], coords[result.path[(i + 1) % n]]);
+        
+    }
+    
+    return close(length, result.total_distance);
+    
+}
+
+struct EngineStats {
+    
+    std::string name;
+    
+    size_t runs = 0;
+    
+    size_t failures = 0;
+    
+    double seconds = 0;
+    
+    double total_excess = 0;
+    
+    double max_excess = 0;
+    
+};
+
+void print_stats(const std::vector<EngineStats> &engines, double oracle_seconds, bool excess) {
+    
+    std::printf("  %-22s %6s %9s %10s %9s%s\n", "engine", "runs", "failures", "seconds", "speedup",
+                excess ? "  mean excess  max excess" : "");
+    
+    std::printf("  %-22s %6s %9s %10.4f\n", "oracle", "", "", oracle_seconds);
+    
+    for (const EngineStats &e : engines) {
+        
+        std::printf("  %-22s %6zu %9zu %10.4f %8.1fx", e.name.c_str(), e.runs, e.failures, e.seconds,
+                    oracle_seconds / std::max(e.seconds, 1e-9));
+        
+        if (excess) {
+            
+            std::printf("  %10.2f%% %10.2f%%", 100 * e.total_excess / static_cast<double>(std::max<size_t>(e.runs, 1)),
+                        100 * e.max_excess);
+            
+        }
+        
+        std::printf("\n");
+        
+    }
+    
+}
+
+}
+
+int main(int argc, char** argv) {
+    
+    unsigned seed = (argc > 1) ? static_cast<unsigned>(std::strtoul(argv[1], nullptr, 10)) : 48;
+    size_t num_instances = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    
+    std::mt19937 rng(seed);
+    
+    size_t failures = 0;
+    
+    auto report = [&](const char *mode, const EngineStats &e, const Instance &instance, const std::string &what) {
+        
+        failures++;
+        
+        if (failures <= 20) {
+            
+            std::printf("  FAIL %s %s on %s (%zu locations): %s\n", mode, e.name.c_str(), instance.kind.c_str(),
+                        instance.coords.size(), what.c_str());
+            
+        }
+        
+    };
+    
+    std::printf("seed %u, %zu instances per mode\n", seed, num_instances);
+    
+    // ----------------------------------------------------------------------------
+    //                    MST
+    // ----------------------------------------------------------------------------
+    
+    {
+        struct MSTEngineRun {
+            
+            MSTEngine engine;
+            
+            Precision precision;
+            
+        };
+        
+        std::vector<MSTEngineRun> runs = { { MSTEngine::Prim, Precision::Double }, { MSTEngine::Prim, Precision::Float },
+            { MSTEngine::Zones, Precision::Double }, { MSTEngine::Boruvka, Precision::Double },
+            { MSTEngine::Approximate, Precision::Double } };
+        
+        std::vector<EngineStats> engines(runs.size());
+        
+        const char *names[] = { "prim", "prim, float", "zones", "boruvka", "approx" };
+        
+        for (size_t r = 0; r < runs.size(); r++) {
+            
+            engines[r].name = names[r];
+            
+        }
+        
+        double oracle_seconds = 0;
+        size_t unspannable = 0;
+        
+        for (size_t k = 0; k < num_instances; k++) {
+            
+            Instance instance = make_instance(k % num_kinds, 1 + rng() % max_mst_locations, rng);
+            
+            auto start = std::chrono::steady_clock::now();
+            
+            double exact = 0;
+            
+            bool spans = oracle_mst(instance.coords, exact);
+            
+            oracle_seconds += seconds_since(start);
+            
+            unspannable += !spans;
+            
+            for (size_t r = 0; r < runs.size(); r++) {
+                
+                EngineStats &e = engines[r];
+                
+                Drone drone;
+                
+                drone.set_mst_engine(runs[r].engine);
+                drone.set_precision(runs[r].precision);
+                
+                e.runs++;
+                
+                start = std::chrono::steady_clock::now();
+                
+                try {
+                    
+                    MSTResult result = drone.solve_mst(instance.coords.data(), instance.coords.size());
+                    
+                    e.seconds += seconds_since(start);
+                    
+                    if (!spans) {
+                        
+                        e.failures++;
+                        report("MST", e, instance, "spanned an instance the oracle can't");
+                        
+                    }
+                    
+                    else if (!valid_tree(instance.coords, result)) {
+                        
+                        e.failures++;
+                        report("MST", e, instance, "invalid tree");
+                        
+                    }
+                    
+                    else if (runs[r].engine == MSTEngine::Approximate) {
+                        
+                        double bound = drone.get_mst_lower_bound();
+                        
+                        if (result.total_weight < exact - tolerance * std::max(1.0, exact) || bound > exact + tolerance * std::max(1.0, exact)) {
+                            
+                            e.failures++;
+                            report("MST", e, instance, "bound " + std::to_string(bound) + " <= exact " + std::to_string(exact) +
+                                   " <= weight " + std::to_string(result.total_weight) + " does not hold");
+                            
+                        }
+                        
+                    }
+                    
+                    else if (!close(result.total_weight, exact)) {
+                        
+                        e.failures++;
+                        report("MST", e, instance, "weight " + std::to_string(result.total_weight) + ", exact " + std::to_string(exact));
+                        
+                    }
+                    
+                }
+                
+                catch (const DroneError &error) {
+                    
+                    e.seconds += seconds_since(start);
+                    
+                    if (spans) {
+                        
+                        e.failures++;
+                        report("MST", e, instance, error.what());
+                        
+                    }
+                    
+                }
+                
+            }
+            
+        }
+        
+        std::printf("MST, 1 - %zu locations (%zu can't be spanned); oracle: Kruskal over all pairs\n", max_mst_locations,
+                    unspannable);
+        
+        print_stats(engines, oracle_seconds, false);
+        
+    }
+    
+    // ----------------------------------------------------------------------------
+    //                    OPTTSP and FASTTSP
+    // ----------------------------------------------------------------------------
+    
+    {
+        std::vector<EngineStats> opt_engines(4);
+        
+        const char *opt_names[] = { "branch and bound", "b&b, float", "b&b, reorder", "b&b, improved start" };
+        
+        for (size_t r = 0; r < opt_engines.size(); r++) {
+            
+            opt_engines[r].name = opt_names[r];
+            
+        }
+        
+        std::vector<EngineStats> fast_engines;
+        
+        const char *engine_names[] = { "arbitrary", "farthest", "cheapest", "greedy" };
+        
+        for (int improved = 0; improved < 2; improved++) {
+            
+            for (const char *name : engine_names) {
+                
+                EngineStats e;
+                
+                e.name = std::string(name) + (improved ? " + local" : "");
+                
+                fast_engines.push_back(e);
+                
+            }
+            
+        }
+        
+        double oracle_seconds = 0;
+        
+        for (size_t k = 0; k < num_instances; k++) {
+            
+            // TSP modes have no zones, so only the spread of the points matters
+            Instance instance = make_instance(k % num_kinds, 3 + rng() % (max_opt_locations - 2), rng);
+            
+            auto start = std::chrono::steady_clock::now();
+            
+            double optimum = oracle_tsp(instance.coords);
+            
+            oracle_seconds += seconds_since(start);
+            
+            for (size_t r = 0; r < opt_engines.size(); r++) {
+                
+                EngineStats &e = opt_engines[r];
+                
+                Drone drone;
+                
+                drone.set_precision(r == 1 ? Precision::Float : Precision::Double);
+                drone.set_reorder(r == 2);
+                drone.set_improvement(r == 3 ? Improvement::Local : Improvement::None);
+                
+                e.runs++;
+                
+                start = std::chrono::steady_clock::now();
+                
+                TourResult result = drone.solve_opt_tsp(instance.coords.data(), instance.coords.size());
+                
+                e.seconds += seconds_since(start);
+                
+                if (!valid_tour(instance.coords, result)) {
+                    
+                    e.failures++;
+                    report("OPTTSP", e, instance, "invalid tour");
+                    
+                }
+                
+                else if (!close(result.total_distance, optimum)) {
+                    
+                    e.failures++;
+                    report("OPTTSP", e, instance, "length " + std::to_string(result.total_distance) + ", optimum " + std::to_string(optimum));
+                    
+                }
+                
+            }
+            
+            for (size_t r = 0; r < fast_engines.size(); r++) {
+                
+                EngineStats &e = fast_engines[r];
+                
+                Drone drone;
+                
+                drone.set_tour_engine(static_cast<TourEngine>(r % 4));
+                drone.set_improvement(r >= 4 ? Improvement::Local : Improvement::None);
+                
+                e.runs++;
+                
+                start = std::chrono::steady_clock::now();
+                
+                TourResult result = drone.solve_fast_tsp(instance.coords.data(), instance.coords.size());
+                
+                e.seconds += seconds_since(start);
+                
+                if (!valid_tour(instance.coords, result) || result.total_distance < optimum - tolerance * std::max(1.0, optimum)) {
+                    
+                    e.failures++;
+                    report("FASTTSP", e, instance, "invalid tour or shorter than the optimum");
+                    
+                    continue;
+                    
+                }
+                
+                double excess = (optimum > 0) ? result.total_distance / optimum - 1 : 0;
+                
+                e.total_excess += excess;
+                e.max_excess = std::max(e.max_excess, excess);
+                
+            }
+            
+        }
+        
+        std::printf("OPTTSP, 3 - %zu locations; oracle: all (n - 1)! tours\n", max_opt_locations);
+        
+        print_stats(opt_engines, oracle_seconds, false);
+        
+        std::printf("FASTTSP, same instances (speedup against the oracle)\n");
+        
+        print_stats(fast_engines, oracle_seconds, true);
+        
+    }
+    
+    std::printf("%s\n", failures == 0 ? "all engines agree with the oracles" : "DISAGREEMENTS FOUND");
+    
+    return (failures == 0) ? 0 : 1;
+    
+}
@@ -0,0 +1,217 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_precision.cpp
+//  project4
+//
+//  Validation harness for --precision float: solves a fixed set of seeded
+//  instances (uniform, clustered, and a lattice full of exact ties; for MST
+//  with Border locations on both negative axes) in double and in float, and reports
+//  for each whether the tree / tour and the printed total are identical,
+//  the difference in the total, and both run times. A different tree or
+//  tour of the same length (to 1e-9) is reported as a tie and counted
+//  separately. Ties are expected from OPTTSP: double mode settles ties
+//  between equally short tours (often the optimal tour and its reverse)
+//  by rounding in its running sum, which float mode doesn't reproduce, so
+//  float mode may print the other one. Exits with 1 if anything diverged
+//  (ties don't count).
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_precision.cpp binary_input.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp neighbor_graph.cpp mst_engines.cpp spatial.cpp online_tour.cpp -o bench_precision
+//      ./bench_precision [scale]
+//
+//  scale (default 1) multiplies the MST and FASTTSP instance sizes.
+//
+
+#include "drone.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+std::vector<Coordinate> make_instance(const std::string &kind, size_t count, bool borders, unsigned seed) {
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coord(-1000000, 1000000);
+
+    std::vector<Coordinate> coords(count);
+
+    if (kind == "uniform") {
+
+        for (Coordinate &c : coords) {
+
+            c = { coord(rng), coord(rng) };
+
+        }
+
+    }
+
+    else if (kind == "clustered") {
+
+        std::normal_distribution<double> spread(0, 2000);
+
+        std::vector<Coordinate> centers(32);
+
+        for (Coordinate &c : centers) {
+
+            c = { coord(rng), coord(rng) };
+
+        }
+
+        for (size_t i = 0; i < count; i++) {
+
+            const Coordinate &center = centers[i % centers.size()];
+
+            coords[i] = { center.x + static_cast<int>(spread(rng)), center.y + static_cast<int>(spread(rng)) };
+
+        }
+
+    }
+
+    // Equal spacing: nearly every comparison is an exact tie
+    else {
+
+        size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+
+        for (size_t i = 0; i < count; i++) {
+
+            coords[i] = { static_cast<int>(i % side) * 1000 - 500000, static_cast<int>(i / side) * 1000 - 500000 };
+
+        }
+
+    }
+
+    // MST needs Border locations to join Medical and Normal ones
+    for (size_t i = 0; borders && i < count; i += 50) {
+
+        coords[i] = (i % 100 == 0) ? Coordinate{ -coord(rng) / 2 - 1, 0 } : Coordinate{ 0, -coord(rng) / 2 - 1 };
+
+    }
+
+    return coords;
+
+}
+
+template <typename Solve>
+double seconds_for(Solve solve) {
+
+    auto start = std::chrono::steady_clock::now();
+
+    solve();
+
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+}
+
+std::string printed(double total) {
+
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.2f", total);
+
+    return buffer;
+
+}
+
+}
+
+int main(int argc, char** argv) {
+
+    size_t scale = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1;
+
+    const char *kinds[] = { "uniform", "clustered", "lattice" };
+
+    Drone double_drone, float_drone;
+
+    float_drone.set_precision(Precision::Float);
+
+    size_t diverged = 0, ties = 0;
+
+    std::printf("%-8s %-10s %8s  %9s %9s  %-9s %-7s %s\n", "mode", "instance", "count", "double s", "float s", "structure", "printed", "|difference|");
+
+    for (char mode : { 'M', 'F', 'O' }) {
+
+        size_t count = (mode == 'M') ? 10000 * scale : (mode == 'F') ? 5000 * scale : 11;
+
+        for (const char *kind : kinds) {
+
+            std::vector<Coordinate> coords = make_instance(kind, count, mode == 'M', 2024);
+
+            double double_total = 0, float_total = 0;
+            double double_seconds = 0, float_seconds = 0;
+
+            bool same_structure = false;
+
+            if (mode == 'M') {
+
+                MSTResult a, b;
+
+                double_seconds = seconds_for([&]() { a = double_drone.solve_mst(coords.data(), coords.size()); });
+                float_seconds = seconds_for([&]() { b = float_drone.solve_mst(coords.data(), coords.size()); });
+
+                double_total = a.total_weight;
+                float_total = b.total_weight;
+
+                same_structure = (a.parents == b.parents);
+
+            }
+
+            else {
+
+                TourResult a, b;
+
+                if (mode == 'F') {
+
+                    double_seconds = seconds_for([&]() { a = double_drone.solve_fast_tsp(coords.data(), coords.size()); });
+                    float_seconds = seconds_for([&]() { b = float_drone.solve_fast_tsp(coords.data(), coords.size()); });
+
+                }
+
+                else {
+
+                    double_seconds = seconds_for([&]() { a = double_drone.solve_opt_tsp(coords.data(), coords.size()); });
+                    float_seconds = seconds_for([&]() { b = float_drone.solve_opt_tsp(coords.data(), coords.size()); });
+
+                }
+
+                double_total = a.total_distance;
+                float_total = b.total_distance;
+
+                same_structure = (a.path == b.path);
+
+            }
+
+            bool same_printed = (printed(double_total) == printed(float_total));
+
+            bool tie = !same_structure && std::fabs(double_total - float_total) <= 1e-9 * double_total;
+
+            if ((!same_structure && !tie) || !same_printed) {
+
+                diverged++;
+
+            }
+
+            else if (tie) {
+
+                ties++;
+
+            }
+
+            std::printf("%-8s %-10s %8zu  %9.3f %9.3f  %-9s %-7s %.3g\n", (mode == 'M') ? "MST" : (mode == 'F') ? "FASTTSP" : "OPTTSP",
+                        kind, count, double_seconds, float_seconds, same_structure ? "same" : tie ? "tie" : "DIFFERS",
+                        same_printed ? "same" : "DIFFERS", std::fabs(double_total - float_total));
+
+        }
+
+    }
+
+    std::printf("%zu instance(s) diverged, %zu tie(s)\n", diverged, ties);
+
+    return (diverged == 0) ? 0 : 1;
+
+}
@@ -0,0 +1,116 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_reorder.cpp
+//  project4
+//
+//  Wall time and LLC misses of MST and FASTTSP with and without Hilbert
+//  reordering (Drone::set_reorder), plus the cost of the reordering itself.
+//
+//  Prim and arbitrary insertion are both quadratic, so the solver runs use
+//  num_locations (default 20000); the reordering alone is timed on
+//  sort_locations (default 1000000).
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_reorder.cpp binary_input.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp neighbor_graph.cpp mst_engines.cpp online_tour.cpp spatial.cpp -o bench_reorder
+//      ./bench_reorder [num_locations] [sort_locations]
+//
+
+#define DRONE_PROFILE
+#include "phase_timer.hpp"
+#include "drone.hpp"
+#include "spatial.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+std::vector<Coordinate> random_locations(size_t count, std::mt19937 &rng) {
+    
+    // Normal zone only, so MST never hits an unreachable pair
+    std::uniform_int_distribution<int> coord(1, 1000000);
+    
+    std::vector<Coordinate> coords(count);
+    
+    for (Coordinate &c : coords) {
+        
+        c.x = coord(rng);
+        c.y = coord(rng);
+        
+    }
+    
+    return coords;
+    
+}
+
+template <typename Solve>
+void measure(const char *name, bool reorder, Solve solve) {
+    
+    uint64_t start_counts[PerfCounters::num_counters];
+    uint64_t end_counts[PerfCounters::num_counters];
+    
+    PerfCounters::instance().read(start_counts);
+    auto start = std::chrono::steady_clock::now();
+    
+    double total = solve();
+    
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    PerfCounters::instance().read(end_counts);
+    
+    std::string misses = PerfCounters::instance().available() ? std::to_string(end_counts[2] - start_counts[2]) : "n/a";
+    
+    std::printf("%-8s %-8s %10.3f s  %14s llc misses  total %.2f\n", name, reorder ? "hilbert" : "input",
+                seconds, misses.c_str(), total);
+    
+}
+
+}
+
+int main(int argc, char** argv) {
+    
+    size_t num_locations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    size_t sort_locations = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+    
+    std::mt19937 rng(433);
+    
+    std::vector<Coordinate> coords = random_locations(num_locations, rng);
+    
+    for (int reorder = 0; reorder < 2; reorder++) {
+        
+        Drone drone;
+        
+        drone.set_reorder(reorder == 1);
+        
+        measure("MST", reorder == 1, [&]() {
+            
+            return drone.solve_mst(coords.data(), coords.size()).total_weight;
+            
+        });
+        
+        measure("FASTTSP", reorder == 1, [&]() {
+            
+            return drone.solve_fast_tsp(coords.data(), coords.size()).total_distance;
+            
+        });
+        
+    }
+    
+    std::vector<Coordinate> many = random_locations(sort_locations, rng);
+    std::vector<size_t> order;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    hilbert_order(many.data(), many.size(), order);
+    
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    std::printf("hilbert_order: %zu locations in %.1f ms\n", sort_locations, ms);
+    
+    return 0;
+    
+}
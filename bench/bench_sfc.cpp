@@ -0,0 +1,77 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  bench_sfc.cpp
+//  project4
+//
+//  SFCTSP against the Hilbert sort it is built on: how close the whole tour
+//  construction (zones patched, exact total) runs to sort speed, and what
+//  the Or-opt passes cost and buy.
+//
+//  Build and run from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. bench/bench_sfc.cpp binary_input.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp neighbor_graph.cpp mst_engines.cpp online_tour.cpp spatial.cpp -o bench_sfc
+//      ./bench_sfc [num_locations]
+//
+
+#include "drone.hpp"
+#include "spatial.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+int main(int argc, char** argv) {
+    
+    size_t num_locations = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    
+    std::mt19937 rng(97);
+    std::uniform_int_distribution<int> coord(-1000000, 1000000);
+    
+    std::vector<Coordinate> coords(num_locations);
+    
+    for (Coordinate &c : coords) {
+        
+        c.x = coord(rng);
+        c.y = coord(rng);
+        
+    }
+    
+    // A few Border locations so Medical and Normal can be joined
+    for (size_t i = 0; i < num_locations; i += 1000) {
+        
+        coords[i] = { -coord(rng) / 2 - 1, 0 };
+        
+    }
+    
+    std::vector<size_t> order;
+    
+    auto start = std::chrono::steady_clock::now();
+    
+    hilbert_order(coords.data(), coords.size(), order);
+    
+    double sort_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::printf("hilbert_order        %8.3f s\n", sort_s);
+    
+    for (int or_opt = 0; or_opt < 2; or_opt++) {
+        
+        Drone drone;
+        
+        drone.set_or_opt(or_opt == 1);
+        
+        start = std::chrono::steady_clock::now();
+        
+        double total = drone.solve_sfc_tsp(coords.data(), coords.size()).total_distance;
+        
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        std::printf("SFCTSP %-13s %8.3f s  (%.2fx sort)  total %.2f\n", or_opt ? "+ Or-opt" : "", seconds,
+                    seconds / sort_s, total);
+        
+    }
+    
+    return 0;
+    
+}
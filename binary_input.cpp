@@ -0,0 +1,224 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  binary_input.cpp
+//  project4
+//
+
+#include "binary_input.hpp"
+#include "spatial.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace {
+
+const char binary_magic[8] = { 'D', 'R', 'O', 'N', 'E', 'B', 'I', 'N' };
+
+static_assert(sizeof(BinaryHeader) == 64, "BinaryHeader is the first 64 bytes of the file");
+static_assert(sizeof(Coordinate) == 2 * sizeof(int32_t), "Coordinate is stored as two int32");
+
+// Locations read per chunk, so a corrupt count can't allocate everything at
+// once
+const size_t read_chunk = 1 << 20;
+
+// Throws unless header has the current version and the file (available
+// bytes, header included) holds all it promises
+void check_header(const BinaryHeader &header, uint64_t available) {
+    
+    if (header.version != binary_version) {
+        
+        throw DroneError("Error: Unsupported binary input version " + std::to_string(header.version) +
+                         ". Program terminating");
+        
+    }
+    
+    uint64_t per_location = sizeof(Coordinate) + ((header.flags & binary_zones) ? 1 : 0);
+    
+    if (header.count > (available - sizeof(BinaryHeader)) / per_location) {
+        
+        throw DroneError("Error: Binary input is cut short. Program terminating");
+        
+    }
+    
+}
+
+}
+
+// ----------------------------------------------------------------------------
+//                    Binary Format
+// ----------------------------------------------------------------------------
+
+bool is_binary_input(std::istream &is) {
+    
+    return is.peek() == binary_magic[0];
+    
+}
+
+void read_binary_input(std::istream &is, std::vector<Coordinate> &coords) {
+    
+    BinaryHeader header;
+    
+    if (!is.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, binary_magic, sizeof(binary_magic)) != 0) {
+        
+        throw DroneError("Error: Invalid binary input header. Program terminating");
+        
+    }
+    
+    // A stream's length is unknown, so only the version is checked here
+    check_header(header, std::numeric_limits<uint64_t>::max());
+    
+    coords.clear();
+    
+    while (coords.size() < header.count) {
+        
+        size_t done = coords.size();
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(header.count - done, read_chunk));
+        
+        coords.resize(done + chunk);
+        
+        if (!is.read(reinterpret_cast<char *>(coords.data() + done), static_cast<std::streamsize>(chunk * sizeof(Coordinate)))) {
+            
+            throw DroneError("Error: Binary input is cut short. Program terminating");
+            
+        }
+        
+    }
+    
+    if (header.flags & binary_zones) {
+        
+        is.ignore(static_cast<std::streamsize>(header.count));
+        
+    }
+    
+}
+
+void write_binary_input(std::ostream &os, const Coordinate *coords, size_t count, bool with_zones) {
+    
+    BinaryHeader header = {};
+    
+    std::memcpy(header.magic, binary_magic, sizeof(binary_magic));
+    
+    header.version = binary_version;
+    header.flags = with_zones ? binary_zones : 0;
+    header.count = count;
+    
+    std::vector<uint8_t> zones(with_zones ? count : 0);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        LocationType type = zone_of(coords[i]);
+        
+        header.zone_counts[static_cast<size_t>(type)]++;
+        
+        if (with_zones) {
+            
+            zones[i] = static_cast<uint8_t>(type);
+            
+        }
+        
+        header.min_x = (i == 0) ? coords[i].x : std::min(header.min_x, coords[i].x);
+        header.min_y = (i == 0) ? coords[i].y : std::min(header.min_y, coords[i].y);
+        header.max_x = (i == 0) ? coords[i].x : std::max(header.max_x, coords[i].x);
+        header.max_y = (i == 0) ? coords[i].y : std::max(header.max_y, coords[i].y);
+        
+    }
+    
+    os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    os.write(reinterpret_cast<const char *>(coords), static_cast<std::streamsize>(count * sizeof(Coordinate)));
+    os.write(reinterpret_cast<const char *>(zones.data()), static_cast<std::streamsize>(zones.size()));
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    MappedInput Definitions
+// ----------------------------------------------------------------------------
+
+MappedInput::MappedInput() {
+    
+    base = nullptr;
+    
+    length = 0;
+    
+}
+
+MappedInput::~MappedInput() {
+    
+    unmap();
+    
+}
+
+bool MappedInput::map(int fd) {
+    
+    unmap();
+    
+    struct stat info;
+    
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || static_cast<uint64_t>(info.st_size) < sizeof(BinaryHeader)) {
+        
+        return false;
+        
+    }
+    
+    // Text files are left for read_input(), without mapping them
+    char magic[sizeof(binary_magic)];
+    
+    if (pread(fd, magic, sizeof(magic), 0) != static_cast<ssize_t>(sizeof(magic)) ||
+        std::memcmp(magic, binary_magic, sizeof(binary_magic)) != 0) {
+        
+        return false;
+        
+    }
+    
+    void *mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    
+    if (mapped == MAP_FAILED) {
+        
+        return false;
+        
+    }
+    
+    base = mapped;
+    length = static_cast<size_t>(info.st_size);
+    
+    check_header(get_header(), length);
+    
+    return true;
+    
+}
+
+const BinaryHeader &MappedInput::get_header() const {
+    
+    return *static_cast<const BinaryHeader *>(base);
+    
+}
+
+// Right after the 64-byte header, so mmap's page alignment carries over
+const Coordinate *MappedInput::get_coords() const {
+    
+    return reinterpret_cast<const Coordinate *>(static_cast<const char *>(base) + sizeof(BinaryHeader));
+    
+}
+
+size_t MappedInput::size() const {
+    
+    return (base != nullptr) ? static_cast<size_t>(get_header().count) : 0;
+    
+}
+
+void MappedInput::unmap() {
+    
+    if (base != nullptr) {
+        
+        munmap(base, length);
+        
+        base = nullptr;
+        length = 0;
+        
+    }
+    
+}
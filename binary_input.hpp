@@ -0,0 +1,116 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  binary_input.hpp
+//  project4
+//
+//  Binary location files, for snapshots solved many times (written by
+//  tools/text_to_binary.cpp). Layout, native byte order:
+//
+//      BinaryHeader (64 bytes): magic "DRONEBIN", version, flags, count,
+//                   locations per zone (Medical, Border, Normal) and the
+//                   bounding box
+//      count x Coordinate (x, y as int32, 8 bytes per location)
+//      count x uint8 LocationType, if flags has binary_zones
+//
+//  The coordinates are stored exactly as the solvers take them, so a
+//  mapped file is used in place (MappedInput): no parsing and no copy, the
+//  pages load as the solver touches them. read_input() detects the magic
+//  and reads the same files from any stream with one bulk read. The zone
+//  bytes are for other tools; the solvers classify with zone_of(), which
+//  is cheaper than loading a byte.
+//
+//  Measured with bench/bench_ingest.cpp (10M locations, one core):
+//
+//      text, read_input()          1.7 s     148 MB
+//      binary, read_input()        0.13 s     80 MB
+//      binary, mapped              0.03 s     (one pass over the coordinates)
+//
+
+#ifndef BINARY_INPUT_HPP
+#define BINARY_INPUT_HPP
+
+#include "drone.hpp"
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+
+// ----------------------------------------------------------------------------
+//                    Binary Format
+// ----------------------------------------------------------------------------
+
+const uint32_t binary_version = 1;
+
+// BinaryHeader::flags: zone bytes follow the coordinates
+const uint32_t binary_zones = 1;
+
+struct BinaryHeader {
+
+    char magic[8];
+
+    uint32_t version;
+
+    uint32_t flags;
+
+    uint64_t count;
+
+    // Locations per LocationType (Medical, Border, Normal)
+    uint64_t zone_counts[3];
+
+    // Bounding box of the locations (all 0 if there are none)
+    int32_t min_x, min_y, max_x, max_y;
+
+};
+
+// True if the next byte of is starts a binary file (text starts with a
+// digit, a sign or whitespace). Consumes nothing.
+bool is_binary_input(std::istream &is);
+
+// Reads a binary file from is into coords (the zone bytes are skipped).
+// Throws DroneError if the header is invalid or the file is cut short.
+void read_binary_input(std::istream &is, std::vector<Coordinate> &coords);
+
+// Writes coords as a binary file, with zone bytes if with_zones
+void write_binary_input(std::ostream &os, const Coordinate *coords, size_t count, bool with_zones);
+
+// ----------------------------------------------------------------------------
+//                    MappedInput Declarations
+// ----------------------------------------------------------------------------
+
+// A binary file mapped read-only into memory
+class MappedInput {
+
+public:
+
+    MappedInput();
+
+    ~MappedInput();
+
+    MappedInput(const MappedInput &) = delete;
+
+    MappedInput &operator=(const MappedInput &) = delete;
+
+    // Maps the file open on fd if it is a regular file holding the binary
+    // format; returns false (leaving fd untouched) otherwise, e.g. for a
+    // pipe or a text file. Throws DroneError for a binary file that is cut
+    // short.
+    bool map(int fd);
+
+    const BinaryHeader &get_header() const;
+
+    const Coordinate *get_coords() const;
+
+    size_t size() const;
+
+private:
+
+    void unmap();
+
+    void *base;
+
+    size_t length;
+
+};
+
+#endif /* BINARY_INPUT_HPP */
@@ -0,0 +1,340 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  cluster_tour.cpp
+//  project4
+//
+
+#include "cluster_tour.hpp"
+#include "online_tour.hpp"
+#include "phase_timer.hpp"
+#include "spatial.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+
+namespace {
+
+// Local 2-opt passes over each sub-tour
+const size_t local_search_passes = 2;
+
+double distance_between(const Coordinate &a, const Coordinate &b) {
+    
+    return squared_length(squared_distance(a, b));
+    
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+}
+
+// FASTTSP tour over one cluster, then 2-opt around every stop; fills tour
+// with location numbers in visiting order
+void solve_cluster(const Coordinate *coords, const size_t *members, size_t size, Drone &drone,
+                   std::vector<Coordinate> &local, std::vector<size_t> &tour) {
+    
+    tour.assign(members, members + size);
+    
+    if (size < 4) {
+        
+        return;
+        
+    }
+    
+    local.resize(size);
+    
+    for (size_t i = 0; i < size; i++) {
+        
+        local[i] = coords[members[i]];
+        
+    }
+    
+    OnlineTour search;
+    
+    search.seed(local.data(), size, drone.solve_fast_tsp(local.data(), size).path);
+    
+    search.set_repair(true);
+    
+    for (size_t pass = 0; pass < local_search_passes; pass++) {
+        
+        double before = search.get_total_distance();
+        
+        for (size_t i = 0; i < size; i++) {
+            
+            search.repair_around(i);
+            
+        }
+        
+        if (search.get_total_distance() >= before) {
+            
+            break;
+            
+        }
+        
+    }
+    
+    std::vector<size_t> path;
+    
+    search.get_path(path);
+    
+    for (size_t i = 0; i < size; i++) {
+        
+        tour[i] = members[path[i]];
+        
+    }
+    
+}
+
+// Appends the cycle to path, opened at the edge that best joins from (the
+// previous exit) to the cycle and the cycle to to (the next cluster)
+void append_opened(const Coordinate *coords, const std::vector<size_t> &cycle, const Coordinate &from,
+                   const Coordinate &to, std::vector<size_t> &path) {
+    
+    size_t size = cycle.size();
+    
+    double best_cost = std::numeric_limits<double>::infinity();
+    
+    size_t best_edge = 0;
+    
+    bool best_forward = true;
+    
+    for (size_t i = 0; i < size; i++) {
+        
+        const Coordinate &a = coords[cycle[i]];
+        const Coordinate &b = coords[cycle[(i + 1) % size]];
+        
+        double removed = (size > 1) ? distance_between(a, b) : 0;
+        
+        // Forward: enter at b, leave at a
+        double forward = distance_between(from, b) + distance_between(a, to) - removed;
+        
+        // Backward: enter at a, leave at b
+        double backward = distance_between(from, a) + distance_between(b, to) - removed;
+        
+        if (forward < best_cost) {
+            
+            best_cost = forward;
+            best_edge = i;
+            best_forward = true;
+            
+        }
+        
+        if (backward < best_cost) {
+            
+            best_cost = backward;
+            best_edge = i;
+            best_forward = false;
+            
+        }
+        
+    }
+    
+    for (size_t step = 0; step < size; step++) {
+        
+        path.push_back(best_forward ? cycle[(best_edge + 1 + step) % size] : cycle[(best_edge + size - step) % size]);
+        
+    }
+    
+}
+
+}
+
+// ----------------------------------------------------------------------------
+//                    Cluster Tour Definitions
+// ----------------------------------------------------------------------------
+
+void cluster_tsp(const Coordinate *coords, size_t count, size_t num_clusters, Precision precision,
+                 TourResult &result, ClusterStats &stats, size_t num_threads) {
+    
+    if (count < 3) {
+        
+        throw DroneError("Error: FASTTSP needs at least 3 locations. Program terminating");
+        
+    }
+    
+    if (num_threads == 0) {
+        
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+        
+    }
+    
+    num_clusters = std::max<size_t>(1, std::min(num_clusters, count / 3));
+    
+    stats = ClusterStats();
+    stats.num_clusters = num_clusters;
+    
+    // 1. Partition: cluster c is order[first[c] .. first[c + 1])
+    auto start = std::chrono::steady_clock::now();
+    
+    std::vector<size_t> order;
+    std::vector<size_t> first(num_clusters + 1);
+    
+    {
+        PHASE_TIMER("cluster_partition");
+        
+        hilbert_order(coords, count, order);
+        
+        for (size_t c = 0; c <= num_clusters; c++) {
+            
+            first[c] = c * count / num_clusters;
+            
+        }
+        
+        // Input order within a cluster: insertion in curve order builds a
+        // much worse tour than in the (usually unordered) input order
+        for (size_t c = 0; c < num_clusters; c++) {
+            
+            std::sort(order.begin() + static_cast<std::ptrdiff_t>(first[c]), order.begin() + static_cast<std::ptrdiff_t>(first[c + 1]));
+            
+        }
+    }
+    
+    stats.partition_seconds = seconds_since(start);
+    
+    // 2. Sub-tours, handed out one cluster at a time
+    start = std::chrono::steady_clock::now();
+    
+    std::vector<std::vector<size_t>> cycles(num_clusters);
+    
+    {
+        PHASE_TIMER("cluster_subtours");
+        
+        std::atomic<size_t> next_cluster(0);
+        
+        auto worker = [&]() {
+            
+            Drone drone;
+            
+            drone.set_precision(precision);
+            
+            std::vector<Coordinate> local;
+            
+            for (size_t c = next_cluster++; c < num_clusters; c = next_cluster++) {
+                
+                solve_cluster(coords, order.data() + first[c], first[c + 1] - first[c], drone, local, cycles[c]);
+                
+            }
+            
+        };
+        
+        std::vector<std::thread> threads;
+        
+        for (size_t t = 1; t < num_threads && t < num_clusters; t++) {
+            
+            threads.emplace_back(worker);
+            
+        }
+        
+        worker();
+        
+        for (std::thread &thread : threads) {
+            
+            thread.join();
+            
+        }
+    }
+    
+    stats.subtour_seconds = seconds_since(start);
+    
+    // 3. Stitch
+    start = std::chrono::steady_clock::now();
+    
+    {
+        PHASE_TIMER("cluster_stitch");
+        
+        std::vector<Coordinate> centroids(num_clusters);
+        
+        for (size_t c = 0; c < num_clusters; c++) {
+            
+            double x = 0, y = 0;
+            
+            for (size_t i = first[c]; i < first[c + 1]; i++) {
+                
+                x += coords[order[i]].x;
+                y += coords[order[i]].y;
+                
+            }
+            
+            double size = static_cast<double>(first[c + 1] - first[c]);
+            
+            centroids[c] = { static_cast<int>(std::lround(x / size)), static_cast<int>(std::lround(y / size)) };
+            
+        }
+        
+        std::vector<size_t> cluster_order;
+        
+        if (num_clusters >= 3) {
+            
+            Drone drone;
+            
+            cluster_order = drone.solve_fast_tsp(centroids.data(), num_clusters).path;
+            
+        }
+        
+        else {
+            
+            for (size_t c = 0; c < num_clusters; c++) {
+                
+                cluster_order.push_back(c);
+                
+            }
+            
+        }
+        
+        std::vector<size_t> path;
+        
+        path.reserve(count);
+        
+        // Where each cluster's run starts in path (the joins)
+        std::vector<size_t> joins;
+        
+        for (size_t k = 0; k < num_clusters; k++) {
+            
+            size_t c = cluster_order[k];
+            
+            // The first cluster is entered from the last one's centroid; the
+            // last one leaves toward the first cluster's actual start (a lone
+            // cluster just goes around)
+            const Coordinate &from = (k == 0) ? centroids[cluster_order[num_clusters - 1]] : coords[path.back()];
+            const Coordinate &to = (k + 1 < num_clusters || path.empty()) ? centroids[cluster_order[(k + 1) % num_clusters]]
+            : coords[path.front()];
+            
+            joins.push_back(path.size());
+            
+            append_opened(coords, cycles[c], from, to, path);
+            
+        }
+        
+        OnlineTour tour;
+        
+        tour.seed(coords, count, path);
+        
+        tour.set_repair(true);
+        
+        for (size_t join : joins) {
+            
+            tour.repair_around(path[join]);
+            
+            tour.repair_around(path[(join + count - 1) % count]);
+            
+        }
+        
+        tour.get_path(result.path);
+    }
+    
+    stats.stitch_seconds = seconds_since(start);
+    
+    result.total_distance = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        result.total_distance += distance_between(coords[result.path[i]], coords[result.path[(i + 1) % count]]);
+        
+    }
+    
+}
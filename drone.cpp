@@ -8,225 +8,230 @@
 //
 
 #include "xcode_redirect.hpp"
+#include "drone.hpp"
+#include "binary_input.hpp"
+#include "external_mst.hpp"
+#include "fleet_routes.hpp"
+#include "online_mst.hpp"
+#include "online_tour.hpp"
+#include "phase_timer.hpp"
+#include "pipelined_input.hpp"
+#include "result_cache.hpp"
 #include <getopt.h>
-#include <cmath>
-#include <limits>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 #include <iostream>
-#include <algorithm>
 #include <iomanip>
 
 
 // ----------------------------------------------------------------------------
-//                    LocationType Declarations (Enumerated Class)
+//                    Options Declarations
 // ----------------------------------------------------------------------------
 
-enum class LocationType { Medical, Border, Normal, Empty};
+// Upper bounds for --threads, --clusters and --drones
+const uint64_t max_threads = 1024;
+const uint64_t max_clusters = 1 << 20;
+const uint64_t max_drones = 1 << 20;
 
-// ----------------------------------------------------------------------------
-//                    Location Declarations
-// ----------------------------------------------------------------------------
+struct Options {
+
+    // 'N' by default; must be 'M' for MST, 'F' for FASTTSP, 'O' for OPTTSP or
+    // 'S' for SFCTSP
+    char mode = 'N';
+
+    // --batch: stdin holds many instances back to back
+    bool batch = false;
+
+    // worker threads for --batch (0: one per core)
+    size_t num_threads = 0;
+
+    // --online: after the first instance, stdin is a stream of updates
+    bool online = false;
+
+    // --pipeline: parse stdin in parallel while it is read
+    bool pipeline = false;
+
+    // --repair: local 2-opt after each online tour update
+    bool repair = false;
+
+    // --warm-start: previous tour to start FASTTSP/OPTTSP from
+    std::string warm_start_file;
+
+    // --save-tour: where to write the tour for the next warm start
+    std::string save_tour_file;
+
+    // --mst-engine: how MST mode builds the tree
+    MSTEngine mst_engine = MSTEngine::Prim;
+
+    // --epsilon: slack per edge for --mst-engine approx
+    double mst_epsilon = 0.01;
+
+    // --weight-only: MST mode prints the total weight without the edges
+    bool weight_only = false;
+
+    // --memory-limit: MST mode computes the weight out of core within about
+    // this many megabytes (0: in memory)
+    double memory_megabytes = 0;
+
+    // --precision: float runs Prim, FASTTSP and OPTTSP on 32-bit values
+    Precision precision = Precision::Double;
+
+    // --tour-engine: how FASTTSP builds the tour
+    TourEngine tour_engine = TourEngine::Arbitrary;
+
+    // --clusters: FASTTSP solves this many spatial clusters and stitches them
+    size_t clusters = 0;
+
+    // --improve: what runs on the FASTTSP tour and the OPTTSP incumbent
+    Improvement improvement = Improvement::None;
+
+    // --time-limit: seconds for --improve
+    double time_limit = 5;
+
+    // --drones: FASTTSP/OPTTSP split the locations into this many routes
+    // from the depot (0: one tour)
+    size_t drones = 0;
+
+    // --or-opt: SFCTSP follows the curve tour with Or-opt passes
+    bool or_opt = false;
+
+    // --reorder: solve on locations sorted along a Hilbert curve
+    bool reorder = false;
+
+    // --cache: directory of cached results (empty: no cache)
+    std::string cache_dir;
+
+    // --cache-size: cap on the cache directory, in megabytes
+    uint64_t cache_megabytes = 256;
 
-class Location {
-    
-public:
-    
-    Location();
-    
-    Location(int x_coord_in, int y_coord_in, int location_num_in, char mode_in);
-    
-    int get_x_coord();
-    int get_y_coord();
-    LocationType get_location_type();
-    int get_location_num();
-    
-private:
-    
-    int x_coord;
-    int y_coord;
-    
-    // Location 0, 1, 2, 3, ect...
-    int location_num;
-    
-    // Medical: if x and y are both negative
-    // ex: (x = (-), y = (-))
-    // Border: if one is negative and other is 0, OR (0,0)
-    // ex: (x = 0, y = (-)) OR (y = 0, x = (-)) OR (x = 0, y = 0)
-    
-    LocationType location_type;
-    
 };
 
+// Throws DroneError on an invalid option value
+void get_options(int argc, char** argv, Options &options);
+
+// Parses the value of option 'name' as a whole number from 1 to max_value,
+// throwing DroneError for anything else (signs, trailing text, overflow)
+uint64_t parse_count_option(const char *name, const char *text, uint64_t max_value);
+
+// Tour files hold the locations in visiting order, in the input format
+void read_tour_file(const std::string &filename, std::vector<Coordinate> &tour);
+
+void write_tour_file(const std::string &filename, const Coordinate *coordinates, const TourResult &result);
+
+// Returns the cached result for coordinates if there is one; otherwise calls
+// solve() and caches what it returns. cache may be null.
+template <typename Result, typename Solve>
+Result solve_cached(ResultCache *cache, char mode, const std::string &variant, const Coordinate *coordinates, size_t count,
+                    Solve solve);
+
+// Cache key suffix for the options that change the answer
+std::string cache_variant(const Options &options);
+
+void run_online_MST(const Coordinate *coordinates, size_t count, const MSTResult &initial);
+
+void run_online_FASTTSP(const Coordinate *coordinates, size_t count, const TourResult &initial, bool repair);
+
+// Shared command loop for the online services ("add", "remove", "print" and
+// total_command, which calls print_total)
+template <typename Service, typename PrintTotal>
+void run_online_commands(Service &service, const char *total_command, PrintTotal print_total);
+
 // ----------------------------------------------------------------------------
-//                    Drone Declarations
+//                    BatchRunner Declarations
 // ----------------------------------------------------------------------------
 
-class Drone {
-    
+// Solves a stream of instances on a fixed pool of worker threads. Each worker
+// owns a Drone (so its vectors are reused from instance to instance) and the
+// instance/output slots are reused from window to window. Results are written
+// in input order.
+class BatchRunner {
+
 public:
-    
-//    struct Node {
-//
-//        int location_index;
-//        Node* prev;
-//        Node* next;
-//
-//    };
-    
-    Drone();
-    
-    void get_options(int argc, char** argv);
-    
-    char get_mode();
-    
-    double get_distance(Location &l1, Location &l2);
-    
-    void read_input();
-    
-    // PART A: MST //
-    
-    void run_MST();
-    
-    void prim_algorithm();
-    
-    void prim_initialize_vectors(Location &first_location, size_t first_location_index);
-    
-    void prim_algorithm_update(Location &next_location, size_t next_location_index);
-    
-    size_t find_closest_location();
-    
-    double MST_get_total_distance();
-    
-    void MST_print();
-    
-    // PART B: FASTTSP //
-    
-    void run_FASTTSP();
-    
-    void FAST_initialize_vectors(size_t first_index, size_t second_index, size_t third_index, double &total_distance);
-    
-    void FAST_initialize_distance_vector();
-    
-    void FAST_arbitrary_insert_algorithm(double &total_distance);
-    
-    void FAST_print(double total_distance);
-    
-    double FAST_distance_change(size_t first_index, size_t second_index, size_t new_index);
-    
-    // PART C: OPTTSP //
-    
-    void run_OPTTSP();
-    
-    void genPerms(size_t permLength);
-    
-    bool is_promising(size_t permLength);
-    
-    void OPT_initialize();
-    
-    void OPT_FASTTSP_helper();
-    
-    void OPT_modified_prim_update(Location &next_location, size_t next_location_index, std::vector<size_t> &unvisited_locations);
-    
-    void OPT_modified_prim_initialize_vectors(Location &first_location, size_t first_location_index, std::vector<size_t> &unvisited_locations);
-    
-    void OPT_modified_prim_algorithm(std::vector<size_t> &unvisited_locations);
-    
-    void OPT_reset_prim();
-    
-    void OPT_print();
-    
+
+    // cache_in may be null
+    BatchRunner(const Options &options, ResultCache *cache_in);
+
+    ~BatchRunner();
+
+    // Returns false if any instance failed
+    bool run(std::istream &is, std::ostream &os);
+
 private:
-    
-    // 'N' by default; must be 'M' for MST, 'F' for FASTTSP, or 'O' for OPTTSP
+
+    void worker_loop();
+
+    // Takes the next unsolved slot of window claim_generation (window slots
+    // long). False once that window has none left or run() has moved on.
+    bool claim_slot(size_t claim_generation, size_t window, size_t &slot);
+
+    void solve_slot(Drone &drone, size_t slot);
+
     char mode;
-    
-    int num_locations;
-    
-    // For all vectors:
-    // Index of locations corresponds to location num
-    // ex: Index 0 stores Location 0
-    std::vector<Location> v_locations;
-    
-    // ----------------------------------------------------------------------------
-    //                    PART A
-    // ----------------------------------------------------------------------------
-    
-    // Parent location
-    std::vector<Location> prim_parents;
-    
-    // Distance from parent
-    std::vector<double> prim_distances;
-    
-    // if visited or not
-    std::vector<bool> prim_visited;
-    
-    // ----------------------------------------------------------------------------
-    //                    PART B
-    // ----------------------------------------------------------------------------
-    
-    std::vector<size_t> FAST_path;
-    
-    
-    // ----------------------------------------------------------------------------
-    //                    PART C
-    // ----------------------------------------------------------------------------
-    
-    
-    std::vector<size_t> OPT_path;
-    
-    std::vector<size_t> OPT_best_path;
-    
-    double OPT_best_distance;
-    
-    double OPT_current_distance;
-    
-    //std::vector<bool> OPT_visited;
-    
-};
 
+    bool reorder;
 
-//// ----------------------------------------------------------------------------
-////                    Optimal Declarations
-//// ----------------------------------------------------------------------------
-//
-//class Optimal {
-//
-//public:
-//
-//    template <typename T>
-//    void genPerms(size_t permLength) {
-//        if (permLength == path.size()) {
-//
-//            // add closing edge
-//            // check/update best distance/path
-//            // subtract closing edge
-//
-//
-//            return;
-//        } // if
-//        if (!promising(path, permLength))
-//            return;
-//        for (size_t i = permLength; i < path.size(); ++i) {
-//            swap(path[permLength], path[i]);
-//            genPerms(path, permLength + 1);
-//            swap(path[permLength], path[i]);
-//        } // for
-//    } // genPerms()
-//
-//
-//private:
-//
-//    std::vector<size_t> &OPT_path;
-//
-//    std::vector<size_t> &OPT_best_path;
-//
-//    double OPT_running_total;
-//
-//    double OPT_best_distance;
-//
-//
-//};
+    bool or_opt;
+
+    MSTEngine mst_engine;
 
+    double mst_epsilon;
+
+    bool weight_only;
+
+    Precision precision;
+
+    TourEngine tour_engine;
+
+    size_t clusters;
+
+    Improvement improvement;
+
+    double time_limit;
+
+    size_t drones;
+
+    ResultCache *cache;
+
+    std::string variant;
+
+    std::vector<std::thread> workers;
+
+    // One window of instances and their rendered output
+    std::vector<std::vector<Coordinate>> instances;
+    std::vector<std::string> outputs;
+    std::vector<std::string> errors;
+
+    size_t window_size;
+
+    // Work distribution for the current window
+    std::mutex lock;
+    std::condition_variable work_ready;
+    std::condition_variable work_done;
+
+    // Workers read generation and slots_in_window only under the lock, into
+    // local copies. next_claim packs the window's generation (high 32 bits)
+    // with its next unclaimed slot (low 32 bits), so a worker still holding
+    // an older window's copies can't claim a slot of the current one.
+    size_t generation;
+    size_t slots_in_window;
+    size_t slots_finished;
+    std::atomic<uint64_t> next_claim;
+
+    bool shutting_down;
+
+};
 
 
 // ----------------------------------------------------------------------------
@@ -234,1021 +239,1297 @@ private:
 // ----------------------------------------------------------------------------
 
 int main(int argc, char** argv) {
-    
+
     xcode_redirect(argc, argv);
     std::ios_base::sync_with_stdio(false);
-    
+
     std::cout << std::setprecision(2); // Always show 2 decimal places
     std::cout << std::fixed; // Disable scientific notation for large numbers
-    
-    Drone d1;
-    
-    d1.get_options(argc, argv);
-    
-    // MST mode
-    if (d1.get_mode() == 'M') {
-        
-        d1.run_MST();
-        
-    }
-    
-    else if (d1.get_mode() == 'F') {
-        
-        d1.run_FASTTSP();
-        
-    }
-    
-    else if (d1.get_mode() == 'O') {
-        
-        
-        d1.run_OPTTSP();
-        
-    }
-    
-    else {
-        
-        std::cerr << "Error: Invalid mode: '" << d1.get_mode() << "' read in from getOpt. Program terminating\n";
-        
-        exit(1);
-        
-    }
-
-    return 0;
-    
-}
 
+    Options options;
 
-// ----------------------------------------------------------------------------
-//                    Location Definitions
-// ----------------------------------------------------------------------------
+    try {
 
-Location::Location() {
-    
-    // Default values; only appear if uninitialized
-    location_type = LocationType::Empty;
-    
-    location_num = -1;
-    
-}
+        get_options(argc, argv, options);
 
-Location::Location(int x_coord_in, int y_coord_in, int location_num_in, char mode_in) {
-    
-    location_num = location_num_in;
-    
-    x_coord = x_coord_in;
-    y_coord = y_coord_in;
-    
-    // Medical: if x and y are both negative
-    // ex: (x = (-), y = (-))
-    // Border: if one is negative and other is 0, OR (0,0)
-    // ex: (x = 0, y = (-)) OR (y = 0, x = (-)) OR (x = 0, y = 0)
-    
-    if (mode_in == 'M') { // need LocationType
-        
-        if (x_coord < 0 && y_coord < 0) {
-            
-            location_type = LocationType::Medical;
-            
-        }
-        
-        else if ((x_coord < 0 && y_coord == 0) ||
-                 (y_coord < 0 && x_coord == 0) ||
-                 (x_coord == 0 && y_coord == 0)) {
-            
-            location_type = LocationType::Border;
-            
-        }
-        
-        else {
-            
-            location_type = LocationType::Normal;
-            
-        }
-        
     }
-    
-}
 
-int Location::get_x_coord() {
-    
-    return x_coord;
-    
-}
+    catch (const DroneError &e) {
 
-int Location::get_y_coord() {
-    
-    return y_coord;
-    
-}
+        std::cerr << e.what() << "\n";
 
-LocationType Location::get_location_type() {
-    
-    return location_type;
-    
-}
+        exit(1);
 
-int Location::get_location_num() {
-    
-    return location_num;
-    
-}
+    }
 
-// ----------------------------------------------------------------------------
-//                    Drone Definitions
-// ----------------------------------------------------------------------------
+    if (options.mode != 'M' && options.mode != 'F' && options.mode != 'O' && options.mode != 'S') {
 
-// Default constructor
-Drone::Drone() {
-    
-    mode = 'N';
-    
-}
+        std::cerr << "Error: Invalid mode: '" << options.mode << "' read in from getOpt. Program terminating\n";
+
+        exit(1);
 
-void Drone::get_options(int argc, char** argv) {
-    
-    int option_index = 0, option = 0;
-    
-    // Don't display getopt error messages about options
-    opterr = false;
-    
-    // use getopt to find command line options
-    struct option longOpts[] = {{ "mode", required_argument, nullptr, 'm' },
-        { "help", no_argument, nullptr, 'h' },
-        { nullptr, 0, nullptr, '\0' }};
-    
-    while ((option = getopt_long(argc, argv, "m:h", longOpts, &option_index)) != -1) {
-        switch (option) {
-                
-            case 'h':
-                
-                std::cerr << "This program simulates an on-campus drone delivery service.\n"
-                
-                << "There are two types of drones (Drone Type I and Drone Type II), and \n"
-                << "three types of clients (A, B, and C). The program will aim to find the\n"
-                << "shortest route distancewise to be able to service all locations across\n"
-                << "campus.\n"
-                << "Usage: \'./drone\n"
-                <<                      "\t[--help | -h]\n"
-                <<                      "\t[--mode | -m] <TYPE (either \"MST\", \"FASTTSP\", or \"OPTTSP\">\n";
-                
-                exit(0);
-                
-            case 'm':
-                
-                if (strcmp(optarg, "MST") == 0) { // MST
-                    
-                    mode = 'M';
-                    
-                }
-                
-                else if (strcmp(optarg, "FASTTSP") == 0) { // FASTTSP
-                    
-                    mode = 'F';
-                    
-                }
-                
-                else if (strcmp(optarg, "OPTTSP") == 0) { // OPTTSP
-                    
-                    mode = 'O';
-                    
-                }
-                
-                else { // Invalid command-line argument
-                    
-                    std::cerr << "Error: Invalid command line arguments. \"mode\" must be either: "
-                    << "\"MST\", \"FASTTSP\", or \"OPTTSP\". Program terminating\n";
-                    
-                }
-                
-                break;
-                
-            default:
-                
-                std::cerr << "Error: Invalid command line arguments. Program terminating\n";
-                
-                exit(1);
-                
-        }
-        
-    }
-    
-}
-        
-char Drone::get_mode() {
-    
-    return mode;
-    
-}
-        
-double Drone::get_distance(Location &l1, Location &l2) {
-    
-    LocationType t1 = l1.get_location_type();
-    LocationType t2 = l2.get_location_type();
-    
-    // Unreachable (one is normal and one is medical); return infinity
-    if ((t1 == LocationType::Medical && t2 == LocationType::Normal) ||
-        (t2 == LocationType::Medical && t1 == LocationType::Normal)) {
-        
-        return std::numeric_limits<double>::infinity();
-        
     }
-    
-    //               ____________________________
-    // Formula:     /          2              2
-    //             /  (X2 - X1)   +  (Y2 - Y1)
-    //           \/
-    
-    double x1 = static_cast<double>(l1.get_x_coord());
-    double y1 = static_cast<double>(l1.get_y_coord());
-    
-    double x2 = static_cast<double>(l2.get_x_coord());
-    double y2 = static_cast<double>(l2.get_y_coord());
-    
-    double distance = pow((x2 - x1), 2) + pow((y2 - y1), 2);
-    
-    distance = sqrt(distance);
-    
-    return distance;
-    
-}
 
-// ----------------------------------------------------------------------------
-//                    PART A: MST
-// ----------------------------------------------------------------------------
+    // Out of core: stdin is streamed to spill files, never held in memory
+    if (options.memory_megabytes > 0) {
 
-void Drone::run_MST() {
-    
-    read_input();
-    
-    prim_algorithm();
-    
-    MST_print();
-    
-}
+        if (options.mode != 'M' || options.batch || options.online) {
 
+            std::cerr << "Error: Invalid command line arguments. \"memory-limit\" needs MST mode without "
+            << "--batch or --online. Program terminating\n";
 
-// reads in number of locations, initializes a member variables
-// reads in locations and adds them to a vector
-void Drone::read_input() {
-    
-    int num_locations_in, x_in, y_in;
-    
-    std::cin >> num_locations_in;
-    
-    num_locations = num_locations_in;
-    
-    v_locations.reserve(static_cast<size_t>(num_locations));
-    
-    for (int i = 0; i < num_locations; i++) {
-        
-        std::cin >> x_in >> y_in;
-        
-        Location l_in(x_in, y_in, i, mode);
-        
-        v_locations.push_back(l_in);
-        
-    }
-    
-}
+            exit(1);
 
-void Drone::prim_algorithm() {
-    
-    // first location to start tree
-    Location first = v_locations[0];
-
-    prim_initialize_vectors(first, 0);
-    
-    int count = 1;
-    
-    // Algorithm
-    
-    // while not all locations have been visited
-    while (count != num_locations) {
-        
-        size_t next_location_index = find_closest_location();
-        
-        prim_algorithm_update(v_locations[next_location_index], next_location_index);
-        
-        count++;
-        
-    }
-    
-}
+        }
 
-void Drone::prim_initialize_vectors(Location &first_location, size_t first_location_index) {
-    
-    // Initializing vector prim_parents
-    std::vector<Location> temp_parents(static_cast<size_t>(num_locations), first_location);
-    prim_parents.swap(temp_parents);
-    
-    // Initializing vector prim_distances
-    std::vector<double> temp_distances(static_cast<size_t>(num_locations));
-    
-    // Filling vector with distance from each location to first location/first parent
-    for (size_t i = 0; i < static_cast<size_t>(num_locations); i++) {
-        
-        temp_distances[i] = get_distance(first_location, v_locations[i]);
-        
-    }
-    
-    prim_distances.swap(temp_distances);
-    
-    // Initializing vector prim_visited
-    std::vector<bool> temp_visited(static_cast<size_t>(num_locations), false);
-    
-    // setting first location to visited
-    temp_visited[first_location_index] = true;
-    
-    prim_visited.swap(temp_visited);
-    
-    return;
-    
-}
+        try {
 
-size_t Drone::find_closest_location() {
-    
-    double min_distance = std::numeric_limits<double>::infinity();
-    
-    int index = -1;
-    
-//    for (int i = 0; i < num_locations; i++) {
-//
-//        if (prim_distances[static_cast<size_t>(i)] < min_distance) {
-//
-//            // unvisited location
-//            if (prim_visited[static_cast<size_t>(i)] == false) {
-//
-//                // new minimum distance
-//                min_distance = prim_distances[static_cast<size_t>(i)];
-//
-//                index = i;
-//
-//            }
-//
-//        }
-//
-//    }
-    
-    for (int i = 0; i < static_cast<int>(prim_distances.size()); i++) {
-        
-        if (prim_distances[static_cast<size_t>(i)] < min_distance) {
-            
-            // unvisited location
-            if (prim_visited[static_cast<size_t>(i)] == false) {
-                
-                // new minimum distance
-                min_distance = prim_distances[static_cast<size_t>(i)];
-                
-                index = i;
-                
-            }
-            
-        }
-        
-    }
-    
-    // DEBUG
-    if ((min_distance == std::numeric_limits<double>::infinity()) || (index == -1)) {
-        
-        std::cerr << "Error: No closest location found. Program terminating\n";
-        
-        exit(1);
-        
-    }
-    
-    return static_cast<size_t>(index);
-    
-}
+            const char *spill_dir = std::getenv("TMPDIR");
+
+            double weight = external_mst_weight(std::cin, static_cast<uint64_t>(options.memory_megabytes * 1024 * 1024),
+                                                (spill_dir != nullptr) ? spill_dir : "/tmp");
+
+            PHASE_TIMER("print");
+            std::cout << weight << "\n";
 
-void Drone::prim_algorithm_update(Location &next_location, size_t next_location_index) {
-    
-    // added to the tree
-    prim_visited[next_location_index] = true;
-    
-    for (size_t i = 0; i < static_cast<size_t>(num_locations); i++) {
-        
-        // same location as next location
-        if (i == next_location_index) {
-            
-            continue;
-            
-        }
-        
-        // Only looking at locations that are not part of the map
-        if (prim_visited[i] == false) {
-            
-            double temp_distance = get_distance(next_location, v_locations[i]);
-            
-            // if (distance between this location and next location) is less than (distance to current parent)
-            if (temp_distance < prim_distances[i]) {
-                
-                // New parent, update distance
-                prim_parents[i] = next_location;
-                
-                prim_distances[i] = temp_distance;
-                
-            }
-            
         }
-        
-    }
-    
-}
 
-double Drone::MST_get_total_distance() {
-    
-    double total_weight = 0;
-    
-    // Finding total distances
-    for (size_t i = 0; i < prim_distances.size(); i++) {
-        
-        // DEBUG
-        if (prim_distances[i] == std::numeric_limits<double>::infinity()) {
-            
-            std::cerr << "Error: After MST Tree was constructed, found an edge with length INFINITY. Program terminating\n";
-            
+        catch (const DroneError &e) {
+
+            std::cerr << e.what() << "\n";
+
             exit(1);
-            
+
         }
-        
-        total_weight += prim_distances[i];
-        
-    }
-    
-    return total_weight;
-    
-    
-}
 
-void Drone::MST_print() {
+        PHASE_REPORT();
+
+        return 0;
 
-    double total_weight = MST_get_total_distance();
-    
-//    // Finding total distances
-//    for (size_t i = 0; i < prim_distances.size(); i++) {
-//
-//        // DEBUG
-//        if (prim_distances[i] == std::numeric_limits<double>::infinity()) {
-//
-//            std::cerr << "Error: After MST Tree was constructed, found an edge with length INFINITY. Program terminating\n";
-//
-//            exit(1);
-//
-//        }
-//
-//        total_weight += prim_distances[i];
-//
-//    }
-    
-    std::cout << total_weight << "\n";
-    
-    // Skipping first location (it is its own parent)
-    for (size_t i = 1; i < static_cast<size_t>(num_locations); i++) {
-        
-        Location this_location = v_locations[i];
-        Location parent_location = prim_parents[i];
-        
-        if (this_location.get_location_num() < parent_location.get_location_num()) {
-            
-            std::cout << this_location.get_location_num() << " " << parent_location.get_location_num() << "\n";
-            
-        }
-        
-        else {
-            
-            std::cout << parent_location.get_location_num() << " " << this_location.get_location_num() << "\n";
-            
-        }
-        
     }
-    
-}
 
-// ----------------------------------------------------------------------------
-//                    PART B: FASTTSP
-// ----------------------------------------------------------------------------
+    // A warm start changes the answer, so those runs skip the cache, and so
+    // do approximate MSTs (their lower bound is not cached)
+    std::unique_ptr<ResultCache> cache;
 
-void Drone::run_FASTTSP() {
-    
-    read_input();
-    
-    double total_distance = 0;
-    
-    FAST_initialize_vectors(0, 1, 2, total_distance);
-    
-    FAST_arbitrary_insert_algorithm(total_distance);
-    
-    FAST_print(total_distance);
-    
-}
+    bool approximate = (options.mode == 'M' && options.mst_engine == MSTEngine::Approximate);
 
-void Drone::FAST_initialize_vectors(size_t first_index, size_t second_index, size_t third_index, double &total_distance) {
-    
-    // +1 accounts for 0 (looping back to first index. Ex: 0-> 1-> 2-> 0)
-    FAST_path.reserve(static_cast<size_t>(num_locations + 1));
-    
-    FAST_path.push_back(first_index);
-    FAST_path.push_back(second_index);
-    FAST_path.push_back(third_index);
-    FAST_path.push_back(first_index);
-    
-    total_distance += get_distance(v_locations[first_index], v_locations[second_index]) +
-    get_distance(v_locations[second_index], v_locations[third_index]) +
-    get_distance(v_locations[third_index], v_locations[first_index]);
-    
-}
+    if (!options.cache_dir.empty() && options.warm_start_file.empty() && !approximate) {
+
+        cache.reset(new ResultCache(options.cache_dir, options.cache_megabytes * 1024 * 1024));
 
-void Drone::FAST_arbitrary_insert_algorithm(double &total_distance) {
-    
-    // starting at index 3 (4th Location)
-    // looping through rest of locations
-    for (size_t i = 3; i < static_cast<size_t>(num_locations); i++) {
-        
-        double min_distance_change = std::numeric_limits<double>::infinity();
-        
-        // should insert after index found
-        // ex: (0, 1, 2, 3) -> insert between 1 and 2
-        // => index where this is found is 1 (between 1 and 2)
-        // => insert at index 2 (index 1 + 1 = 2)
-        
-        // size_t index_to_insert;
-        
-        // looping through current path
-        // -1: vector path already accounts for last/first comparison; don't check last value
-        // (0, 1, 2, 0) -> only check 0 (0 -> 1), 1 (1 -> 2), 2 (2 -> 0)
-        
-        // iterators for vector.insert()
-        auto it = FAST_path.begin();
-        auto it_insert_index = it;
-        
-        for (size_t j = 0; j < FAST_path.size() - 1; j++) {
-            
-            // +1 is for looking at this location and next location
-            
-            double distance_change = FAST_distance_change(j, (j + 1), i);
-            
-            // shorter distance than current best
-            if (distance_change < min_distance_change) {
-                
-                min_distance_change = distance_change;
-                
-                //index_to_insert = j + 1;
-                
-                it_insert_index = it;
-                it_insert_index++;
-                
-            }
-            
-            it++;
-            
-        }
-        
-        // distance added from inserting location into path
-        total_distance += min_distance_change;
-        
-        // i = index of location being inserted
-        // 0 will always be the last element in FAST_path
-        FAST_path.insert(it_insert_index, i);
-        
     }
-    
-}
 
-double Drone::FAST_distance_change(size_t first_index, size_t second_index, size_t new_index) {
-    
-    // v_locations(0, 1, 2, ...) [path(1, 4, 2, 3, ...)]
-    Location first = v_locations[FAST_path[first_index]];
-    Location second = v_locations[FAST_path[second_index]];
-    Location new_location = v_locations[new_index];
-    
-    //
-    // Formula: change in distance = d(i, k) + d(k, j) - d(i, j)
-    //
-    //    Location i: first Location
-    //
-    //    Location j: second Location
-    //
-    //    Location k: location being inserted into the path
-    //
-    
-    double distance_change = get_distance(first, new_location) + get_distance(new_location, second) - get_distance(first, second);
-    
-    return distance_change;
-    
-}
+    if (options.batch) {
+
+        BatchRunner runner(options, cache.get());
+
+        bool ok = runner.run(std::cin, std::cout);
+
+        PHASE_REPORT();
+
+        return ok ? 0 : 1;
 
-void Drone::FAST_print(double total_distance) {
-    
-    // popping 0 at the back
-    FAST_path.pop_back();
-    
-    std::cout << total_distance << "\n";
-    
-    // printing path
-    for (size_t i = 0; i < FAST_path.size(); i++) {
-        
-        std::cout << FAST_path[i] << " ";
-        
     }
-    
-}
 
+    // The solvers take locations[0 .. num_locations - 1]: a binary file
+    // mapped in place, or the parsed input
+    std::vector<Coordinate> coordinates;
+    std::vector<uint64_t> hilbert_keys;
 
-// ----------------------------------------------------------------------------
-//                    PART C: OPTTSP
-// ----------------------------------------------------------------------------
+    MappedInput mapped;
 
-void Drone::run_OPTTSP() {
-    
-    read_input();
-    
-    OPT_initialize();
-    
-    
-//    // DEBUG
-//    std::cout << OPT_best_distance << "\n";
-//    for (size_t i = 0; i < FAST_path.size(); i++) {
-//
-//        std::cout << FAST_path[i] << " ";
-//
-//    }
-//    std::cout << "\n";
-    
-    genPerms(1);
-    
-    OPT_print();
-    
-}
+    Drone d1;
 
-void Drone::OPT_initialize() {
-    
-    //std::vector<bool> temp_visited(static_cast<size_t>(num_locations), false);
-    //OPT_visited.swap(temp_visited);
-    
-    // initializes:
-    
-    //     OPT_best_path
-    //     OPT_best_distance
-    OPT_FASTTSP_helper();
-    
-    OPT_path.resize(static_cast<size_t>(num_locations));
-    
-    // 0, 1, 2, 3...
-    for (size_t i = 0; i < static_cast<size_t>(num_locations); i++) {
-
-        OPT_path[i] = i;
+    try {
 
-    }
-    
-    OPT_current_distance = 0;
-    
-    // Location 0 is visited first
-    //OPT_visited[0] = true;
-    
-}
+        PHASE_TIMER("read_input");
 
-// initializes:
-//     OPT_path
-//     OPT_best_path
-//     OPT_best_distance
-void Drone::OPT_FASTTSP_helper() {
-    
-    double total_distance = 0;
-    
-    FAST_initialize_vectors(0, 1, 2, total_distance);
-    
-    FAST_arbitrary_insert_algorithm(total_distance);
-    
-    OPT_best_distance = total_distance;
-    
-    
-    // Popping 0 at the back of vector
-    FAST_path.pop_back();
-    
-    OPT_best_path = FAST_path;
-    
-}
+        // Online commands follow the locations on stdin, so only the plain
+        // reader stops where they start
+        bool in_place = !options.online && mapped.map(STDIN_FILENO);
 
-void Drone::genPerms(size_t permLength) {
-    
-    // DEBUG
-    
-    if (permLength == 25) {
+        if (!in_place && options.pipeline && !options.online) {
 
-        std::cout << "DEBUG\n";
+            read_input_pipelined(std::cin, coordinates, hilbert_keys);
+
+            d1.set_hilbert_keys(hilbert_keys.data(), hilbert_keys.size());
 
-    }
-    
-    if (permLength == OPT_path.size()) {
-        
-        // add closing edge
-        // check/update best distance/path
-        // subtract closing edge
-        
-        // closing edge
-        double closing_edge = get_distance(v_locations[OPT_path[0]], v_locations[OPT_path[permLength - 1]]);
-        
-        
-//        //DEBUG:
-//
-//        if (OPT_current_distance + closing_edge > 354.2 && OPT_current_distance + closing_edge < 354.3) {
-//
-//            std::cout << "DEBUG\n";
-//
-//            int i = 0;
-//            i++;
-//
-//        }
-        
-        OPT_current_distance += closing_edge;
-        
-        // Better than previous distance; update best distance
-        if (OPT_current_distance < OPT_best_distance) {
-            
-            OPT_best_distance = OPT_current_distance;
-            
-            OPT_best_path = OPT_path;
-            
-        }
-        
-        OPT_current_distance -= closing_edge;
-        
-        return;
-        
-    } // if
-    if (is_promising(permLength) == false) {
-        
-        return;
-        
-    }
-    
-    for (size_t i = permLength; i < OPT_path.size(); ++i) {
-        
-        std::swap(OPT_path[permLength], OPT_path[i]);
-        
-        OPT_current_distance += get_distance(v_locations[OPT_path[permLength]], v_locations[OPT_path[permLength - 1]]);
-        
-        genPerms(permLength + 1);
-        
-        OPT_current_distance -= get_distance(v_locations[OPT_path[permLength]], v_locations[OPT_path[permLength - 1]]);
-        
-        std::swap(OPT_path[permLength], OPT_path[i]);
-        
-        //OPT_visited[OPT_path[i]] = true;
-        
-    } // for
-    
-} // genPerms()
-
-bool Drone::is_promising(size_t permLength) {
-    
-    // if there is 4 or less unvisited vertices
-    if (OPT_path.size() - permLength <= 5) {
-        
-        return true;
-        
-    }
-    
-    // Making a MST out of unvisited Locations
-    std::vector<size_t> unvisited;
-    unvisited.reserve(static_cast<size_t>(num_locations) - permLength);
-    
-    for (size_t i = permLength; i < OPT_path.size(); i++) {
-        
-        unvisited.push_back(i);
-        
-    }
-    
-//    for (size_t i = 0; i < OPT_visited.size(); i++) {
-//
-//        if (OPT_visited[i] == false) {
-//
-//            // permLength is already at the front of index
-//            if (i != permLength) {
-//
-//                unvisited.push_back(i);
-//
-//            }
-//
-//        }
-//
-//    }
-    
-    //OPT_modified_prim_initialize_vectors(v_locations[unvisited[0]], 0, unvisited);
-    
-    OPT_modified_prim_algorithm(unvisited);
-    
-    // MST created
-    
-//    // Edge from MST to beginning of path (closing edge)
-//    double connecting_edge = get_distance(v_locations[OPT_path[permLength]], v_locations[OPT_path[0]]);
-    
-    //size_t zero_connecting_index = 0, last_connecting_index = 0;
-    double zero_distance = std::numeric_limits<double>::infinity(), last_distance = std::numeric_limits<double>::infinity();
-    
-    for (size_t i = 0; i < unvisited.size(); i++) {
-        
-        // Distance from first Location in path to this unvisited locaiton
-        double temp_zero = get_distance(v_locations[OPT_path[unvisited[i]]], v_locations[OPT_path[0]]);
-        
-        if (temp_zero < zero_distance) {
-            
-            zero_distance = temp_zero;
-            
         }
-        
-        // Distance from last fixed Location in path to this unvisited locaiton
-        double temp_last = get_distance(v_locations[OPT_path[unvisited[i]]], v_locations[OPT_path[permLength - 1]]);
-        
-        if (temp_last < last_distance) {
-            
-            last_distance = temp_last;
-            
+
+        else if (!in_place) {
+
+            read_input(std::cin, coordinates);
+
         }
-        
-    }
-    
-    // Estimated distance + distance traveled already + connecting_edge
-    double lower_bound = MST_get_total_distance() + OPT_current_distance + zero_distance + last_distance;
-    
-    // DEBUG:
-//    std::cout << MST_get_total_distance() << "\n";
-//
-//    for (size_t i = 0; i < unvisited.size(); i++) {
-//
-//        std::cout << v_locations[unvisited[i]].get_x_coord() << " " << v_locations[unvisited[i]].get_y_coord() << "\n";
-//
-//    }
-    
-//    for (size_t i = 0; i < prim_distances.size() - 1; i++) {
-//
-//        Location this_location = v_locations[unvisited[i]];
-//        Location parent_location = prim_parents[unvisited[i]];
-//
-//        if (this_location.get_location_num() < parent_location.get_location_num()) {
-//
-//            std::cout << unvisited[i] << " " << parent_location.get_location_num() - 1 << "\n";
-//
-//        }
-//
-//        else {
-//
-//            std::cout << parent_location.get_location_num() - 1 << " " << unvisited[i] << "\n";
-//
-//        }
-//
-//    }
-    
-    
-    // clear MST to be used again
-    
-    OPT_reset_prim();
-    
-    // keep searching this path
-    if (lower_bound < OPT_best_distance) {
-        
-        return true;
-        
-    }
-    
-    else {
-        
-        return false;
-        
+
     }
-    
-    
-}
 
+    catch (const DroneError &e) {
 
-void Drone::OPT_modified_prim_algorithm(std::vector<size_t> &unvisited_locations) {
-    
-    // first location to start tree
-    Location first = v_locations[unvisited_locations[0]];
-//
-    OPT_modified_prim_initialize_vectors(first, 0, unvisited_locations);
-    
-    size_t count = 1;
-    
-    while (count != unvisited_locations.size()) {
-        
-        size_t next_location_index = find_closest_location();
-        
-        OPT_modified_prim_update(v_locations[unvisited_locations[next_location_index]], next_location_index, unvisited_locations);
-        
-        count++;
-        
-    }
-    
-}
+        std::cerr << e.what() << "\n";
+
+        exit(1);
 
-void Drone::OPT_modified_prim_initialize_vectors(Location &first_location, size_t first_location_index, std::vector<size_t> &unvisited_locations) {
-    
-    // Initializing vector prim_parents
-    std::vector<Location> temp_parents(static_cast<size_t>(unvisited_locations.size()), first_location);
-    prim_parents.swap(temp_parents);
-    
-    // Initializing vector prim_distances
-    std::vector<double> temp_distances(unvisited_locations.size());
-    
-    // Filling vector with distance from each location to first location/first parent
-    for (size_t i = 0; i < unvisited_locations.size(); i++) {
-        
-        temp_distances[i] = get_distance(first_location, v_locations[unvisited_locations[i]]);
-        
     }
-    
-    prim_distances.swap(temp_distances);
-    
-    // Initializing vector prim_visited
-    std::vector<bool> temp_visited(unvisited_locations.size(), false);
-    
-    // setting first location to visited
-    temp_visited[first_location_index] = true;
-    
-    prim_visited.swap(temp_visited);
-    
-    return;
-    
-}
 
-void Drone::OPT_modified_prim_update(Location &next_location, size_t next_location_index, std::vector<size_t> &unvisited_locations) {
-    
-    // added to the tree
-    prim_visited[next_location_index] = true;
-    
-    for (size_t i = 0; i < unvisited_locations.size(); i++) {
-        
-        // same location as next location
-        if (i == next_location_index) {
-            
-            continue;
-            
+    const Coordinate *locations = (mapped.size() > 0) ? mapped.get_coords() : coordinates.data();
+    size_t num_locations = (mapped.size() > 0) ? mapped.size() : coordinates.size();
+
+    d1.set_reorder(options.reorder);
+
+    d1.set_or_opt(options.or_opt);
+
+    d1.set_mst_engine(options.mst_engine);
+
+    d1.set_mst_epsilon(options.mst_epsilon);
+
+    d1.set_precision(options.precision);
+
+    d1.set_tour_engine(options.tour_engine);
+
+    d1.set_clusters(options.clusters);
+
+    d1.set_improvement(options.improvement);
+
+    d1.set_time_limit(options.time_limit);
+
+    std::string variant = cache_variant(options);
+
+    try {
+
+        // Multi-drone routes (not cached)
+        if (options.drones > 0 && (options.mode == 'F' || options.mode == 'O')) {
+
+            FleetResult fleet;
+
+            fleet_tsp(locations, num_locations, options.drones, options.precision, fleet);
+
+            PHASE_TIMER("print");
+            FLEET_print(std::cout, fleet);
+
+            PHASE_REPORT();
+
+            return 0;
+
+        }
+
+        if (!options.warm_start_file.empty()) {
+
+            std::vector<Coordinate> previous_tour;
+
+            read_tour_file(options.warm_start_file, previous_tour);
+
+            d1.set_warm_start(previous_tour.data(), previous_tour.size());
+
+        }
+
+        // MST mode
+        if (options.mode == 'M') {
+
+            MSTResult result = solve_cached<MSTResult>(cache.get(), options.mode, variant, locations, num_locations, [&]() {
+
+                return d1.solve_mst(locations, num_locations);
+
+            });
+
+            if (options.online) {
+
+                run_online_MST(locations, num_locations, result);
+
+                PHASE_REPORT();
+
+                return 0;
+
+            }
+
+            if (approximate) {
+
+                double lower_bound = d1.get_mst_lower_bound();
+
+                std::cerr << std::fixed << std::setprecision(2) << "MST weight " << result.total_weight
+                << ", exact MST weight >= " << lower_bound << " (within "
+                << std::setprecision(3) << (lower_bound > 0 ? 100 * (result.total_weight / lower_bound - 1) : 0.0)
+                << "%)\n";
+
+            }
+
+            PHASE_TIMER("print");
+
+            if (options.weight_only) {
+
+                std::cout << result.total_weight << "\n";
+
+            }
+
+            else {
+
+                MST_print(std::cout, result);
+
+            }
+
+        }
+
+        else if (options.mode == 'F') {
+
+            TourResult result = solve_cached<TourResult>(cache.get(), options.mode, variant, locations, num_locations, [&]() {
+
+                return d1.solve_fast_tsp(locations, num_locations);
+
+            });
+
+            if (!options.save_tour_file.empty()) {
+
+                write_tour_file(options.save_tour_file, locations, result);
+
+            }
+
+            // Stages are only timed on a fresh solve (not a cache hit)
+            const ClusterStats &stats = d1.get_cluster_stats();
+
+            if (stats.num_clusters > 1) {
+
+                std::cerr << std::fixed << std::setprecision(2) << "Tour length " << result.total_distance
+                << " from " << stats.num_clusters << " clusters (partition " << std::setprecision(3)
+                << stats.partition_seconds << " s, sub-tours " << stats.subtour_seconds << " s, stitch "
+                << stats.stitch_seconds << " s)\n";
+
+            }
+
+            if (options.online) {
+
+                run_online_FASTTSP(locations, num_locations, result, options.repair);
+
+                PHASE_REPORT();
+
+                return 0;
+
+            }
+
+            PHASE_TIMER("print");
+            FAST_print(std::cout, result);
+
+        }
+
+        else {
+
+            TourResult result = solve_cached<TourResult>(cache.get(), options.mode, variant, locations, num_locations, [&]() {
+
+                return (options.mode == 'S') ? d1.solve_sfc_tsp(locations, num_locations)
+                : d1.solve_opt_tsp(locations, num_locations);
+
+            });
+
+            if (!options.save_tour_file.empty()) {
+
+                write_tour_file(options.save_tour_file, locations, result);
+
+            }
+
+            PHASE_TIMER("print");
+            OPT_print(std::cout, result);
+
+        }
+
+    }
+
+    catch (const DroneError &e) {
+
+        std::cerr << e.what() << "\n";
+
+        exit(1);
+
+    }
+
+    PHASE_REPORT();
+
+    return 0;
+
+}
+
+
+// ----------------------------------------------------------------------------
+//                    Options Definitions
+// ----------------------------------------------------------------------------
+
+void get_options(int argc, char** argv, Options &options) {
+
+    int option_index = 0, option = 0;
+
+    // Don't display getopt error messages about options
+    opterr = false;
+
+    // use getopt to find command line options
+    struct option longOpts[] = {{ "mode", required_argument, nullptr, 'm' },
+        { "help", no_argument, nullptr, 'h' },
+        { "batch", no_argument, nullptr, 'b' },
+        { "threads", required_argument, nullptr, 't' },
+        { "online", no_argument, nullptr, 'o' },
+        { "pipeline", no_argument, nullptr, 'P' },
+        { "repair", no_argument, nullptr, 'r' },
+        { "warm-start", required_argument, nullptr, 'w' },
+        { "save-tour", required_argument, nullptr, 's' },
+        { "reorder", no_argument, nullptr, 'R' },
+        { "or-opt", no_argument, nullptr, 'O' },
+        { "mst-engine", required_argument, nullptr, 'e' },
+        { "cache", required_argument, nullptr, 'c' },
+        { "cache-size", required_argument, nullptr, 'C' },
+        { "epsilon", required_argument, nullptr, 'E' },
+        { "weight-only", no_argument, nullptr, 'W' },
+        { "precision", required_argument, nullptr, 'p' },
+        { "clusters", required_argument, nullptr, 'k' },
+        { "tour-engine", required_argument, nullptr, 'T' },
+        { "drones", required_argument, nullptr, 'd' },
+        { "improve", required_argument, nullptr, 'I' },
+        { "time-limit", required_argument, nullptr, 'L' },
+        { "memory-limit", required_argument, nullptr, 'M' },
+        { nullptr, 0, nullptr, '\0' }};
+
+    while ((option = getopt_long(argc, argv, "m:hbt:oPrw:s:ROe:c:C:E:Wp:k:d:T:I:L:M:", longOpts, &option_index)) != -1) {
+        switch (option) {
+
+            case 'h':
+
+                std::cerr << "This program simulates an on-campus drone delivery service.\n"
+
+                << "There are two types of drones (Drone Type I and Drone Type II), and \n"
+                << "three types of clients (A, B, and C). The program will aim to find the\n"
+                << "shortest route distancewise to be able to service all locations across\n"
+                << "campus.\n"
+                << "Usage: \'./drone\n"
+                <<                      "\t[--help | -h]\n"
+                <<                      "\t[--mode | -m] <TYPE (either \"MST\", \"FASTTSP\", \"OPTTSP\", or \"SFCTSP\">\n"
+                <<                      "\t[--batch | -b] (stdin holds many instances, each with its own count)\n"
+                <<                      "\t[--threads | -t] <N (worker threads for --batch; default: one per core)>\n"
+                <<                      "\t[--online | -o] (MST/FASTTSP: after the locations, read commands from stdin:\n"
+                <<                      "\t                 \"add X Y\" prints the new location number,\n"
+                <<                      "\t                 \"remove N\", \"weight\" (MST) or \"length\" (FASTTSP), \"print\")\n"
+                <<                      "\t[--repair | -r] (FASTTSP --online: local 2-opt around every change)\n"
+                <<                      "\t[--pipeline | -P] (parse stdin on every core while it is read; ignored with\n"
+                <<                      "\t                   --batch and --online)\n"
+                <<                      "\t[--warm-start | -w] <FILE (FASTTSP/OPTTSP: start from a tour saved by --save-tour)>\n"
+                <<                      "\t[--save-tour | -s] <FILE (FASTTSP/OPTTSP: save the tour for a later --warm-start)>\n"
+                <<                      "\t[--mst-engine | -e] <ENGINE (MST: \"prim\" (default), \"zones\" (per-zone Prim in parallel)\n"
+                <<                      "\t                     \"boruvka\" (grid Borůvka on every core) or \"approx\"\n"
+                <<                      "\t                     (Borůvka within --epsilon; prints a certified bound to stderr))>\n"
+                <<                      "\t[--epsilon | -E] <EPS (MST approx: slack per edge; default: 0.01)>\n"
+                <<                      "\t[--weight-only | -W] (MST: print only the total weight)\n"
+                <<                      "\t[--memory-limit | -M] <MB (MST: stream the locations to spill files in $TMPDIR\n"
+                <<                      "\t                       (default /tmp) and compute the exact total weight in about\n"
+                <<                      "\t                       MB of memory; prints only the weight)>\n"
+                <<                      "\t[--precision | -p] <\"double\" (default) or \"float\" (32-bit coordinates and distances\n"
+                <<                      "\t                    in Prim, FASTTSP and OPTTSP; totals still exact, but OPTTSP\n"
+                <<                      "\t                    may print another equally short tour, e.g. reversed)>\n"
+                <<                      "\t[--tour-engine | -T] <ENGINE (FASTTSP: \"arbitrary\" (default, input order),\n"
+                <<                      "\t                      \"farthest\" or \"cheapest\" insertion, \"greedy\" edge)>\n"
+                <<                      "\t[--clusters | -k] <K (FASTTSP: solve K spatial clusters in parallel and stitch\n"
+                <<                      "\t                   their tours; prints stage timings to stderr)>\n"
+                <<                      "\t[--improve | -I] <LEVEL (FASTTSP tour / OPTTSP first incumbent: \"none\" (default),\n"
+                <<                      "\t                  \"local\" (LK-style local search) or \"kicks\" (then double-bridge\n"
+                <<                      "\t                  kicks until the time limit))>\n"
+                <<                      "\t[--time-limit | -L] <SECONDS (for --improve; default: 5)>\n"
+                <<                      "\t[--drones | -d] <K (FASTTSP/OPTTSP: K routes from location 0, one per drone,\n"
+                <<                      "\t                 solved in parallel; prints each route and the makespan)>\n"
+                <<                      "\t[--or-opt | -O] (SFCTSP: improve the curve tour with Or-opt moves)\n"
+                <<                      "\t[--reorder | -R] (solve on locations sorted along a Hilbert curve)\n"
+                <<                      "\t[--cache | -c] <DIR (reuse results of instances solved before)>\n"
+                <<                      "\t[--cache-size | -C] <MB (cap on the cache directory; default: 256)>\n";
+
+                exit(0);
+
+            case 'm':
+
+                if (strcmp(optarg, "MST") == 0) { // MST
+
+                    options.mode = 'M';
+
+                }
+
+                else if (strcmp(optarg, "FASTTSP") == 0) { // FASTTSP
+
+                    options.mode = 'F';
+
+                }
+
+                else if (strcmp(optarg, "OPTTSP") == 0) { // OPTTSP
+
+                    options.mode = 'O';
+
+                }
+
+                else if (strcmp(optarg, "SFCTSP") == 0) { // SFCTSP
+
+                    options.mode = 'S';
+
+                }
+
+                else { // Invalid command-line argument
+
+                    std::cerr << "Error: Invalid command line arguments. \"mode\" must be either: "
+                    << "\"MST\", \"FASTTSP\", \"OPTTSP\", or \"SFCTSP\". Program terminating\n";
+
+                }
+
+                break;
+
+            case 'b':
+
+                options.batch = true;
+
+                break;
+
+            case 'o':
+
+                options.online = true;
+
+                break;
+
+            case 'P':
+
+                options.pipeline = true;
+
+                break;
+
+            case 'r':
+
+                options.repair = true;
+
+                break;
+
+            case 'w':
+
+                options.warm_start_file = optarg;
+
+                break;
+
+            case 's':
+
+                options.save_tour_file = optarg;
+
+                break;
+
+            case 'e':
+
+                if (strcmp(optarg, "prim") == 0) {
+
+                    options.mst_engine = MSTEngine::Prim;
+
+                }
+
+                else if (strcmp(optarg, "zones") == 0) {
+
+                    options.mst_engine = MSTEngine::Zones;
+
+                }
+
+                else if (strcmp(optarg, "boruvka") == 0) {
+
+                    options.mst_engine = MSTEngine::Boruvka;
+
+                }
+
+                else if (strcmp(optarg, "approx") == 0) {
+
+                    options.mst_engine = MSTEngine::Approximate;
+
+                }
+
+                else {
+
+                    std::cerr << "Error: Invalid command line arguments. \"mst-engine\" must be either: "
+                    << "\"prim\", \"zones\", \"boruvka\", or \"approx\". Program terminating\n";
+
+                    exit(1);
+
+                }
+
+                break;
+
+            case 'O':
+
+                options.or_opt = true;
+
+                break;
+
+            case 'R':
+
+                options.reorder = true;
+
+                break;
+
+            case 'c':
+
+                options.cache_dir = optarg;
+
+                break;
+
+            case 'C':
+
+                options.cache_megabytes = parse_count_option("cache-size", optarg, UINT64_MAX >> 20);
+
+                break;
+
+            case 'E': {
+
+                char *end = nullptr;
+
+                options.mst_epsilon = std::strtod(optarg, &end);
+
+                if (end == optarg || *end != '\0' || !(options.mst_epsilon >= 0)) {
+
+                    std::cerr << "Error: Invalid command line arguments. \"epsilon\" must be a number >= 0. "
+                    << "Program terminating\n";
+
+                    exit(1);
+
+                }
+
+                break;
+
+            }
+
+            case 'W':
+
+                options.weight_only = true;
+
+                break;
+
+            case 'p':
+
+                if (strcmp(optarg, "double") == 0) {
+
+                    options.precision = Precision::Double;
+
+                }
+
+                else if (strcmp(optarg, "float") == 0) {
+
+                    options.precision = Precision::Float;
+
+                }
+
+                else {
+
+                    std::cerr << "Error: Invalid command line arguments. \"precision\" must be either: "
+                    << "\"double\" or \"float\". Program terminating\n";
+
+                    exit(1);
+
+                }
+
+                break;
+
+            case 'T':
+
+                if (strcmp(optarg, "arbitrary") == 0) {
+
+                    options.tour_engine = TourEngine::Arbitrary;
+
+                }
+
+                else if (strcmp(optarg, "farthest") == 0) {
+
+                    options.tour_engine = TourEngine::Farthest;
+
+                }
+
+                else if (strcmp(optarg, "cheapest") == 0) {
+
+                    options.tour_engine = TourEngine::Cheapest;
+
+                }
+
+                else if (strcmp(optarg, "greedy") == 0) {
+
+                    options.tour_engine = TourEngine::Greedy;
+
+                }
+
+                else {
+
+                    std::cerr << "Error: Invalid command line arguments. \"tour-engine\" must be either: "
+                    << "\"arbitrary\", \"farthest\", \"cheapest\", or \"greedy\". Program terminating\n";
+
+                    exit(1);
+
+                }
+
+                break;
+
+            case 'I':
+
+                if (strcmp(optarg, "none") == 0) {
+
+                    options.improvement = Improvement::None;
+
+                }
+
+                else if (strcmp(optarg, "local") == 0) {
+
+                    options.improvement = Improvement::Local;
+
+                }
+
+                else if (strcmp(optarg, "kicks") == 0) {
+
+                    options.improvement = Improvement::Kicks;
+
+                }
+
+                else {
+
+                    std::cerr << "Error: Invalid command line arguments. \"improve\" must be either: "
+                    << "\"none\", \"local\", or \"kicks\". Program terminating\n";
+
+                    exit(1);
+
+                }
+
+                break;
+
+            case 'L': {
+
+                char *end = nullptr;
+
+                options.time_limit = std::strtod(optarg, &end);
+
+                if (end == optarg || *end != '\0' || !(options.time_limit >= 0)) {
+
+                    std::cerr << "Error: Invalid command line arguments. \"time-limit\" must be a number >= 0. "
+                    << "Program terminating\n";
+
+                    exit(1);
+
+                }
+
+                break;
+
+            }
+
+            case 'M': {
+
+                char *end = nullptr;
+
+                options.memory_megabytes = std::strtod(optarg, &end);
+
+                if (end == optarg || *end != '\0' || !(options.memory_megabytes > 0)) {
+
+                    std::cerr << "Error: Invalid command line arguments. \"memory-limit\" must be a number > 0. "
+                    << "Program terminating\n";
+
+                    exit(1);
+
+                }
+
+                break;
+
+            }
+
+            case 'k':
+
+                options.clusters = static_cast<size_t>(parse_count_option("clusters", optarg, max_clusters));
+
+                break;
+
+            case 'd':
+
+                options.drones = static_cast<size_t>(parse_count_option("drones", optarg, max_drones));
+
+                break;
+
+            case 't':
+
+                options.num_threads = static_cast<size_t>(parse_count_option("threads", optarg, max_threads));
+
+                break;
+
+            default:
+
+                std::cerr << "Error: Invalid command line arguments. Program terminating\n";
+
+                exit(1);
+
+        }
+
+    }
+
+}
+
+uint64_t parse_count_option(const char *name, const char *text, uint64_t max_value) {
+
+    char *end = nullptr;
+
+    errno = 0;
+
+    // strtoull() would accept leading spaces and wrap a '-'
+    uint64_t value = (*text >= '0' && *text <= '9') ? std::strtoull(text, &end, 10) : 0;
+
+    if (end == nullptr || *end != '\0' || errno == ERANGE || value == 0 || value > max_value) {
+
+        throw DroneError(std::string("Error: Invalid command line arguments. \"") + name + "\" must be a whole number "
+                         + "from 1 to " + std::to_string(max_value) + ". Program terminating");
+
+    }
+
+    return value;
+
+}
+
+
+// ----------------------------------------------------------------------------
+//                    Tour File Definitions
+// ----------------------------------------------------------------------------
+
+void read_tour_file(const std::string &filename, std::vector<Coordinate> &tour) {
+
+    std::ifstream file(filename);
+
+    if (!file) {
+
+        throw DroneError("Error: Could not open tour file \"" + filename + "\". Program terminating");
+
+    }
+
+    read_input(file, tour);
+
+}
+
+void write_tour_file(const std::string &filename, const Coordinate *coordinates, const TourResult &result) {
+
+    std::ofstream file(filename);
+
+    if (!file) {
+
+        throw DroneError("Error: Could not write tour file \"" + filename + "\". Program terminating");
+
+    }
+
+    file << result.path.size() << "\n";
+
+    for (size_t location : result.path) {
+
+        file << coordinates[location].x << " " << coordinates[location].y << "\n";
+
+    }
+
+}
+
+
+// ----------------------------------------------------------------------------
+//                    Result Cache Definitions
+// ----------------------------------------------------------------------------
+
+template <typename Result, typename Solve>
+Result solve_cached(ResultCache *cache, char mode, const std::string &variant, const Coordinate *coordinates, size_t count,
+                    Solve solve) {
+
+    Result result;
+
+    if (cache != nullptr) {
+
+        PHASE_TIMER("cache_lookup");
+
+        if (cache->load(mode, variant, coordinates, count, result)) {
+
+            return result;
+
+        }
+
+    }
+
+    result = solve();
+
+    if (cache != nullptr) {
+
+        PHASE_TIMER("cache_store");
+
+        cache->store(mode, variant, coordinates, count, result);
+
+    }
+
+    return result;
+
+}
+
+std::string cache_variant(const Options &options) {
+
+    std::string variant;
+
+    // Reordering changes which of several equally good answers is found
+    if (options.reorder) {
+
+        variant += "reorder;";
+
+    }
+
+    if (options.or_opt) {
+
+        variant += "or-opt;";
+
+    }
+
+    // Float comparisons can settle near-ties differently
+    if (options.precision == Precision::Float) {
+
+        variant += "float;";
+
+    }
+
+    if (options.mode == 'F' && options.tour_engine != TourEngine::Arbitrary) {
+
+        variant += "tour-engine=" + std::to_string(static_cast<int>(options.tour_engine)) + ";";
+
+    }
+
+    // Kicks stop on the clock, so their tours also depend on the time limit
+    if ((options.mode == 'F' || options.mode == 'O') && options.improvement != Improvement::None) {
+
+        variant += "improve=" + std::to_string(static_cast<int>(options.improvement)) + ",time-limit=" +
+        std::to_string(options.time_limit) + ";";
+
+    }
+
+    // A clustered tour is a different (longer) tour
+    if (options.mode == 'F' && options.clusters > 1) {
+
+        variant += "clusters=" + std::to_string(options.clusters) + ";";
+
+    }
+
+    // Engines can break ties between equal edges differently
+    if (options.mode == 'M' && options.mst_engine != MSTEngine::Prim) {
+
+        variant += "engine=" + std::to_string(static_cast<int>(options.mst_engine)) + ";";
+
+    }
+
+    return variant;
+
+}
+
+
+// ----------------------------------------------------------------------------
+//                    Online Mode Definitions
+// ----------------------------------------------------------------------------
+
+void run_online_MST(const Coordinate *coordinates, size_t count, const MSTResult &initial) {
+
+    OnlineMST mst;
+
+    mst.seed(coordinates, count, initial);
+
+    run_online_commands(mst, "weight", [&]() {
+
+        if (mst.is_connected()) {
+
+            std::cout << mst.get_total_weight() << "\n";
+
+        }
+
+        else {
+
+            std::cout << "Cannot construct MST\n";
+
         }
-        
-        // Only looking at locations that are not part of the map
-        if (prim_visited[i] == false) {
-            
-            double temp_distance = get_distance(next_location, v_locations[unvisited_locations[i]]);
-            
-            // if (distance between this location and next location) is less than (distance to current parent)
-            if (temp_distance < prim_distances[i]) {
-                
-                // New parent, update distance
-                prim_parents[i] = next_location;
-                
-                prim_distances[i] = temp_distance;
-                
+
+    });
+
+}
+
+void run_online_FASTTSP(const Coordinate *coordinates, size_t count, const TourResult &initial, bool repair) {
+
+    OnlineTour tour;
+
+    tour.seed(coordinates, count, initial.path);
+
+    tour.set_repair(repair);
+
+    run_online_commands(tour, "length", [&]() {
+
+        std::cout << tour.get_total_distance() << "\n";
+
+    });
+
+}
+
+template <typename Service, typename PrintTotal>
+void run_online_commands(Service &service, const char *total_command, PrintTotal print_total) {
+
+    std::string command;
+
+    while (std::cin >> command) {
+
+        try {
+
+            if (command == "add") {
+
+                Coordinate c;
+
+                std::cin >> c.x >> c.y;
+
+                std::cout << service.add_location(c) << "\n";
+
+            }
+
+            else if (command == "remove") {
+
+                size_t location_num = 0;
+
+                std::cin >> location_num;
+
+                service.remove_location(location_num);
+
+            }
+
+            else if (command == total_command) {
+
+                print_total();
+
+            }
+
+            else if (command == "print") {
+
+                service.print(std::cout);
+
+            }
+
+            else {
+
+                std::cerr << "Error: Unknown command \"" << command << "\"\n";
+
+                // skip the rest of the line
+                std::getline(std::cin, command);
+
             }
-            
+
         }
-        
+
+        catch (const DroneError &e) {
+
+            std::cerr << e.what() << "\n";
+
+        }
+
+        // answers go out as soon as each command is handled
+        std::cout.flush();
+
     }
-    
+
 }
 
-void Drone::OPT_reset_prim() {
-    
-    prim_parents.clear();
-    
-    prim_distances.clear();
-    
-    prim_visited.clear();
-    
+
+// ----------------------------------------------------------------------------
+//                    BatchRunner Definitions
+// ----------------------------------------------------------------------------
+
+BatchRunner::BatchRunner(const Options &options, ResultCache *cache_in) {
+
+    mode = options.mode;
+
+    reorder = options.reorder;
+
+    or_opt = options.or_opt;
+
+    mst_engine = options.mst_engine;
+
+    mst_epsilon = options.mst_epsilon;
+
+    weight_only = options.weight_only;
+
+    precision = options.precision;
+
+    tour_engine = options.tour_engine;
+
+    clusters = options.clusters;
+
+    improvement = options.improvement;
+
+    time_limit = options.time_limit;
+
+    drones = options.drones;
+
+    cache = cache_in;
+
+    variant = cache_variant(options);
+
+    size_t num_threads = options.num_threads;
+
+    if (num_threads == 0) {
+
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    }
+
+    // Enough instances in flight to keep every worker busy
+    window_size = num_threads * 16;
+
+    instances.resize(window_size);
+    outputs.resize(window_size);
+    errors.resize(window_size);
+
+    generation = 0;
+    slots_in_window = 0;
+    slots_finished = 0;
+    next_claim = 0;
+    shutting_down = false;
+
+    for (size_t i = 0; i < num_threads; i++) {
+
+        workers.emplace_back(&BatchRunner::worker_loop, this);
+
+    }
+
 }
 
-void Drone::OPT_print() {
-    
-//    double closing_edge = get_distance(v_locations[OPT_best_path.front()], v_locations[OPT_best_path.back()]);
-//
-//    OPT_best_distance += closing_edge;
-    
-    std::cout << OPT_best_distance << "\n";
-    
-    for (size_t i = 0; i < OPT_best_path.size(); i++) {
-        
-        std::cout << OPT_best_path[i] << " ";
-        
+BatchRunner::~BatchRunner() {
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        shutting_down = true;
     }
-    
-//    // DEBUG
-//
-//    std::vector<size_t> debug;
-//
-//    for (size_t  i = 13; i < OPT_best_path.size(); i++) {
-//
-//        debug.push_back(OPT_best_path[i]);
-//
-//    }
-//
-//    OPT_modified_prim_algorithm(debug);
-//
-//    std::cout << MST_get_total_distance() << "\n";
-//
-//    for (size_t i = 0; i < debug.size(); i++) {
-//
-//        std::cout << v_locations[debug[i]].get_x_coord() << " " << v_locations[debug[i]].get_y_coord() << "\n";
-//
-//    }
-    
+
+    work_ready.notify_all();
+
+    for (std::thread &worker : workers) {
+
+        worker.join();
+
+    }
+
+}
+
+bool BatchRunner::run(std::istream &is, std::ostream &os) {
+
+    bool ok = true;
+
+    size_t instance_num = 0;
+
+    while (true) {
+
+        size_t count = 0;
+
+        {
+            PHASE_TIMER("read_input");
+
+            // Reads up to one window of instances; stops at end of input
+            while (count < window_size && (is >> std::ws) && !is.eof()) {
+
+                read_input(is, instances[count]);
+
+                count++;
+
+            }
+        }
+
+        if (count == 0) {
+
+            break;
+
+        }
+
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            slots_in_window = count;
+            slots_finished = 0;
+            generation++;
+            next_claim = static_cast<uint64_t>(generation & UINT32_MAX) << 32;
+
+            work_ready.notify_all();
+
+            work_done.wait(guard, [&]() { return slots_finished == slots_in_window; });
+        }
+
+        PHASE_TIMER("print");
+
+        for (size_t i = 0; i < count; i++, instance_num++) {
+
+            if (!errors[i].empty()) {
+
+                std::cerr << "Instance " << instance_num << ": " << errors[i] << "\n";
+
+                ok = false;
+
+                continue;
+
+            }
+
+            os << outputs[i];
+
+        }
+
+    }
+
+    return ok;
+
+}
+
+void BatchRunner::worker_loop() {
+
+    Drone drone;
+
+    drone.set_reorder(reorder);
+
+    drone.set_or_opt(or_opt);
+
+    drone.set_mst_engine(mst_engine);
+
+    drone.set_mst_epsilon(mst_epsilon);
+
+    drone.set_precision(precision);
+
+    drone.set_tour_engine(tour_engine);
+
+    drone.set_clusters(clusters);
+
+    drone.set_improvement(improvement);
+
+    drone.set_time_limit(time_limit);
+
+    size_t seen_generation = 0;
+
+    while (true) {
+
+        size_t window = 0;
+
+        {
+            std::unique_lock<std::mutex> guard(lock);
+
+            work_ready.wait(guard, [&]() { return shutting_down || generation != seen_generation; });
+
+            if (shutting_down) {
+
+                return;
+
+            }
+
+            seen_generation = generation;
+            window = slots_in_window;
+        }
+
+        size_t finished = 0;
+        size_t slot = 0;
+
+        while (claim_slot(seen_generation, window, slot)) {
+
+            solve_slot(drone, slot);
+
+            finished++;
+
+        }
+
+        std::lock_guard<std::mutex> guard(lock);
+
+        slots_finished += finished;
+
+        if (slots_finished == slots_in_window) {
+
+            work_done.notify_one();
+
+        }
+
+    }
+
+}
+
+bool BatchRunner::claim_slot(size_t claim_generation, size_t window, size_t &slot) {
+
+    uint64_t claim = next_claim.load();
+
+    while ((claim >> 32) == (claim_generation & UINT32_MAX) && (claim & UINT32_MAX) < window) {
+
+        // On failure claim is reloaded and both tests run again
+        if (next_claim.compare_exchange_weak(claim, claim + 1)) {
+
+            slot = static_cast<size_t>(claim & UINT32_MAX);
+
+            return true;
+
+        }
+
+    }
+
+    return false;
+
+}
+
+void BatchRunner::solve_slot(Drone &drone, size_t slot) {
+
+    std::vector<Coordinate> &coordinates = instances[slot];
+
+    std::ostringstream out;
+    out << std::setprecision(2) << std::fixed;
+
+    errors[slot].clear();
+
+    try {
+
+        if (drones > 0 && (mode == 'F' || mode == 'O')) {
+
+            FleetResult fleet;
+
+            // Instances already run in parallel
+            fleet_tsp(coordinates.data(), coordinates.size(), drones, precision, fleet, 1);
+
+            FLEET_print(out, fleet);
+
+        }
+
+        else if (mode == 'M') {
+
+            MSTResult result = solve_cached<MSTResult>(cache, mode, variant, coordinates.data(), coordinates.size(), [&]() {
+
+                return drone.solve_mst(coordinates.data(), coordinates.size());
+
+            });
+
+            if (weight_only) {
+
+                out << result.total_weight << "\n";
+
+            }
+
+            else {
+
+                MST_print(out, result);
+
+            }
+
+        }
+
+        else if (mode == 'F') {
+
+            FAST_print(out, solve_cached<TourResult>(cache, mode, variant, coordinates.data(), coordinates.size(), [&]() {
+
+                return drone.solve_fast_tsp(coordinates.data(), coordinates.size());
+
+            }));
+
+            out << "\n";
+
+        }
+
+        else {
+
+            OPT_print(out, solve_cached<TourResult>(cache, mode, variant, coordinates.data(), coordinates.size(), [&]() {
+
+                return (mode == 'S') ? drone.solve_sfc_tsp(coordinates.data(), coordinates.size())
+                : drone.solve_opt_tsp(coordinates.data(), coordinates.size());
+
+            }));
+
+            out << "\n";
+
+        }
+
+    }
+
+    catch (const DroneError &e) {
+
+        errors[slot] = e.what();
+
+    }
+
+    outputs[slot] = out.str();
+
 }
@@ -0,0 +1,547 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  drone.hpp
+//  project4
+//
+//  Solver library. Everything the drone executable does is available here
+//  without going through std::cin/std::cout:
+//
+//      std::vector<Coordinate> coords = {{0, 0}, {3, 4}, {-2, 5}};
+//
+//      MSTResult mst = solve_mst(coords);
+//      TourResult tour = solve_fast_tsp(coords);
+//
+//  Errors (e.g. an MST that cannot be built because Medical and Normal
+//  locations are not joined by a Border location) are reported by throwing
+//  DroneError; nothing in the library calls exit().
+//
+//  A Drone object keeps its internal vectors between calls, so solving many
+//  instances with the same Drone reuses those buffers. The free functions
+//  solve_mst(), solve_fast_tsp() and solve_opt_tsp() use one Drone per thread.
+//
+//  Building the library on its own: every .cpp except drone.cpp (the command
+//  line front end) belongs to it.
+//
+//      g++ -std=c++17 -O3 -c $(ls *.cpp | grep -v '^drone.cpp$')
+//      ar rcs libdrone.a *.o
+//
+
+#ifndef DRONE_HPP
+#define DRONE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+// ----------------------------------------------------------------------------
+//                    LocationType Declarations (Enumerated Class)
+// ----------------------------------------------------------------------------
+
+enum class LocationType { Medical, Border, Normal, Empty};
+
+// ----------------------------------------------------------------------------
+//                    Location Declarations
+// ----------------------------------------------------------------------------
+
+class Location {
+
+public:
+
+    Location();
+
+    Location(int x_coord_in, int y_coord_in, int location_num_in, char mode_in);
+
+    int get_x_coord();
+    int get_y_coord();
+    LocationType get_location_type();
+    int get_location_num();
+
+private:
+
+    int x_coord;
+    int y_coord;
+
+    // Location 0, 1, 2, 3, ect...
+    int location_num;
+
+    // Medical: if x and y are both negative
+    // ex: (x = (-), y = (-))
+    // Border: if one is negative and other is 0, OR (0,0)
+    // ex: (x = 0, y = (-)) OR (y = 0, x = (-)) OR (x = 0, y = 0)
+
+    LocationType location_type;
+
+};
+
+// ----------------------------------------------------------------------------
+//                    Library Types
+// ----------------------------------------------------------------------------
+
+struct Coordinate {
+
+    int x;
+    int y;
+
+};
+
+struct MSTResult {
+
+    double total_weight = 0;
+
+    // parents[i] is the location joined to location i in the tree
+    // Location 0 is the root (parents[0] == 0)
+    std::vector<size_t> parents;
+
+};
+
+struct TourResult {
+
+    double total_distance = 0;
+
+    // Visiting order, starting at location 0 (closing edge back to 0 implied)
+    std::vector<size_t> path;
+
+};
+
+// How solve_mst() builds the tree (see mst_engines.hpp)
+enum class MSTEngine { Prim, Zones, Boruvka, Approximate };
+
+// How solve_fast_tsp() builds the tour (see insertion_engines.hpp and
+// greedy_tour.hpp)
+enum class TourEngine { Arbitrary, Farthest, Cheapest, Greedy };
+
+// What runs on the finished FASTTSP tour and the OPTTSP incumbent (see
+// lk_search.hpp): nothing, LK-style local search, or local search and then
+// kicks until the time limit
+enum class Improvement { None, Local, Kicks };
+
+// Width of the coordinates and working distances in Prim, FASTTSP and
+// OPTTSP (see Drone::set_precision())
+enum class Precision { Double, Float };
+
+// Stages of a clustered FASTTSP (see Drone::set_clusters())
+struct ClusterStats {
+
+    size_t num_clusters = 0;
+
+    double partition_seconds = 0;
+    double subtour_seconds = 0;
+    double stitch_seconds = 0;
+
+};
+
+class DroneError : public std::runtime_error {
+
+public:
+
+    explicit DroneError(const std::string &message) : std::runtime_error(message) {}
+
+};
+
+// ----------------------------------------------------------------------------
+//                    Drone Declarations
+// ----------------------------------------------------------------------------
+
+class Drone {
+
+public:
+
+//    struct Node {
+//
+//        int location_index;
+//        Node* prev;
+//        Node* next;
+//
+//    };
+
+    Drone();
+
+    // Each solve_* call loads the given locations and solves them, reusing
+    // the vectors from previous calls. The returned reference stays valid
+    // until the next call on this Drone.
+    const MSTResult &solve_mst(const Coordinate *coords, size_t count);
+
+    const TourResult &solve_fast_tsp(const Coordinate *coords, size_t count);
+
+    const TourResult &solve_opt_tsp(const Coordinate *coords, size_t count);
+
+    // One-pass tour along a Hilbert curve, for inputs too big for FASTTSP.
+    // Medical and Normal locations are joined through two Border locations
+    // (MST distance rules). Throws if Medical and Normal locations exist with
+    // fewer than 2 Border locations.
+    const TourResult &solve_sfc_tsp(const Coordinate *coords, size_t count);
+
+    // MST engine for solve_mst() (MSTEngine::Prim by default)
+    void set_mst_engine(MSTEngine engine_in);
+
+    // MSTEngine::Approximate: allowed slack per Borůvka edge (0.01 by default)
+    void set_mst_epsilon(double epsilon_in);
+
+    // Certified lower bound on the exact MST weight from the last
+    // solve_mst() (the total itself for the exact engines)
+    double get_mst_lower_bound();
+
+    // FASTTSP construction (TourEngine::Arbitrary by default: locations
+    // inserted in input order). Warm starts and clusters build with
+    // arbitrary insertion.
+    void set_tour_engine(TourEngine engine_in);
+
+    // FASTTSP: solve in num_clusters spatial clusters in parallel and
+    // stitch their tours (see cluster_tour.hpp); 0 or 1 solves in one piece.
+    // Warm starts still build one tour.
+    void set_clusters(size_t num_clusters_in);
+
+    // Stage timings of the last clustered solve_fast_tsp()
+    const ClusterStats &get_cluster_stats();
+
+    // Improve the FASTTSP tour (any construction) and OPTTSP's first
+    // incumbent (Improvement::None by default)
+    void set_improvement(Improvement improvement_in);
+
+    // Seconds the improvement may take (5 by default)
+    void set_time_limit(double time_limit_in);
+
+    // SFCTSP: follow the curve tour with Or-opt passes (moving runs of 1 - 3
+    // locations to a nearby edge of the tour)
+    void set_or_opt(bool or_opt_in);
+
+    // Tour from a previous run (locations in visiting order). FASTTSP then
+    // starts from it instead of from scratch and OPTTSP uses it as its first
+    // incumbent. Locations are matched by coordinates; an empty tour turns
+    // warm starts off.
+    void set_warm_start(const Coordinate *previous_tour, size_t count);
+
+    // Solve on the locations sorted along a Hilbert curve (neighbors in the
+    // plane become neighbors in memory). Results are mapped back to the
+    // input's location numbers, MST rooted at 0 and tours starting at 0.
+    void set_reorder(bool reorder_in);
+
+    // hilbert_index() of every location, computed while reading
+    // (read_input_pipelined()); --reorder and SFCTSP then sort by these
+    // instead of computing their own. Used by solves of count locations
+    // only; keys must outlive them (nullptr turns this off).
+    void set_hilbert_keys(const uint64_t *keys, size_t count);
+
+    // Precision::Float runs Prim, FASTTSP insertion and OPTTSP edge lookups
+    // on 32-bit coordinates and distances, halving their memory traffic.
+    // Comparisons too close for float are settled exactly and totals are
+    // summed in double, so trees, FASTTSP tours and printed totals match
+    // double mode (checked by bench/bench_precision.cpp). OPTTSP finds a
+    // tour of the same length, but among equally short tours (often the
+    // optimal tour and its reverse) it may print a different one: double
+    // mode settles those by rounding in its running sum. Inputs with
+    // coordinates beyond +-2^23 run in double.
+    void set_precision(Precision precision_in);
+
+    char get_mode();
+
+    double get_distance(Location &l1, Location &l2);
+
+    // Squared distance key (squared_offset() in spatial.hpp: exact below
+    // 2^62, and ordered for any int coordinates), or unreachable_distance
+    // between Medical and Normal locations. All comparisons use this; sqrt
+    // is only taken for reported lengths.
+    int64_t get_squared_distance(Location &l1, Location &l2);
+
+    static constexpr int64_t unreachable_distance = INT64_MAX;
+
+private:
+
+    void load_locations(const Coordinate *coords, size_t count, char mode_in);
+
+    // order = locations along the Hilbert curve, from the given keys when
+    // there are count of them
+    void curve_order(const Coordinate *coords, size_t count, std::vector<size_t> &order);
+
+    // Returns coords, or the Hilbert-sorted copy when reordering
+    const Coordinate *reorder_locations(const Coordinate *coords, size_t count);
+
+    // Maps mst_result / tour_result back to input location numbers
+    void reorder_restore_mst();
+
+    void reorder_restore_tour();
+
+    // The Distance templates below are instantiated in drone_solver.cpp
+    // with the policies of distance_policy.hpp
+
+    // PART A: MST //
+
+    void run_MST();
+
+    template <typename Distance>
+    void prim_algorithm(const Distance &distance);
+
+    template <typename Distance>
+    void prim_initialize_vectors(const Distance &distance, size_t first_location_index);
+
+    template <typename Distance>
+    void prim_algorithm_update(const Distance &distance, size_t next_location_index);
+
+    size_t find_closest_location();
+
+    double MST_get_total_distance();
+
+    // PART B: FASTTSP //
+
+    void run_FASTTSP();
+
+    // Fills FAST_path (with the closing 0 at the back), warm or cold
+    template <typename Distance>
+    void FAST_build_tour(const Distance &distance, double &total_distance);
+
+    bool FAST_warm_start(double &total_distance);
+
+    template <typename Distance>
+    void FAST_initialize_vectors(const Distance &distance, size_t first_index, size_t second_index, size_t third_index,
+                                 double &total_distance);
+
+    void FAST_initialize_distance_vector();
+
+    template <typename Distance>
+    void FAST_arbitrary_insert_algorithm(const Distance &distance, double &total_distance);
+
+    // The k-th location to insert: input order, even when reordered, so the
+    // tour matches the one built without reordering
+    size_t FAST_insertion_location(size_t k);
+
+    template <typename Distance>
+    double FAST_distance_change(const Distance &distance, size_t first_index, size_t second_index, size_t new_index);
+
+    // PART C: OPTTSP //
+
+    void run_OPTTSP();
+
+    // Fills OPT_squares and OPT_lengths
+    void OPT_fill_matrix();
+
+    template <typename Distance>
+    void genPerms(const Distance &distance, size_t permLength);
+
+    template <typename Distance>
+    bool is_promising(const Distance &distance, size_t permLength);
+
+    template <typename Distance>
+    void OPT_initialize(const Distance &distance);
+
+    template <typename Distance>
+    void OPT_FASTTSP_helper(const Distance &distance);
+
+    template <typename Distance>
+    void OPT_modified_prim_update(const Distance &distance, size_t next_location_index, std::vector<size_t> &unvisited_locations);
+
+    template <typename Distance>
+    void OPT_modified_prim_initialize_vectors(const Distance &distance, size_t first_location_index,
+                                              std::vector<size_t> &unvisited_locations);
+
+    template <typename Distance>
+    void OPT_modified_prim_algorithm(const Distance &distance, std::vector<size_t> &unvisited_locations);
+
+    void OPT_reset_prim();
+
+    // PART D: SFCTSP //
+
+    void run_SFCTSP(const Coordinate *coords);
+
+    // Fills SFC_path with the curve order, patched at zone changes
+    void SFC_build_path();
+
+    // One pass over the tour; returns true if anything moved
+    bool SFC_or_opt_pass();
+
+    double SFC_distance(size_t l1, size_t l2);
+
+    bool SFC_compatible(size_t l1, size_t l2);
+
+    // PART E: Precision::Float //
+
+    // Fills compact_coords (and compact_zones for MST) from v_locations;
+    // false if a coordinate doesn't fit
+    bool compact_load();
+
+    // Prim on compact_coords; fills mst_result
+    void compact_prim_algorithm();
+
+    // FASTTSP: FAST_path index after which to insert location
+    template <typename Distance>
+    size_t compact_insert_position(const Distance &distance, size_t location);
+
+    float compact_distance(size_t l1, size_t l2);
+
+    double OPT_exact_length();
+
+    // 'N' by default; must be 'M' for MST, 'F' for FASTTSP, 'O' for OPTTSP or
+    // 'S' for SFCTSP
+    char mode;
+
+    int num_locations;
+
+    // For all vectors:
+    // Index of locations corresponds to location num
+    // ex: Index 0 stores Location 0
+    std::vector<Location> v_locations;
+
+    bool reorder;
+
+    // reorder_order[i] = input location number of solver location i
+    std::vector<size_t> reorder_order;
+
+    // reorder_rank[input location number] = solver location
+    std::vector<size_t> reorder_rank;
+
+    std::vector<Coordinate> reorder_coords;
+
+    std::vector<size_t> reorder_scratch;
+
+    // set_hilbert_keys()
+    const uint64_t *given_keys;
+
+    size_t given_keys_count;
+
+    // ----------------------------------------------------------------------------
+    //                    PART A
+    // ----------------------------------------------------------------------------
+
+    MSTEngine mst_engine;
+
+    double mst_epsilon;
+
+    double mst_lower_bound;
+
+    // Parent location
+    std::vector<Location> prim_parents;
+
+    // Squared distance from parent
+    std::vector<int64_t> prim_distances;
+
+    // if visited or not
+    std::vector<bool> prim_visited;
+
+    MSTResult mst_result;
+
+    // ----------------------------------------------------------------------------
+    //                    PART B
+    // ----------------------------------------------------------------------------
+
+    std::vector<size_t> FAST_path;
+
+    TourResult tour_result;
+
+    // Previous tour for warm starts (empty: start cold)
+    std::vector<Coordinate> warm_tour;
+
+    TourEngine tour_engine;
+
+    size_t FAST_clusters;
+
+    ClusterStats cluster_stats;
+
+    Improvement improvement;
+
+    double time_limit;
+
+    // ----------------------------------------------------------------------------
+    //                    PART C
+    // ----------------------------------------------------------------------------
+
+
+    std::vector<size_t> OPT_path;
+
+    std::vector<size_t> OPT_best_path;
+
+    // Locations left to place at the current genPerms() depth
+    std::vector<size_t> OPT_unvisited;
+
+    double OPT_best_distance;
+
+    double OPT_current_distance;
+
+    // Room for float rounding in comparisons with OPT_best_distance
+    double OPT_slack;
+
+    // num_locations x num_locations squared distances and lengths
+    // (MatrixDistance), up to matrix_max_locations
+    std::vector<int64_t> OPT_squares;
+
+    std::vector<double> OPT_lengths;
+
+    //std::vector<bool> OPT_visited;
+
+    // ----------------------------------------------------------------------------
+    //                    PART D
+    // ----------------------------------------------------------------------------
+
+    // Input of the current solve_sfc_tsp() call
+    const Coordinate *SFC_coords;
+
+    std::vector<LocationType> SFC_zones;
+
+    std::vector<size_t> SFC_order;
+
+    std::vector<size_t> SFC_path;
+
+    bool SFC_or_opt;
+
+    // ----------------------------------------------------------------------------
+    //                    PART E
+    // ----------------------------------------------------------------------------
+
+    struct CompactLocation {
+
+        float x;
+        float y;
+
+    };
+
+    Precision precision;
+
+    // Precision::Float and the coordinates fit (within +-2^23)
+    bool compact_active;
+
+    std::vector<CompactLocation> compact_coords;
+
+    // LocationType of each location (MST only)
+    std::vector<uint8_t> compact_zones;
+
+    // Prim: squared distance to the tree (-1 once in it)
+    // FASTTSP: lower bound of each edge's insertion cost
+    // OPTTSP: num_locations x num_locations edge lengths
+    std::vector<float> compact_distances;
+
+    std::vector<uint32_t> compact_parents;
+
+};
+
+// ----------------------------------------------------------------------------
+//                    Library Functions
+// ----------------------------------------------------------------------------
+
+// One-shot solvers; each thread reuses its own Drone between calls
+MSTResult solve_mst(const Coordinate *coords, size_t count);
+MSTResult solve_mst(const std::vector<Coordinate> &coords);
+
+TourResult solve_fast_tsp(const Coordinate *coords, size_t count);
+TourResult solve_fast_tsp(const std::vector<Coordinate> &coords);
+
+TourResult solve_opt_tsp(const Coordinate *coords, size_t count);
+TourResult solve_opt_tsp(const std::vector<Coordinate> &coords);
+
+TourResult solve_sfc_tsp(const Coordinate *coords, size_t count);
+TourResult solve_sfc_tsp(const std::vector<Coordinate> &coords);
+
+// Reads "<count>\n<x> <y>\n..." (the drone input format), or a binary file
+// (binary_input.hpp, told apart by its magic number), into coords
+void read_input(std::istream &is, std::vector<Coordinate> &coords);
+
+// Output formats of the drone executable
+void MST_print(std::ostream &os, const MSTResult &result);
+
+void FAST_print(std::ostream &os, const TourResult &result);
+
+void OPT_print(std::ostream &os, const TourResult &result);
+
+#endif /* DRONE_HPP */
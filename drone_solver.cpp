@@ -0,0 +1,2300 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  drone_solver.cpp
+//  project4
+//
+//  Created by Kyle Sun on 4/5/20.
+//  Copyright © 2020 Kyle Sun. All rights reserved.
+//
+
+#include "drone.hpp"
+#include "binary_input.hpp"
+#include "cluster_tour.hpp"
+#include "distance_policy.hpp"
+#include "greedy_tour.hpp"
+#include "insertion_engines.hpp"
+#include "lk_search.hpp"
+#include "mst_engines.hpp"
+#include "online_tour.hpp"
+#include "phase_timer.hpp"
+#include "spatial.hpp"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <iomanip>
+
+
+//// ----------------------------------------------------------------------------
+////                    Optimal Declarations
+//// ----------------------------------------------------------------------------
+//
+//class Optimal {
+//
+//public:
+//
+//    template <typename T>
+//    void genPerms(size_t permLength) {
+//        if (permLength == path.size()) {
+//
+//            // add closing edge
+//            // check/update best distance/path
+//            // subtract closing edge
+//
+//
+//            return;
+//        } // if
+//        if (!promising(path, permLength))
+//            return;
+//        for (size_t i = permLength; i < path.size(); ++i) {
+//            swap(path[permLength], path[i]);
+//            genPerms(path, permLength + 1);
+//            swap(path[permLength], path[i]);
+//        } // for
+//    } // genPerms()
+//
+//
+//private:
+//
+//    std::vector<size_t> &OPT_path;
+//
+//    std::vector<size_t> &OPT_best_path;
+//
+//    double OPT_running_total;
+//
+//    double OPT_best_distance;
+//
+//
+//};
+
+
+// ----------------------------------------------------------------------------
+//                    Location Definitions
+// ----------------------------------------------------------------------------
+
+Location::Location() {
+    
+    // Default values; only appear if uninitialized
+    location_type = LocationType::Empty;
+    
+    location_num = -1;
+    
+    x_coord = 0;
+    y_coord = 0;
+    
+}
+
+Location::Location(int x_coord_in, int y_coord_in, int location_num_in, char mode_in) {
+    
+    location_num = location_num_in;
+    
+    x_coord = x_coord_in;
+    y_coord = y_coord_in;
+    
+    // FASTTSP/OPTTSP don't use zones
+    location_type = LocationType::Empty;
+    
+    // Medical: if x and y are both negative
+    // ex: (x = (-), y = (-))
+    // Border: if one is negative and other is 0, OR (0,0)
+    // ex: (x = 0, y = (-)) OR (y = 0, x = (-)) OR (x = 0, y = 0)
+    
+    if (mode_in == 'M') { // need LocationType
+        
+        if (x_coord < 0 && y_coord < 0) {
+            
+            location_type = LocationType::Medical;
+            
+        }
+        
+        else if ((x_coord < 0 && y_coord == 0) ||
+                 (y_coord < 0 && x_coord == 0) ||
+                 (x_coord == 0 && y_coord == 0)) {
+            
+            location_type = LocationType::Border;
+            
+        }
+        
+        else {
+            
+            location_type = LocationType::Normal;
+            
+        }
+        
+    }
+    
+}
+
+int Location::get_x_coord() {
+    
+    return x_coord;
+    
+}
+
+int Location::get_y_coord() {
+    
+    return y_coord;
+    
+}
+
+LocationType Location::get_location_type() {
+    
+    return location_type;
+    
+}
+
+int Location::get_location_num() {
+    
+    return location_num;
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    Drone Definitions
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// Precision::Float (PART E). Below 2^23 in magnitude every coordinate
+// difference is exact in float, so a float (squared) distance is within a
+// few ulps of the exact one; comparisons closer than compact_tolerance
+// (relative) are settled exactly.
+const int compact_max_coordinate = 1 << 23;
+
+const float compact_tolerance = 1.0f / (1 << 20);
+
+}
+
+// Default constructor
+Drone::Drone() {
+    
+    mode = 'N';
+    
+    reorder = false;
+    
+    given_keys = nullptr;
+    
+    given_keys_count = 0;
+    
+    mst_engine = MSTEngine::Prim;
+    
+    mst_epsilon = 0.01;
+    
+    mst_lower_bound = 0;
+    
+    tour_engine = TourEngine::Arbitrary;
+    
+    FAST_clusters = 0;
+    
+    improvement = Improvement::None;
+    
+    time_limit = 5;
+    
+    SFC_coords = nullptr;
+    
+    SFC_or_opt = false;
+    
+    precision = Precision::Double;
+    
+    compact_active = false;
+    
+    OPT_slack = 0;
+    
+}
+
+char Drone::get_mode() {
+    
+    return mode;
+    
+}
+
+// Shared by every solve_* call: reuses v_locations' storage between calls
+void Drone::load_locations(const Coordinate *coords, size_t count, char mode_in) {
+    
+    mode = mode_in;
+    
+    num_locations = static_cast<int>(count);
+    
+    v_locations.clear();
+    v_locations.reserve(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        v_locations.emplace_back(coords[i].x, coords[i].y, static_cast<int>(i), mode);
+        
+    }
+    
+    // Out-of-range coordinates run in double
+    compact_active = (precision == Precision::Float) && compact_load();
+    
+}
+
+const MSTResult &Drone::solve_mst(const Coordinate *coords, size_t count) {
+    
+    const Coordinate *locations = reorder_locations(coords, count);
+    
+    if (mst_engine == MSTEngine::Prim) {
+        
+        load_locations(locations, count, 'M');
+        
+        run_MST();
+        
+    }
+    
+    else {
+        
+        // The other engines work on the coordinates directly
+        mode = 'M';
+        
+        num_locations = static_cast<int>(count);
+        
+        if (mst_engine == MSTEngine::Zones) {
+            
+            zone_prim_mst(locations, count, mst_result);
+            
+        }
+        
+        else if (mst_engine == MSTEngine::Boruvka) {
+            
+            boruvka_mst(locations, count, mst_result);
+            
+        }
+        
+        else {
+            
+            approximate_mst(locations, count, mst_epsilon, mst_result, mst_lower_bound);
+            
+        }
+        
+    }
+    
+    // The exact engines prove their own optimality
+    if (mst_engine != MSTEngine::Approximate) {
+        
+        mst_lower_bound = mst_result.total_weight;
+        
+    }
+    
+    reorder_restore_mst();
+    
+    return mst_result;
+    
+}
+
+const TourResult &Drone::solve_fast_tsp(const Coordinate *coords, size_t count) {
+    
+    // Clusters are spatial already, so reordering is skipped
+    if (FAST_clusters > 1 && warm_tour.empty()) {
+        
+        mode = 'F';
+        
+        num_locations = static_cast<int>(count);
+        
+        cluster_tsp(coords, count, FAST_clusters, precision, tour_result, cluster_stats);
+        
+    }
+    
+    // The other engines work on the coordinates directly
+    else if (tour_engine != TourEngine::Arbitrary && warm_tour.empty()) {
+        
+        mode = 'F';
+        
+        num_locations = static_cast<int>(count);
+        
+        if (tour_engine == TourEngine::Farthest) {
+            
+            farthest_insertion_tour(coords, count, tour_result);
+            
+        }
+        
+        else if (tour_engine == TourEngine::Cheapest) {
+            
+            cheapest_insertion_tour(coords, count, tour_result);
+            
+        }
+        
+        // FASTTSP locations have no zones
+        else {
+            
+            greedy_edge_tour(coords, count, false, tour_result);
+            
+        }
+        
+    }
+    
+    else {
+        
+        load_locations(reorder_locations(coords, count), count, 'F');
+        
+        run_FASTTSP();
+        
+        reorder_restore_tour();
+        
+    }
+    
+    improve_tour(coords, count, improvement, time_limit, tour_result);
+    
+    return tour_result;
+    
+}
+
+const TourResult &Drone::solve_opt_tsp(const Coordinate *coords, size_t count) {
+    
+    load_locations(reorder_locations(coords, count), count, 'O');
+    
+    run_OPTTSP();
+    
+    reorder_restore_tour();
+    
+    return tour_result;
+    
+}
+
+const TourResult &Drone::solve_sfc_tsp(const Coordinate *coords, size_t count) {
+    
+    // Works on the coordinates directly; no Location objects
+    mode = 'S';
+    
+    num_locations = static_cast<int>(count);
+    
+    run_SFCTSP(coords);
+    
+    return tour_result;
+    
+}
+
+void Drone::set_mst_engine(MSTEngine engine_in) {
+    
+    mst_engine = engine_in;
+    
+}
+
+void Drone::set_mst_epsilon(double epsilon_in) {
+    
+    mst_epsilon = epsilon_in;
+    
+}
+
+double Drone::get_mst_lower_bound() {
+    
+    return mst_lower_bound;
+    
+}
+
+void Drone::set_tour_engine(TourEngine engine_in) {
+    
+    tour_engine = engine_in;
+    
+}
+
+void Drone::set_clusters(size_t num_clusters_in) {
+    
+    FAST_clusters = num_clusters_in;
+    
+}
+
+const ClusterStats &Drone::get_cluster_stats() {
+    
+    return cluster_stats;
+    
+}
+
+void Drone::set_improvement(Improvement improvement_in) {
+    
+    improvement = improvement_in;
+    
+}
+
+void Drone::set_time_limit(double time_limit_in) {
+    
+    time_limit = time_limit_in;
+    
+}
+
+void Drone::set_or_opt(bool or_opt_in) {
+    
+    SFC_or_opt = or_opt_in;
+    
+}
+
+void Drone::set_precision(Precision precision_in) {
+    
+    precision = precision_in;
+    
+}
+
+void Drone::set_reorder(bool reorder_in) {
+    
+    reorder = reorder_in;
+    
+}
+
+void Drone::set_hilbert_keys(const uint64_t *keys, size_t count) {
+    
+    given_keys = keys;
+    given_keys_count = count;
+    
+}
+
+void Drone::curve_order(const Coordinate *coords, size_t count, std::vector<size_t> &order) {
+    
+    if (given_keys != nullptr && given_keys_count == count) {
+        
+        hilbert_order(given_keys, count, order);
+        
+    }
+    
+    else {
+        
+        hilbert_order(coords, count, order);
+        
+    }
+    
+}
+
+const Coordinate *Drone::reorder_locations(const Coordinate *coords, size_t count) {
+    
+    if (!reorder) {
+        
+        return coords;
+        
+    }
+    
+    PHASE_TIMER("hilbert_reorder");
+    
+    curve_order(coords, count, reorder_order);
+    
+    reorder_coords.resize(count);
+    reorder_rank.resize(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        reorder_coords[i] = coords[reorder_order[i]];
+        reorder_rank[reorder_order[i]] = i;
+        
+    }
+    
+    return reorder_coords.data();
+    
+}
+
+void Drone::reorder_restore_mst() {
+    
+    if (!reorder || mst_result.parents.empty()) {
+        
+        return;
+        
+    }
+    
+    std::vector<size_t> &parents = reorder_scratch;
+    
+    parents.resize(mst_result.parents.size());
+    
+    for (size_t i = 0; i < parents.size(); i++) {
+        
+        parents[reorder_order[i]] = reorder_order[mst_result.parents[i]];
+        
+    }
+    
+    // The tree is rooted at input location reorder_order[0]; reverse the
+    // parent links on the path from 0 up to that root
+    size_t child = 0;
+    size_t location = parents[0];
+    
+    parents[0] = 0;
+    
+    while (location != child) {
+        
+        size_t next = parents[location];
+        
+        parents[location] = child;
+        
+        child = location;
+        location = next;
+        
+    }
+    
+    mst_result.parents.swap(parents);
+    
+}
+
+void Drone::reorder_restore_tour() {
+    
+    if (!reorder) {
+        
+        return;
+        
+    }
+    
+    std::vector<size_t> &path = tour_result.path;
+    
+    size_t start = 0;
+    
+    for (size_t i = 0; i < path.size(); i++) {
+        
+        path[i] = reorder_order[path[i]];
+        
+        if (path[i] == 0) {
+            
+            start = i;
+            
+        }
+        
+    }
+    
+    std::rotate(path.begin(), path.begin() + static_cast<std::ptrdiff_t>(start), path.end());
+    
+}
+
+double Drone::get_distance(Location &l1, Location &l2) {
+    
+    int64_t squared = get_squared_distance(l1, l2);
+    
+    // Unreachable (one is normal and one is medical); return infinity
+    if (squared == unreachable_distance) {
+        
+        return std::numeric_limits<double>::infinity();
+        
+    }
+    
+    //               ____________________________
+    // Formula:     /          2              2
+    //             /  (X2 - X1)   +  (Y2 - Y1)
+    //           \/
+    
+    // Below exact_squared_limit, one correctly rounded sqrt of an exact
+    // integer: the same double on every machine
+    return squared_length(squared);
+    
+}
+
+int64_t Drone::get_squared_distance(Location &l1, Location &l2) {
+    
+    LocationType t1 = l1.get_location_type();
+    LocationType t2 = l2.get_location_type();
+    
+    if ((t1 == LocationType::Medical && t2 == LocationType::Normal) ||
+        (t2 == LocationType::Medical && t1 == LocationType::Normal)) {
+        
+        return unreachable_distance;
+        
+    }
+    
+    return squared_offset(static_cast<int64_t>(l2.get_x_coord()) - l1.get_x_coord(),
+                          static_cast<int64_t>(l2.get_y_coord()) - l1.get_y_coord());
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    PART A: MST
+// ----------------------------------------------------------------------------
+
+void Drone::run_MST() {
+    
+    mst_result.total_weight = 0;
+    mst_result.parents.clear();
+    
+    if (num_locations == 0) {
+        
+        return;
+        
+    }
+    
+    if (compact_active) {
+        
+        PHASE_TIMER("prim_algorithm");
+        compact_prim_algorithm();
+        
+        return;
+        
+    }
+    
+    // Zones only matter with both Medical and Normal locations
+    bool medical = false, normal = false;
+    
+    for (Location &location : v_locations) {
+        
+        medical = medical || (location.get_location_type() == LocationType::Medical);
+        normal = normal || (location.get_location_type() == LocationType::Normal);
+        
+    }
+    
+    {
+        PHASE_TIMER("prim_algorithm");
+        
+        if (medical && normal) {
+            
+            prim_algorithm(ZoneDistance(v_locations.data()));
+            
+        }
+        
+        else {
+            
+            prim_algorithm(EuclideanDistance(v_locations.data()));
+            
+        }
+    }
+    
+    mst_result.total_weight = MST_get_total_distance();
+    
+    mst_result.parents.resize(static_cast<size_t>(num_locations));
+    
+    // Location 0 is its own parent
+    mst_result.parents[0] = 0;
+    
+    for (size_t i = 1; i < static_cast<size_t>(num_locations); i++) {
+        
+        mst_result.parents[i] = static_cast<size_t>(prim_parents[i].get_location_num());
+        
+    }
+    
+}
+
+template <typename Distance>
+void Drone::prim_algorithm(const Distance &distance) {
+    
+    // first location to start tree
+    prim_initialize_vectors(distance, 0);
+    
+    int count = 1;
+    
+    // Algorithm
+    
+    // while not all locations have been visited
+    while (count != num_locations) {
+        
+        size_t next_location_index = find_closest_location();
+        
+        prim_algorithm_update(distance, next_location_index);
+        
+        count++;
+        
+    }
+    
+}
+
+template <typename Distance>
+void Drone::prim_initialize_vectors(const Distance &distance, size_t first_location_index) {
+    
+    // Initializing vector prim_parents
+    // (assign() keeps the storage from the previous solve)
+    prim_parents.assign(static_cast<size_t>(num_locations), v_locations[first_location_index]);
+    
+    // Initializing vector prim_distances
+    prim_distances.resize(static_cast<size_t>(num_locations));
+    
+    // Filling vector with distance from each location to first location/first parent
+    for (size_t i = 0; i < static_cast<size_t>(num_locations); i++) {
+        
+        prim_distances[i] = distance.squared(first_location_index, i);
+        
+    }
+    
+    // Initializing vector prim_visited
+    prim_visited.assign(static_cast<size_t>(num_locations), false);
+    
+    // setting first location to visited
+    prim_visited[first_location_index] = true;
+    
+    return;
+    
+}
+
+size_t Drone::find_closest_location() {
+    
+    int64_t min_distance = unreachable_distance;
+    
+    int index = -1;
+    
+//    for (int i = 0; i < num_locations; i++) {
+//
+//        if (prim_distances[static_cast<size_t>(i)] < min_distance) {
+//
+//            // unvisited location
+//            if (prim_visited[static_cast<size_t>(i)] == false) {
+//
+//                // new minimum distance
+//                min_distance = prim_distances[static_cast<size_t>(i)];
+//
+//                index = i;
+//
+//            }
+//
+//        }
+//
+//    }
+    
+    for (int i = 0; i < static_cast<int>(prim_distances.size()); i++) {
+        
+        if (prim_distances[static_cast<size_t>(i)] < min_distance) {
+            
+            // unvisited location
+            if (prim_visited[static_cast<size_t>(i)] == false) {
+                
+                // new minimum distance
+                min_distance = prim_distances[static_cast<size_t>(i)];
+                
+                index = i;
+                
+            }
+            
+        }
+        
+    }
+    
+    // DEBUG
+    if ((min_distance == unreachable_distance) || (index == -1)) {
+        
+        throw DroneError("Error: No closest location found. Program terminating");
+        
+    }
+    
+    return static_cast<size_t>(index);
+    
+}
+
+template <typename Distance>
+void Drone::prim_algorithm_update(const Distance &distance, size_t next_location_index) {
+    
+    // added to the tree
+    prim_visited[next_location_index] = true;
+    
+    for (size_t i = 0; i < static_cast<size_t>(num_locations); i++) {
+        
+        // same location as next location
+        if (i == next_location_index) {
+            
+            continue;
+            
+        }
+        
+        // Only looking at locations that are not part of the map
+        if (prim_visited[i] == false) {
+            
+            int64_t temp_distance = distance.squared(next_location_index, i);
+            
+            // if (distance between this location and next location) is less than (distance to current parent)
+            if (temp_distance < prim_distances[i]) {
+                
+                // New parent, update distance
+                prim_parents[i] = v_locations[next_location_index];
+                
+                prim_distances[i] = temp_distance;
+                
+            }
+            
+        }
+        
+    }
+    
+}
+
+double Drone::MST_get_total_distance() {
+    
+    double total_weight = 0;
+    
+    // Finding total distances
+    for (size_t i = 0; i < prim_distances.size(); i++) {
+        
+        // DEBUG
+        if (prim_distances[i] == unreachable_distance) {
+            
+            throw DroneError("Error: After MST Tree was constructed, found an edge with length INFINITY. Program terminating");
+            
+        }
+        
+        // Edges were compared squared; sqrt only for the total
+        total_weight += squared_length(prim_distances[i]);
+        
+    }
+    
+    return total_weight;
+    
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    PART B: FASTTSP
+// ----------------------------------------------------------------------------
+
+void Drone::run_FASTTSP() {
+    
+    if (num_locations < 3) {
+        
+        throw DroneError("Error: FASTTSP needs at least 3 locations. Program terminating");
+        
+    }
+    
+    double total_distance = 0;
+    
+    {
+        PHASE_TIMER("fast_insertion");
+        
+        // FASTTSP locations have no zones
+        FAST_build_tour(EuclideanDistance(v_locations.data()), total_distance);
+    }
+    
+    // popping 0 at the back
+    FAST_path.pop_back();
+    
+    tour_result.total_distance = total_distance;
+    tour_result.path = FAST_path;
+    
+}
+
+void Drone::set_warm_start(const Coordinate *previous_tour, size_t count) {
+    
+    warm_tour.assign(previous_tour, previous_tour + count);
+    
+}
+
+template <typename Distance>
+void Drone::FAST_build_tour(const Distance &distance, double &total_distance) {
+    
+    if (!warm_tour.empty() && FAST_warm_start(total_distance)) {
+        
+        return;
+        
+    }
+    
+    FAST_initialize_vectors(distance, FAST_insertion_location(0), FAST_insertion_location(1), FAST_insertion_location(2),
+                            total_distance);
+    
+    FAST_arbitrary_insert_algorithm(distance, total_distance);
+    
+}
+
+// Maps the previous tour onto today's locations by coordinates: vanished
+// locations are dropped, new ones are inserted cheapest-first near where
+// they belong, and a local 2-opt repairs the tour around every change.
+// Returns false (caller starts cold) if fewer than 3 locations carried over.
+bool Drone::FAST_warm_start(double &total_distance) {
+    
+    size_t count = static_cast<size_t>(num_locations);
+    
+    auto key_of = [](int x, int y) {
+        
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+        
+    };
+    
+    // Coordinates -> location number; duplicates are chained through same_coords
+    std::unordered_map<uint64_t, uint32_t> first_with_coords;
+    std::vector<uint32_t> same_coords(count, UINT32_MAX);
+    
+    first_with_coords.reserve(count);
+    
+    for (size_t i = count; i-- > 0; ) {
+        
+        uint64_t key = key_of(v_locations[i].get_x_coord(), v_locations[i].get_y_coord());
+        
+        auto inserted = first_with_coords.emplace(key, static_cast<uint32_t>(i));
+        
+        if (!inserted.second) {
+            
+            same_coords[i] = inserted.first->second;
+            inserted.first->second = static_cast<uint32_t>(i);
+            
+        }
+        
+    }
+    
+    std::vector<size_t> carried_over;
+    std::vector<char> in_tour(count, 0);
+    
+    // Where the previous tour lost locations (repaired after seeding)
+    std::vector<size_t> gaps;
+    bool lost_one = false;
+    
+    carried_over.reserve(count);
+    
+    for (const Coordinate &c : warm_tour) {
+        
+        auto found = first_with_coords.find(key_of(c.x, c.y));
+        
+        if (found == first_with_coords.end() || found->second == UINT32_MAX) {
+            
+            lost_one = true;
+            
+            continue;
+            
+        }
+        
+        uint32_t location = found->second;
+        
+        found->second = same_coords[location];
+        
+        if (lost_one && !carried_over.empty()) {
+            
+            gaps.push_back(location);
+            
+        }
+        
+        lost_one = false;
+        
+        carried_over.push_back(location);
+        in_tour[location] = 1;
+        
+    }
+    
+    if (carried_over.size() < 3) {
+        
+        return false;
+        
+    }
+    
+    std::vector<Coordinate> coords(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        coords[i] = { v_locations[i].get_x_coord(), v_locations[i].get_y_coord() };
+        
+    }
+    
+    OnlineTour tour;
+    
+    tour.seed(coords.data(), count, carried_over);
+    
+    tour.set_repair(true);
+    
+    for (size_t location : gaps) {
+        
+        tour.repair_around(location);
+        
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        if (!in_tour[i]) {
+            
+            tour.insert_location(i);
+            
+        }
+        
+    }
+    
+    tour.get_path(FAST_path);
+    
+    // closing edge back to the start, as FAST_initialize_vectors() does
+    FAST_path.push_back(FAST_path.front());
+    
+    total_distance = 0;
+    
+    for (size_t i = 0; i + 1 < FAST_path.size(); i++) {
+        
+        total_distance += get_distance(v_locations[FAST_path[i]], v_locations[FAST_path[i + 1]]);
+        
+    }
+    
+    return true;
+    
+}
+
+template <typename Distance>
+void Drone::FAST_initialize_vectors(const Distance &distance, size_t first_index, size_t second_index, size_t third_index,
+                                    double &total_distance) {
+    
+    FAST_path.clear();
+    
+    // +1 accounts for 0 (looping back to first index. Ex: 0-> 1-> 2-> 0)
+    FAST_path.reserve(static_cast<size_t>(num_locations + 1));
+    
+    FAST_path.push_back(first_index);
+    FAST_path.push_back(second_index);
+    FAST_path.push_back(third_index);
+    FAST_path.push_back(first_index);
+    
+    total_distance += distance.length(first_index, second_index) +
+    distance.length(second_index, third_index) +
+    distance.length(third_index, first_index);
+    
+}
+
+template <typename Distance>
+void Drone::FAST_arbitrary_insert_algorithm(const Distance &distance, double &total_distance) {
+    
+    // starting at index 3 (4th Location)
+    // looping through rest of locations
+    for (size_t i = 3; i < static_cast<size_t>(num_locations); i++) {
+        
+        double min_distance_change = std::numeric_limits<double>::infinity();
+        
+        // should insert after index found
+        // ex: (0, 1, 2, 3) -> insert between 1 and 2
+        // => index where this is found is 1 (between 1 and 2)
+        // => insert at index 2 (index 1 + 1 = 2)
+        
+        // size_t index_to_insert;
+        
+        // looping through current path
+        // -1: vector path already accounts for last/first comparison; don't check last value
+        // (0, 1, 2, 0) -> only check 0 (0 -> 1), 1 (1 -> 2), 2 (2 -> 0)
+        
+        // iterators for vector.insert()
+        auto it = FAST_path.begin();
+        auto it_insert_index = it;
+        
+        size_t location = FAST_insertion_location(i);
+        
+        // Float search; the change itself in double, as below
+        if (compact_active) {
+            
+            size_t j = compact_insert_position(distance, location);
+            
+            total_distance += FAST_distance_change(distance, j, (j + 1), location);
+            
+            FAST_path.insert(FAST_path.begin() + static_cast<std::ptrdiff_t>(j + 1), location);
+            
+            continue;
+            
+        }
+        
+        for (size_t j = 0; j < FAST_path.size() - 1; j++) {
+            
+            // +1 is for looking at this location and next location
+            
+            double distance_change = FAST_distance_change(distance, j, (j + 1), location);
+            
+            // shorter distance than current best
+            if (distance_change < min_distance_change) {
+                
+                min_distance_change = distance_change;
+                
+                //index_to_insert = j + 1;
+                
+                it_insert_index = it;
+                it_insert_index++;
+                
+            }
+            
+            it++;
+            
+        }
+        
+        // distance added from inserting location into path
+        total_distance += min_distance_change;
+        
+        // 0 will always be the last element in FAST_path
+        FAST_path.insert(it_insert_index, location);
+        
+    }
+    
+}
+
+size_t Drone::FAST_insertion_location(size_t k) {
+    
+    return reorder ? reorder_rank[k] : k;
+    
+}
+
+template <typename Distance>
+double Drone::FAST_distance_change(const Distance &distance, size_t first_index, size_t second_index, size_t new_index) {
+    
+    // v_locations(0, 1, 2, ...) [path(1, 4, 2, 3, ...)]
+    size_t first = FAST_path[first_index];
+    size_t second = FAST_path[second_index];
+    
+    //
+    // Formula: change in distance = d(i, k) + d(k, j) - d(i, j)
+    //
+    //    Location i: first Location
+    //
+    //    Location j: second Location
+    //
+    //    Location k: location being inserted into the path
+    //
+    
+    double distance_change = distance.length(first, new_index) + distance.length(new_index, second) - distance.length(first, second);
+    
+    return distance_change;
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    PART C: OPTTSP
+// ----------------------------------------------------------------------------
+
+void Drone::run_OPTTSP() {
+    
+    if (num_locations < 3) {
+        
+        throw DroneError("Error: OPTTSP needs at least 3 locations. Program terminating");
+        
+    }
+    
+    size_t count = static_cast<size_t>(num_locations);
+    
+    bool matrix = (count <= matrix_max_locations);
+    
+    {
+        PHASE_TIMER("fast_insertion");
+        
+        if (matrix) {
+            
+            OPT_fill_matrix();
+            
+            OPT_initialize(MatrixDistance<double>(OPT_squares.data(), OPT_lengths.data(), count));
+            
+        }
+        
+        else {
+            
+            OPT_initialize(EuclideanDistance(v_locations.data()));
+            
+        }
+    }
+    
+    
+//    // DEBUG
+//    std::cout << OPT_best_distance << "\n";
+//    for (size_t i = 0; i < FAST_path.size(); i++) {
+//
+//        std::cout << FAST_path[i] << " ";
+//
+//    }
+//    std::cout << "\n";
+    
+    {
+        PHASE_TIMER("genPerms");
+        
+        if (!matrix) {
+            
+            genPerms(EuclideanDistance(v_locations.data()), 1);
+            
+        }
+        
+        // Every edge rounded to float once. A float sum of a tour is within
+        // OPT_slack of its exact length, so comparisons against the
+        // incumbent get that much room and candidates are confirmed with
+        // OPT_exact_length(). (compact_distances was FASTTSP's until now.)
+        else if (compact_active) {
+            
+            OPT_slack = OPT_best_distance * compact_tolerance;
+            
+            compact_distances.resize(count * count);
+            
+            for (size_t i = 0; i < count * count; i++) {
+                
+                compact_distances[i] = static_cast<float>(OPT_lengths[i]);
+                
+            }
+            
+            genPerms(MatrixDistance<float>(OPT_squares.data(), compact_distances.data(), count), 1);
+            
+        }
+        
+        else {
+            
+            genPerms(MatrixDistance<double>(OPT_squares.data(), OPT_lengths.data(), count), 1);
+            
+        }
+    }
+    
+    tour_result.total_distance = OPT_best_distance;
+    tour_result.path = OPT_best_path;
+    
+    
+}
+
+template <typename Distance>
+void Drone::OPT_initialize(const Distance &distance) {
+    
+    //std::vector<bool> temp_visited(static_cast<size_t>(num_locations), false);
+    //OPT_visited.swap(temp_visited);
+    
+    // initializes:
+    
+    //     OPT_best_path
+    //     OPT_best_distance
+    OPT_FASTTSP_helper(distance);
+    
+    OPT_path.resize(static_cast<size_t>(num_locations));
+    
+    // 0, 1, 2, 3...
+    for (size_t i = 0; i < static_cast<size_t>(num_locations); i++) {
+        
+        OPT_path[i] = i;
+        
+    }
+    
+    OPT_current_distance = 0;
+    
+    OPT_slack = 0;
+    
+    // Location 0 is visited first
+    //OPT_visited[0] = true;
+    
+}
+
+// initializes:
+//     OPT_path
+//     OPT_best_path
+//     OPT_best_distance
+template <typename Distance>
+void Drone::OPT_FASTTSP_helper(const Distance &distance) {
+    
+    double total_distance = 0;
+    
+    // With a warm start the previous tour becomes the first incumbent
+    FAST_build_tour(distance, total_distance);
+    
+    OPT_best_distance = total_distance;
+    
+    
+    // Popping 0 at the back of vector
+    FAST_path.pop_back();
+    
+    OPT_best_path = FAST_path;
+    
+    // A shorter first incumbent prunes more of genPerms()
+    if (improvement != Improvement::None) {
+        
+        size_t count = static_cast<size_t>(num_locations);
+        
+        std::vector<Coordinate> coords(count);
+        
+        for (size_t i = 0; i < count; i++) {
+            
+            coords[i] = { v_locations[i].get_x_coord(), v_locations[i].get_y_coord() };
+            
+        }
+        
+        TourResult improved;
+        
+        improved.path = OPT_best_path;
+        
+        improve_tour(coords.data(), count, improvement, time_limit, improved);
+        
+        double improved_distance = 0;
+        
+        for (size_t i = 0; i < count; i++) {
+            
+            improved_distance += distance.length(improved.path[i], improved.path[(i + 1) % count]);
+            
+        }
+        
+        if (improved_distance < OPT_best_distance) {
+            
+            OPT_best_distance = improved_distance;
+            
+            OPT_best_path = improved.path;
+            
+        }
+        
+    }
+    
+}
+
+template <typename Distance>
+void Drone::genPerms(const Distance &distance, size_t permLength) {
+    
+    if (permLength == OPT_path.size()) {
+        
+        // add closing edge
+        // check/update best distance/path
+        // subtract closing edge
+        
+        // closing edge
+        double closing_edge = distance.length(OPT_path[0], OPT_path[permLength - 1]);
+        
+        
+//        //DEBUG:
+//
+//        if (OPT_current_distance + closing_edge > 354.2 && OPT_current_distance + closing_edge < 354.3) {
+//
+//            std::cout << "DEBUG\n";
+//
+//            int i = 0;
+//            i++;
+//
+//        }
+        
+        OPT_current_distance += closing_edge;
+        
+        // Better than previous distance; update best distance
+        if (OPT_current_distance < OPT_best_distance + OPT_slack) {
+            
+            double tour_distance = Distance::exact ? OPT_current_distance : OPT_exact_length();
+            
+            if (tour_distance < OPT_best_distance) {
+                
+                OPT_best_distance = tour_distance;
+                
+                OPT_best_path = OPT_path;
+                
+            }
+            
+        }
+        
+        OPT_current_distance -= closing_edge;
+        
+        return;
+        
+    } // if
+    if (is_promising(distance, permLength) == false) {
+        
+        return;
+        
+    }
+    
+    for (size_t i = permLength; i < OPT_path.size(); ++i) {
+        
+        std::swap(OPT_path[permLength], OPT_path[i]);
+        
+        OPT_current_distance += distance.length(OPT_path[permLength], OPT_path[permLength - 1]);
+        
+        genPerms(distance, permLength + 1);
+        
+        OPT_current_distance -= distance.length(OPT_path[permLength], OPT_path[permLength - 1]);
+        
+        std::swap(OPT_path[permLength], OPT_path[i]);
+        
+        //OPT_visited[OPT_path[i]] = true;
+        
+    } // for
+    
+} // genPerms()
+
+template <typename Distance>
+bool Drone::is_promising(const Distance &distance, size_t permLength) {
+    
+    // if there is 4 or less unvisited vertices
+    if (OPT_path.size() - permLength <= 5) {
+        
+        return true;
+        
+    }
+    
+    // Making a MST out of unvisited Locations (location numbers, which is
+    // what OPT_modified_prim_algorithm() takes, not positions in OPT_path)
+    std::vector<size_t> &unvisited = OPT_unvisited;
+    unvisited.clear();
+    
+    for (size_t i = permLength; i < OPT_path.size(); i++) {
+        
+        unvisited.push_back(OPT_path[i]);
+        
+    }
+    
+//    for (size_t i = 0; i < OPT_visited.size(); i++) {
+//
+//        if (OPT_visited[i] == false) {
+//
+//            // permLength is already at the front of index
+//            if (i != permLength) {
+//
+//                unvisited.push_back(i);
+//
+//            }
+//
+//        }
+//
+//    }
+    
+    //OPT_modified_prim_initialize_vectors(v_locations[unvisited[0]], 0, unvisited);
+    
+    OPT_modified_prim_algorithm(distance, unvisited);
+    
+    // MST created
+    
+//    // Edge from MST to beginning of path (closing edge)
+//    double connecting_edge = get_distance(v_locations[OPT_path[permLength]], v_locations[OPT_path[0]]);
+    
+    //size_t zero_connecting_index = 0, last_connecting_index = 0;
+    // (squared while comparing)
+    int64_t zero_distance = unreachable_distance, last_distance = unreachable_distance;
+    
+    for (size_t i = 0; i < unvisited.size(); i++) {
+        
+        // Distance from first Location in path to this unvisited locaiton
+        int64_t temp_zero = distance.squared(unvisited[i], OPT_path[0]);
+        
+        if (temp_zero < zero_distance) {
+            
+            zero_distance = temp_zero;
+            
+        }
+        
+        // Distance from last fixed Location in path to this unvisited locaiton
+        int64_t temp_last = distance.squared(unvisited[i], OPT_path[permLength - 1]);
+        
+        if (temp_last < last_distance) {
+            
+            last_distance = temp_last;
+            
+        }
+        
+    }
+    
+    // Estimated distance + distance traveled already + connecting_edge
+    double lower_bound = MST_get_total_distance() + OPT_current_distance +
+    squared_length(zero_distance) + squared_length(last_distance);
+    
+    // DEBUG:
+//    std::cout << MST_get_total_distance() << "\n";
+//
+//    for (size_t i = 0; i < unvisited.size(); i++) {
+//
+//        std::cout << v_locations[unvisited[i]].get_x_coord() << " " << v_locations[unvisited[i]].get_y_coord() << "\n";
+//
+//    }
+    
+//    for (size_t i = 0; i < prim_distances.size() - 1; i++) {
+//
+//        Location this_location = v_locations[unvisited[i]];
+//        Location parent_location = prim_parents[unvisited[i]];
+//
+//        if (this_location.get_location_num() < parent_location.get_location_num()) {
+//
+//            std::cout << unvisited[i] << " " << parent_location.get_location_num() - 1 << "\n";
+//
+//        }
+//
+//        else {
+//
+//            std::cout << parent_location.get_location_num() - 1 << " " << unvisited[i] << "\n";
+//
+//        }
+//
+//    }
+    
+    
+    // clear MST to be used again
+    
+    OPT_reset_prim();
+    
+    // keep searching this path
+    if (lower_bound < OPT_best_distance + OPT_slack) {
+        
+        return true;
+        
+    }
+    
+    else {
+        
+        return false;
+        
+    }
+    
+    
+}
+
+
+template <typename Distance>
+void Drone::OPT_modified_prim_algorithm(const Distance &distance, std::vector<size_t> &unvisited_locations) {
+    
+    // first location to start tree
+    OPT_modified_prim_initialize_vectors(distance, 0, unvisited_locations);
+    
+    size_t count = 1;
+    
+    while (count != unvisited_locations.size()) {
+        
+        size_t next_location_index = find_closest_location();
+        
+        OPT_modified_prim_update(distance, next_location_index, unvisited_locations);
+        
+        count++;
+        
+    }
+    
+}
+
+template <typename Distance>
+void Drone::OPT_modified_prim_initialize_vectors(const Distance &distance, size_t first_location_index,
+                                                 std::vector<size_t> &unvisited_locations) {
+    
+    size_t first_location = unvisited_locations[first_location_index];
+    
+    // Initializing vector prim_parents
+    prim_parents.assign(unvisited_locations.size(), v_locations[first_location]);
+    
+    // Initializing vector prim_distances
+    prim_distances.resize(unvisited_locations.size());
+    
+    // Filling vector with distance from each location to first location/first parent
+    for (size_t i = 0; i < unvisited_locations.size(); i++) {
+        
+        prim_distances[i] = distance.squared(first_location, unvisited_locations[i]);
+        
+    }
+    
+    // Initializing vector prim_visited
+    prim_visited.assign(unvisited_locations.size(), false);
+    
+    // setting first location to visited
+    prim_visited[first_location_index] = true;
+    
+    return;
+    
+}
+
+template <typename Distance>
+void Drone::OPT_modified_prim_update(const Distance &distance, size_t next_location_index, std::vector<size_t> &unvisited_locations) {
+    
+    size_t next_location = unvisited_locations[next_location_index];
+    
+    // added to the tree
+    prim_visited[next_location_index] = true;
+    
+    for (size_t i = 0; i < unvisited_locations.size(); i++) {
+        
+        // same location as next location
+        if (i == next_location_index) {
+            
+            continue;
+            
+        }
+        
+        // Only looking at locations that are not part of the map
+        if (prim_visited[i] == false) {
+            
+            int64_t temp_distance = distance.squared(next_location, unvisited_locations[i]);
+            
+            // if (distance between this location and next location) is less than (distance to current parent)
+            if (temp_distance < prim_distances[i]) {
+                
+                // New parent, update distance
+                prim_parents[i] = v_locations[next_location];
+                
+                prim_distances[i] = temp_distance;
+                
+            }
+            
+        }
+        
+    }
+    
+}
+
+void Drone::OPT_fill_matrix() {
+    
+    size_t count = static_cast<size_t>(num_locations);
+    
+    // OPTTSP locations have no zones
+    EuclideanDistance euclidean(v_locations.data());
+    
+    OPT_squares.resize(count * count);
+    OPT_lengths.resize(count * count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        for (size_t j = 0; j < count; j++) {
+            
+            OPT_squares[i * count + j] = euclidean.squared(i, j);
+            OPT_lengths[i * count + j] = euclidean.length(i, j);
+            
+        }
+        
+    }
+    
+}
+
+void Drone::OPT_reset_prim() {
+    
+    prim_parents.clear();
+    
+    prim_distances.clear();
+    
+    prim_visited.clear();
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    PART D: SFCTSP
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// Neighborhood (in tour positions) searched for Or-opt insertion points
+const size_t SFC_or_opt_window = 16;
+
+const size_t SFC_max_segment = 3;
+
+const size_t SFC_max_passes = 3;
+
+}
+
+void Drone::run_SFCTSP(const Coordinate *coords) {
+    
+    if (num_locations < 3) {
+        
+        throw DroneError("Error: SFCTSP needs at least 3 locations. Program terminating");
+        
+    }
+    
+    size_t count = static_cast<size_t>(num_locations);
+    
+    SFC_coords = coords;
+    
+    SFC_zones.resize(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        SFC_zones[i] = zone_of(coords[i]);
+        
+    }
+    
+    {
+        PHASE_TIMER("hilbert_reorder");
+        curve_order(coords, count, SFC_order);
+    }
+    
+    SFC_build_path();
+    
+    if (SFC_or_opt) {
+        
+        PHASE_TIMER("or_opt");
+        
+        for (size_t pass = 0; pass < SFC_max_passes && SFC_or_opt_pass(); pass++) {}
+        
+    }
+    
+    // Start at location 0, same as the other tours
+    auto start = std::find(SFC_path.begin(), SFC_path.end(), 0);
+    
+    std::rotate(SFC_path.begin(), start, SFC_path.end());
+    
+    // Exact total of the final tour (not a sum of move deltas)
+    double total_distance = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        total_distance += SFC_distance(SFC_path[i], SFC_path[(i + 1) % count]);
+        
+    }
+    
+    tour_result.total_distance = total_distance;
+    tour_result.path = SFC_path;
+    
+    SFC_coords = nullptr;
+    
+}
+
+void Drone::SFC_build_path() {
+    
+    size_t num_medical = 0, num_normal = 0;
+    
+    std::vector<size_t> borders;
+    
+    for (size_t i = 0; i < SFC_zones.size(); i++) {
+        
+        if (SFC_zones[i] == LocationType::Medical) {
+            
+            num_medical++;
+            
+        }
+        
+        else if (SFC_zones[i] == LocationType::Normal) {
+            
+            num_normal++;
+            
+        }
+        
+        else {
+            
+            borders.push_back(i);
+            
+        }
+        
+    }
+    
+    if (num_medical == 0 || num_normal == 0) {
+        
+        SFC_path.swap(SFC_order);
+        
+        return;
+        
+    }
+    
+    // The tour has to cross between the zones twice
+    if (borders.size() < 2) {
+        
+        throw DroneError("Error: SFCTSP needs at least 2 Border locations to join Medical and Normal locations. Program terminating");
+        
+    }
+    
+    // Tour: b1, Medical + other Borders (curve order), b2, Normal (curve order)
+    SFC_path.clear();
+    SFC_path.reserve(SFC_zones.size());
+    
+    std::vector<size_t> normals;
+    normals.reserve(num_normal);
+    
+    for (size_t location : SFC_order) {
+        
+        if (SFC_zones[location] == LocationType::Normal) {
+            
+            normals.push_back(location);
+            
+        }
+        
+        else {
+            
+            SFC_path.push_back(location);
+            
+        }
+        
+    }
+    
+    auto closest_border = [&](size_t to, size_t skip) {
+        
+        size_t best = borders[0] == skip ? borders[1] : borders[0];
+        
+        for (size_t border : borders) {
+            
+            if (border != skip && squared_distance(SFC_coords[border], SFC_coords[to]) <
+                squared_distance(SFC_coords[best], SFC_coords[to])) {
+                
+                best = border;
+                
+            }
+            
+        }
+        
+        return best;
+        
+    };
+    
+    // b2 leads into the Normal run, b1 closes the tour after it
+    size_t b2 = closest_border(normals.front(), SIZE_MAX);
+    size_t b1 = closest_border(normals.back(), b2);
+    
+    SFC_path.erase(std::remove_if(SFC_path.begin(), SFC_path.end(), [&](size_t location) {
+        
+        return location == b1 || location == b2;
+        
+    }), SFC_path.end());
+    
+    SFC_path.insert(SFC_path.begin(), b1);
+    SFC_path.push_back(b2);
+    SFC_path.insert(SFC_path.end(), normals.begin(), normals.end());
+    
+}
+
+bool Drone::SFC_or_opt_pass() {
+    
+    std::vector<size_t> &path = SFC_path;
+    
+    size_t n = path.size();
+    
+    const double min_gain = 1e-9;
+    
+    bool improved = false;
+    
+    // Segment path[i .. i + length - 1]; position 0 never moves
+    for (size_t i = 1; i + 1 < n; i++) {
+        
+        for (size_t length = 1; length <= SFC_max_segment && i + length < n; length++) {
+            
+            size_t prev = path[i - 1];
+            size_t first = path[i];
+            size_t last = path[i + length - 1];
+            size_t next = path[i + length];
+            
+            if (!SFC_compatible(prev, next)) {
+                
+                continue;
+                
+            }
+            
+            double removal_gain = SFC_distance(prev, first) + SFC_distance(last, next) - SFC_distance(prev, next);
+            
+            if (removal_gain <= min_gain) {
+                
+                continue;
+                
+            }
+            
+            double best_gain = min_gain;
+            size_t best_edge = SIZE_MAX;
+            bool best_reversed = false;
+            
+            size_t low = (i > SFC_or_opt_window + 1) ? i - 1 - SFC_or_opt_window : 0;
+            size_t high = std::min(n - 2, i + length + SFC_or_opt_window);
+            
+            // Edge path[j] -> path[j + 1], not touching the segment
+            for (size_t j = low; j <= high; j++) {
+                
+                if (j + 1 >= i && j < i + length) {
+                    
+                    continue;
+                    
+                }
+                
+                size_t a = path[j];
+                size_t b = path[j + 1];
+                
+                double base = SFC_distance(a, b);
+                
+                if (SFC_compatible(a, first) && SFC_compatible(last, b)) {
+                    
+                    double gain = removal_gain - (SFC_distance(a, first) + SFC_distance(last, b) - base);
+                    
+                    if (gain > best_gain) {
+                        
+                        best_gain = gain;
+                        best_edge = j;
+                        best_reversed = false;
+                        
+                    }
+                    
+                }
+                
+                if (length > 1 && SFC_compatible(a, last) && SFC_compatible(first, b)) {
+                    
+                    double gain = removal_gain - (SFC_distance(a, last) + SFC_distance(first, b) - base);
+                    
+                    if (gain > best_gain) {
+                        
+                        best_gain = gain;
+                        best_edge = j;
+                        best_reversed = true;
+                        
+                    }
+                    
+                }
+                
+            }
+            
+            if (best_edge == SIZE_MAX) {
+                
+                continue;
+                
+            }
+            
+            auto segment_begin = path.begin() + static_cast<std::ptrdiff_t>(i);
+            auto segment_end = segment_begin + static_cast<std::ptrdiff_t>(length);
+            auto edge_end = path.begin() + static_cast<std::ptrdiff_t>(best_edge + 1);
+            
+            // Slide the segment to sit between path[best_edge] and its successor
+            if (best_edge > i) {
+                
+                std::rotate(segment_begin, segment_end, edge_end);
+                
+                if (best_reversed) {
+                    
+                    std::reverse(edge_end - static_cast<std::ptrdiff_t>(length), edge_end);
+                    
+                }
+                
+            }
+            
+            else {
+                
+                std::rotate(edge_end, segment_begin, segment_end);
+                
+                if (best_reversed) {
+                    
+                    std::reverse(edge_end, edge_end + static_cast<std::ptrdiff_t>(length));
+                    
+                }
+                
+            }
+            
+            improved = true;
+            
+            break;
+            
+        }
+        
+    }
+    
+    return improved;
+    
+}
+
+double Drone::SFC_distance(size_t l1, size_t l2) {
+    
+    return squared_length(squared_distance(SFC_coords[l1], SFC_coords[l2]));
+    
+}
+
+bool Drone::SFC_compatible(size_t l1, size_t l2) {
+    
+    return zones_compatible(SFC_zones[l1], SFC_zones[l2]);
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    PART E: Precision::Float
+// ----------------------------------------------------------------------------
+
+bool Drone::compact_load() {
+    
+    size_t count = v_locations.size();
+    
+    compact_coords.resize(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        int x = v_locations[i].get_x_coord(), y = v_locations[i].get_y_coord();
+        
+        if (x <= -compact_max_coordinate || x >= compact_max_coordinate ||
+            y <= -compact_max_coordinate || y >= compact_max_coordinate) {
+            
+            return false;
+            
+        }
+        
+        compact_coords[i].x = static_cast<float>(x);
+        compact_coords[i].y = static_cast<float>(y);
+        
+    }
+    
+    compact_zones.clear();
+    
+    if (mode == 'M') {
+        
+        compact_zones.resize(count);
+        
+        for (size_t i = 0; i < count; i++) {
+            
+            compact_zones[i] = static_cast<uint8_t>(v_locations[i].get_location_type());
+            
+        }
+        
+    }
+    
+    return true;
+    
+}
+
+void Drone::compact_prim_algorithm() {
+    
+    size_t count = static_cast<size_t>(num_locations);
+    
+    const float infinity = std::numeric_limits<float>::infinity();
+    
+    compact_distances.assign(count, infinity);
+    compact_parents.assign(count, 0);
+    
+    // Exact comparison of i's distance to a and to b (squared)
+    auto exactly_closer = [&](size_t i, size_t a, size_t b) {
+        
+        return get_squared_distance(v_locations[i], v_locations[a]) < get_squared_distance(v_locations[i], v_locations[b]);
+        
+    };
+    
+    // Tree members are marked with -1, which no candidate beats, so one pass
+    // per location both relaxes the distances and finds the next closest
+    size_t next = 0;
+    
+    for (size_t added = 0; added < count; added++) {
+        
+        compact_distances[next] = -1;
+        
+        CompactLocation c = compact_coords[next];
+        
+        // The zone next can't reach (Empty: none)
+        uint8_t medical = static_cast<uint8_t>(LocationType::Medical);
+        uint8_t normal = static_cast<uint8_t>(LocationType::Normal);
+        uint8_t blocked = static_cast<uint8_t>(LocationType::Empty);
+        
+        if (compact_zones[next] == medical) {
+            
+            blocked = normal;
+            
+        }
+        
+        else if (compact_zones[next] == normal) {
+            
+            blocked = medical;
+            
+        }
+        
+        float min_distance = infinity;
+        size_t closest = count;
+        
+        for (size_t i = 0; i < count; i++) {
+            
+            float dx = compact_coords[i].x - c.x;
+            float dy = compact_coords[i].y - c.y;
+            
+            float distance = dx * dx + dy * dy;
+            float current = compact_distances[i];
+            
+            // Same decisions as prim_algorithm_update(): clear cases in
+            // float, near-ties exactly
+            if (distance <= current * (1 + compact_tolerance) && compact_zones[i] != blocked) {
+                
+                if (distance < current * (1 - compact_tolerance) || exactly_closer(i, next, compact_parents[i])) {
+                    
+                    current = distance;
+                    
+                    compact_distances[i] = distance;
+                    compact_parents[i] = static_cast<uint32_t>(next);
+                    
+                }
+                
+            }
+            
+            // and find_closest_location() (smallest index among ties)
+            if (current >= 0 && current < infinity && current <= min_distance * (1 + compact_tolerance)) {
+                
+                if (current < min_distance * (1 - compact_tolerance) || closest == count ||
+                    get_squared_distance(v_locations[i], v_locations[compact_parents[i]]) <
+                    get_squared_distance(v_locations[closest], v_locations[compact_parents[closest]])) {
+                    
+                    min_distance = current;
+                    closest = i;
+                    
+                }
+                
+            }
+            
+        }
+        
+        if (added + 1 == count) {
+            
+            break;
+            
+        }
+        
+        if (closest == count) {
+            
+            throw DroneError("Error: No closest location found. Program terminating");
+            
+        }
+        
+        next = closest;
+        
+    }
+    
+    mst_result.parents.assign(compact_parents.begin(), compact_parents.end());
+    mst_result.parents[0] = 0;
+    
+    // Exact lengths, summed in location order like MST_get_total_distance()
+    mst_result.total_weight = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        mst_result.total_weight += get_distance(v_locations[i], v_locations[mst_result.parents[i]]);
+        
+    }
+    
+}
+
+template <typename Distance>
+size_t Drone::compact_insert_position(const Distance &distance, size_t location) {
+    
+    size_t num_edges = FAST_path.size() - 1;
+    
+    // Lowest each edge's exact change could be, and the highest the best
+    // one could be
+    compact_distances.resize(num_edges);
+    
+    float best_upper = std::numeric_limits<float>::infinity();
+    
+    float previous = compact_distance(FAST_path[0], location);
+    
+    for (size_t j = 0; j < num_edges; j++) {
+        
+        // d(j, k) carries over from the previous edge's d(k, j + 1)
+        float next = compact_distance(location, FAST_path[j + 1]);
+        float across = compact_distance(FAST_path[j], FAST_path[j + 1]);
+        
+        float distance_change = previous + next - across;
+        float error = (previous + next + across) * compact_tolerance;
+        
+        compact_distances[j] = distance_change - error;
+        
+        best_upper = std::min(best_upper, distance_change + error);
+        
+        previous = next;
+        
+    }
+    
+    // The few edges that could be best, compared as FAST_arbitrary_insert_algorithm() does
+    double min_distance_change = std::numeric_limits<double>::infinity();
+    
+    size_t best = 0;
+    
+    for (size_t j = 0; j < num_edges; j++) {
+        
+        if (compact_distances[j] <= best_upper) {
+            
+            double distance_change = FAST_distance_change(distance, j, (j + 1), location);
+            
+            if (distance_change < min_distance_change) {
+                
+                min_distance_change = distance_change;
+                
+                best = j;
+                
+            }
+            
+        }
+        
+    }
+    
+    return best;
+    
+}
+
+float Drone::compact_distance(size_t l1, size_t l2) {
+    
+    float dx = compact_coords[l1].x - compact_coords[l2].x;
+    float dy = compact_coords[l1].y - compact_coords[l2].y;
+    
+    return std::sqrt(dx * dx + dy * dy);
+    
+}
+
+double Drone::OPT_exact_length() {
+    
+    double total_distance = 0;
+    
+    for (size_t i = 0; i < OPT_path.size(); i++) {
+        
+        total_distance += get_distance(v_locations[OPT_path[i]], v_locations[OPT_path[(i + 1) % OPT_path.size()]]);
+        
+    }
+    
+    return total_distance;
+    
+}
+
+
+// ----------------------------------------------------------------------------
+//                    Library Functions
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// Each thread keeps one Drone so repeated calls reuse its vectors
+Drone &thread_drone() {
+    
+    thread_local Drone drone;
+    
+    return drone;
+    
+}
+
+}
+
+MSTResult solve_mst(const Coordinate *coords, size_t count) {
+    
+    return thread_drone().solve_mst(coords, count);
+    
+}
+
+MSTResult solve_mst(const std::vector<Coordinate> &coords) {
+    
+    return solve_mst(coords.data(), coords.size());
+    
+}
+
+TourResult solve_fast_tsp(const Coordinate *coords, size_t count) {
+    
+    return thread_drone().solve_fast_tsp(coords, count);
+    
+}
+
+TourResult solve_fast_tsp(const std::vector<Coordinate> &coords) {
+    
+    return solve_fast_tsp(coords.data(), coords.size());
+    
+}
+
+TourResult solve_opt_tsp(const Coordinate *coords, size_t count) {
+    
+    return thread_drone().solve_opt_tsp(coords, count);
+    
+}
+
+TourResult solve_opt_tsp(const std::vector<Coordinate> &coords) {
+    
+    return solve_opt_tsp(coords.data(), coords.size());
+    
+}
+
+TourResult solve_sfc_tsp(const Coordinate *coords, size_t count) {
+    
+    return thread_drone().solve_sfc_tsp(coords, count);
+    
+}
+
+TourResult solve_sfc_tsp(const std::vector<Coordinate> &coords) {
+    
+    return solve_sfc_tsp(coords.data(), coords.size());
+    
+}
+
+// reads in number of locations
+// reads in locations and adds them to a vector
+void read_input(std::istream &is, std::vector<Coordinate> &coords) {
+    
+    if (is_binary_input(is)) {
+        
+        read_binary_input(is, coords);
+        
+        return;
+        
+    }
+    
+    int num_locations_in = 0;
+    
+    is >> num_locations_in;
+    
+    coords.clear();
+    coords.reserve(static_cast<size_t>(std::max(num_locations_in, 0)));
+    
+    for (int i = 0; i < num_locations_in; i++) {
+        
+        Coordinate c_in;
+        
+        is >> c_in.x >> c_in.y;
+        
+        coords.push_back(c_in);
+        
+    }
+    
+}
+
+void MST_print(std::ostream &os, const MSTResult &result) {
+    
+    os << result.total_weight << "\n";
+    
+    // Skipping first location (it is its own parent)
+    for (size_t i = 1; i < result.parents.size(); i++) {
+        
+        size_t parent = result.parents[i];
+        
+        if (i < parent) {
+            
+            os << i << " " << parent << "\n";
+            
+        }
+        
+        else {
+            
+            os << parent << " " << i << "\n";
+            
+        }
+        
+    }
+    
+}
+
+void FAST_print(std::ostream &os, const TourResult &result) {
+    
+    os << result.total_distance << "\n";
+    
+    // printing path
+    for (size_t i = 0; i < result.path.size(); i++) {
+        
+        os << result.path[i] << " ";
+        
+    }
+    
+}
+
+void OPT_print(std::ostream &os, const TourResult &result) {
+    
+    FAST_print(os, result);
+    
+}
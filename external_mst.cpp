@@ -0,0 +1,1587 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  external_mst.cpp
+//  project4
+//
+
+#include "external_mst.hpp"
+#include "binary_input.hpp"
+#include "phase_timer.hpp"
+#include "spatial.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+
+
+namespace {
+
+// Working set per location of a loaded tile: the location (12 bytes), its
+// copy in the kd-tree (12 bytes and a share of a node), candidate edges (16 bytes, about
+// five per location) and cone queries, with a second tile loaded alongside
+// for the cross-tile searches
+const uint64_t bytes_per_point = 160;
+
+// Fewest locations per tile, so tiny limits still make progress
+const uint64_t min_tile_points = 256;
+
+// kd-tree levels per split pass (2^8 pieces, each with an open spill file)
+const size_t max_split_depth = 8;
+
+// Sampled locations per piece a split makes
+const size_t samples_per_piece = 64;
+
+// Records buffered per spill file
+const size_t buffer_records = 4096;
+
+// Locations per kd-tree leaf of a loaded tile
+const uint32_t leaf_points = 16;
+
+// A location as spilled: tiles keep their locations in location order
+struct TilePoint {
+    
+    uint32_t id;
+    
+    Coordinate c;
+    
+};
+
+// Edge between locations a < b
+struct TileEdge {
+    
+    int64_t d2;
+    
+    uint32_t a;
+    
+    uint32_t b;
+    
+};
+
+// Exact squared distance, then location numbers (the order kruskal_mst()
+// uses), so every step agrees on ties
+bool edge_before(const TileEdge &e, const TileEdge &f) {
+    
+    if (e.d2 != f.d2) {
+        
+        return e.d2 < f.d2;
+        
+    }
+    
+    if (e.a != f.a) {
+        
+        return e.a < f.a;
+        
+    }
+    
+    return e.b < f.b;
+    
+}
+
+TileEdge make_edge(int64_t d2, uint32_t u, uint32_t v) {
+    
+    return { d2, std::min(u, v), std::max(u, v) };
+    
+}
+
+// Closed box, empty until extended
+struct Box {
+    
+    int64_t min_x = std::numeric_limits<int64_t>::max();
+    int64_t min_y = std::numeric_limits<int64_t>::max();
+    int64_t max_x = std::numeric_limits<int64_t>::min();
+    int64_t max_y = std::numeric_limits<int64_t>::min();
+    
+    bool empty() const {
+        
+        return min_x > max_x;
+        
+    }
+    
+    void extend(const Coordinate &c) {
+        
+        min_x = std::min<int64_t>(min_x, c.x);
+        min_y = std::min<int64_t>(min_y, c.y);
+        max_x = std::max<int64_t>(max_x, c.x);
+        max_y = std::max<int64_t>(max_y, c.y);
+        
+    }
+    
+    void extend(const Box &box) {
+        
+        min_x = std::min(min_x, box.min_x);
+        min_y = std::min(min_y, box.min_y);
+        max_x = std::max(max_x, box.max_x);
+        max_y = std::max(max_y, box.max_y);
+        
+    }
+    
+};
+
+// Squared distance from (x, y) to the nearest point of a non-empty box, in
+// double (box - box differences can exceed 32 bits)
+double squared_distance_to(double x, double y, const Box &box) {
+    
+    double dx = std::max({ static_cast<double>(box.min_x) - x, 0.0, x - static_cast<double>(box.max_x) });
+    double dy = std::max({ static_cast<double>(box.min_y) - y, 0.0, y - static_cast<double>(box.max_y) });
+    
+    return dx * dx + dy * dy;
+    
+}
+
+// False only if no point of the box can be nearer than best_d2 (ties
+// count, since a tie with a smaller location number still wins)
+bool may_beat(double d2, int64_t best_d2) {
+    
+    return d2 <= squared_value(best_d2) * (1 + 1e-12) + 1;
+    
+}
+
+// Bit o is set if some point of a non-empty box lies in cone o around
+// (x, y), as octant_of() assigns cones. A box that misses the apex spans
+// less than 180 degrees, so the cones it meets run from one corner's cone
+// to another's the short way round; if two ways are equally short (corners
+// four cones apart), both are taken.
+uint32_t cone_mask(int64_t x, int64_t y, const Box &box) {
+    
+    if (x >= box.min_x && x <= box.max_x && y >= box.min_y && y <= box.max_y) {
+        
+        return 0xFF;
+        
+    }
+    
+    size_t octants[4];
+    size_t corner = 0;
+    
+    for (int64_t cx : { box.min_x, box.max_x }) {
+        
+        for (int64_t cy : { box.min_y, box.max_y }) {
+            
+            octants[corner++] = octant_of(cx - x, cy - y);
+            
+        }
+        
+    }
+    
+    size_t spans[4];
+    size_t shortest = num_octants;
+    
+    for (size_t i = 0; i < 4; i++) {
+        
+        spans[i] = 0;
+        
+        for (size_t j = 0; j < 4; j++) {
+            
+            spans[i] = std::max(spans[i], (octants[j] + num_octants - octants[i]) % num_octants);
+            
+        }
+        
+        shortest = std::min(shortest, spans[i]);
+        
+    }
+    
+    uint32_t mask = 0;
+    
+    for (size_t i = 0; i < 4; i++) {
+        
+        for (size_t step = 0; spans[i] == shortest && step <= shortest; step++) {
+            
+            mask |= 1u << ((octants[i] + step) % num_octants);
+            
+        }
+        
+    }
+    
+    return mask;
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    Spill Files
+// ----------------------------------------------------------------------------
+
+// A directory of spill files, removed with everything in it on destruction
+class SpillDirectory {
+    
+public:
+    
+    explicit SpillDirectory(const std::string &parent) {
+        
+        std::string pattern = (parent.empty() ? std::string("/tmp") : parent) + "/drone-mst-XXXXXX";
+        
+        std::vector<char> name(pattern.begin(), pattern.end());
+        name.push_back('\0');
+        
+        if (mkdtemp(name.data()) == nullptr) {
+            
+            throw DroneError("Error: Cannot create a spill directory in " + parent + ". Program terminating");
+            
+        }
+        
+        path = name.data();
+        
+    }
+    
+    ~SpillDirectory() {
+        
+        for (const std::string &file : files) {
+            
+            std::remove(file.c_str());
+            
+        }
+        
+        rmdir(path.c_str());
+        
+    }
+    
+    SpillDirectory(const SpillDirectory &) = delete;
+    
+    SpillDirectory &operator=(const SpillDirectory &) = delete;
+    
+    // Path of a new spill file
+    std::string new_file(const char *kind) {
+        
+        files.push_back(path + "/" + kind + "-" + std::to_string(files.size()));
+        
+        return files.back();
+        
+    }
+    
+private:
+    
+    std::string path;
+    
+    std::vector<std::string> files;
+    
+};
+
+template <typename Record>
+class SpillWriter {
+    
+public:
+    
+    explicit SpillWriter(const std::string &filename_in)
+    : filename(filename_in), file(filename_in, std::ios::binary | std::ios::trunc) {
+        
+        if (!file) {
+            
+            throw DroneError("Error: Cannot write spill file " + filename + ". Program terminating");
+            
+        }
+        
+        buffer.reserve(buffer_records);
+        
+    }
+    
+    void push(const Record &record) {
+        
+        buffer.push_back(record);
+        
+        if (buffer.size() == buffer_records) {
+            
+            flush();
+            
+        }
+        
+    }
+    
+    // Returns the bytes written
+    uint64_t close() {
+        
+        flush();
+        
+        file.close();
+        
+        if (!file) {
+            
+            throw DroneError("Error: Cannot write spill file " + filename + ". Program terminating");
+            
+        }
+        
+        return written;
+        
+    }
+    
+private:
+    
+    void flush() {
+        
+        file.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(Record)));
+        
+        written += buffer.size() * sizeof(Record);
+        
+        buffer.clear();
+        
+    }
+    
+    std::string filename;
+    
+    std::ofstream file;
+    
+    std::vector<Record> buffer;
+    
+    uint64_t written = 0;
+    
+};
+
+template <typename Record>
+class SpillReader {
+    
+public:
+    
+    explicit SpillReader(const std::string &filename) : file(filename, std::ios::binary) {
+        
+        if (!file) {
+            
+            throw DroneError("Error: Cannot read spill file " + filename + ". Program terminating");
+            
+        }
+        
+    }
+    
+    // False at the end of the file
+    bool next(Record &record) {
+        
+        if (position == buffer.size()) {
+            
+            buffer.resize(buffer_records);
+            
+            file.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size() * sizeof(Record)));
+            
+            buffer.resize(static_cast<size_t>(file.gcount()) / sizeof(Record));
+            position = 0;
+            
+            if (buffer.empty()) {
+                
+                return false;
+                
+            }
+            
+        }
+        
+        record = buffer[position++];
+        
+        return true;
+        
+    }
+    
+private:
+    
+    std::ifstream file;
+    
+    std::vector<Record> buffer;
+    
+    size_t position = 0;
+    
+};
+
+// Union-find over count locations whose roots live in a mapped spill file
+class DiskUnionFind {
+    
+public:
+    
+    DiskUnionFind(const std::string &filename, size_t count) {
+        
+        length = std::max<size_t>(count, 1) * sizeof(uint32_t);
+        
+        fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        
+        void *mapped = (fd < 0 || ftruncate(fd, static_cast<off_t>(length)) != 0) ? MAP_FAILED :
+        mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        
+        if (mapped == MAP_FAILED) {
+            
+            if (fd >= 0) {
+                
+                ::close(fd);
+                
+            }
+            
+            throw DroneError("Error: Cannot write spill file " + filename + ". Program terminating");
+            
+        }
+        
+        roots = static_cast<uint32_t *>(mapped);
+        
+        std::iota(roots, roots + count, 0);
+        
+    }
+    
+    ~DiskUnionFind() {
+        
+        munmap(roots, length);
+        
+        ::close(fd);
+        
+    }
+    
+    DiskUnionFind(const DiskUnionFind &) = delete;
+    
+    DiskUnionFind &operator=(const DiskUnionFind &) = delete;
+    
+    // Joins the sets of a and b; false if they were already one
+    bool unite(uint32_t a, uint32_t b) {
+        
+        a = find(a);
+        b = find(b);
+        
+        if (a == b) {
+            
+            return false;
+            
+        }
+        
+        roots[std::max(a, b)] = std::min(a, b);
+        
+        return true;
+        
+    }
+    
+private:
+    
+    uint32_t find(uint32_t location) {
+        
+        // Path halving
+        while (roots[location] != location) {
+            
+            roots[location] = roots[roots[location]];
+            location = roots[location];
+            
+        }
+        
+        return location;
+        
+    }
+    
+    int fd;
+    
+    size_t length;
+    
+    uint32_t *roots;
+    
+};
+
+// ----------------------------------------------------------------------------
+//                    Tiles
+// ----------------------------------------------------------------------------
+
+struct Tile {
+    
+    std::string filename;
+    
+    uint64_t count = 0;
+    
+    // The tile owns every location with x in [x0, x1) and y in [y0, y1)
+    int64_t x0 = std::numeric_limits<int32_t>::min();
+    int64_t x1 = int64_t(std::numeric_limits<int32_t>::max()) + 1;
+    int64_t y0 = std::numeric_limits<int32_t>::min();
+    int64_t y1 = int64_t(std::numeric_limits<int32_t>::max()) + 1;
+    
+    // Bounding box and number of the locations in each zone class
+    Box class_box[2];
+    uint64_t class_count[2] = { 0, 0 };
+    
+    void add(const Coordinate &c) {
+        
+        count++;
+        
+        LocationType zone = zone_of(c);
+        
+        for (size_t k = 0; k < 2; k++) {
+            
+            if (in_zone_class(zone, k)) {
+                
+                class_box[k].extend(c);
+                class_count[k]++;
+                
+            }
+            
+        }
+        
+    }
+    
+    Box box() const {
+        
+        Box all = class_box[0];
+        
+        all.extend(class_box[1]);
+        
+        return all;
+        
+    }
+    
+};
+
+// A tile in memory: its locations in location order, and a kd-tree over a
+// copy of them for the cone searches. The tree follows clustered locations,
+// where a uniform grid sized for the tile's box would pile thousands of
+// them into one cell.
+struct LoadedTile {
+    
+    // Inner nodes have two children, leaves (child -1) hold
+    // tree_points[begin, end)
+    struct Node {
+        
+        // Bounding box of the node's locations in each zone class
+        Box class_box[2];
+        
+        uint32_t begin;
+        
+        uint32_t end;
+        
+        int32_t child[2];
+        
+    };
+    
+    std::vector<TilePoint> points;
+    
+    std::vector<TilePoint> tree_points;
+    
+    std::vector<Node> nodes;
+    
+    void load(const Tile &tile) {
+        
+        points.clear();
+        points.reserve(static_cast<size_t>(tile.count));
+        
+        SpillReader<TilePoint> reader(tile.filename);
+        TilePoint point;
+        
+        while (reader.next(point)) {
+            
+            points.push_back(point);
+            
+        }
+        
+        tree_points = points;
+        nodes.clear();
+        
+        if (!points.empty()) {
+            
+            build(0, static_cast<uint32_t>(points.size()));
+            
+        }
+        
+    }
+    
+    // Builds the subtree over tree_points[begin, end), halving at the median
+    // of the wider side; returns its node
+    int32_t build(uint32_t begin, uint32_t end) {
+        
+        Node node;
+        
+        node.begin = begin;
+        node.end = end;
+        node.child[0] = node.child[1] = -1;
+        
+        for (uint32_t i = begin; i < end; i++) {
+            
+            LocationType zone = zone_of(tree_points[i].c);
+            
+            for (size_t k = 0; k < 2; k++) {
+                
+                if (in_zone_class(zone, k)) {
+                    
+                    node.class_box[k].extend(tree_points[i].c);
+                    
+                }
+                
+            }
+            
+        }
+        
+        int32_t index = static_cast<int32_t>(nodes.size());
+        
+        nodes.push_back(node);
+        
+        Box all = node.class_box[0];
+        
+        all.extend(node.class_box[1]);
+        
+        int64_t width = all.max_x - all.min_x;
+        int64_t height = all.max_y - all.min_y;
+        
+        // Locations sharing one coordinate stay in one leaf
+        if (end - begin <= leaf_points || (width == 0 && height == 0)) {
+            
+            return index;
+            
+        }
+        
+        bool by_x = (width >= height);
+        uint32_t middle = begin + (end - begin) / 2;
+        
+        std::nth_element(tree_points.begin() + begin, tree_points.begin() + middle, tree_points.begin() + end,
+                         [by_x](const TilePoint &a, const TilePoint &b) { return by_x ? a.c.x < b.c.x : a.c.y < b.c.y; });
+        
+        int32_t low = build(begin, middle);
+        int32_t high = build(middle, end);
+        
+        nodes[static_cast<size_t>(index)].child[0] = low;
+        nodes[static_cast<size_t>(index)].child[1] = high;
+        
+        return index;
+        
+    }
+    
+};
+
+const uint32_t no_location = std::numeric_limits<uint32_t>::max();
+
+// Nearest location per (zone class, cone), by squared distance then
+// location number
+struct ConeBest {
+    
+    int64_t d2[2][num_octants];
+    
+    uint32_t id[2][num_octants];
+    
+    ConeBest() {
+        
+        for (size_t k = 0; k < 2; k++) {
+            
+            for (size_t o = 0; o < num_octants; o++) {
+                
+                d2[k][o] = std::numeric_limits<int64_t>::max();
+                id[k][o] = no_location;
+                
+            }
+            
+        }
+        
+    }
+    
+};
+
+// Squared distance from c to the nearest location of node that could still
+// beat or tie a wanted cone's best (infinity if none can)
+double node_distance(const LoadedTile::Node &node, const Coordinate &c, const bool wanted[2][num_octants],
+                     const ConeBest &best) {
+    
+    double nearest = std::numeric_limits<double>::infinity();
+    
+    for (size_t k = 0; k < 2; k++) {
+        
+        if (node.class_box[k].empty()) {
+            
+            continue;
+            
+        }
+        
+        double d2 = squared_distance_to(c.x, c.y, node.class_box[k]);
+        bool close = false;
+        
+        for (size_t o = 0; o < num_octants && !close; o++) {
+            
+            close = wanted[k][o] && may_beat(d2, best.d2[k][o]);
+            
+        }
+        
+        // Cones only once the box is close enough for some cone
+        uint32_t mask = close ? cone_mask(c.x, c.y, node.class_box[k]) : 0;
+        
+        for (size_t o = 0; o < num_octants; o++) {
+            
+            if ((mask & (1u << o)) && wanted[k][o] && may_beat(d2, best.d2[k][o])) {
+                
+                nearest = std::min(nearest, d2);
+                
+                break;
+                
+            }
+            
+        }
+        
+    }
+    
+    return nearest;
+    
+}
+
+void search_node(const LoadedTile &tile, int32_t index, const Coordinate &c, uint32_t self,
+                 const bool wanted[2][num_octants], ConeBest &best) {
+    
+    const LoadedTile::Node &node = tile.nodes[static_cast<size_t>(index)];
+    
+    if (node.child[0] < 0) {
+        
+        for (uint32_t i = node.begin; i < node.end; i++) {
+            
+            const TilePoint &point = tile.tree_points[i];
+            
+            if (point.id == self) {
+                
+                continue;
+                
+            }
+            
+            LocationType zone = zone_of(point.c);
+            size_t o = octant_of(c, point.c);
+            int64_t d2 = squared_distance(c, point.c);
+            
+            for (size_t k = 0; k < 2; k++) {
+                
+                if (wanted[k][o] && in_zone_class(zone, k) &&
+                    (d2 < best.d2[k][o] || (d2 == best.d2[k][o] && point.id < best.id[k][o]))) {
+                    
+                    best.d2[k][o] = d2;
+                    best.id[k][o] = point.id;
+                    
+                }
+                
+            }
+            
+        }
+        
+        return;
+        
+    }
+    
+    // Nearer child first; the farther one is checked again after it
+    int32_t first = node.child[0], second = node.child[1];
+    double first_d2 = node_distance(tile.nodes[static_cast<size_t>(first)], c, wanted, best);
+    double second_d2 = node_distance(tile.nodes[static_cast<size_t>(second)], c, wanted, best);
+    
+    if (second_d2 < first_d2) {
+        
+        std::swap(first, second);
+        std::swap(first_d2, second_d2);
+        
+    }
+    
+    if (first_d2 != std::numeric_limits<double>::infinity()) {
+        
+        search_node(tile, first, c, self, wanted, best);
+        
+    }
+    
+    if (second_d2 != std::numeric_limits<double>::infinity() &&
+        node_distance(tile.nodes[static_cast<size_t>(second)], c, wanted, best) != std::numeric_limits<double>::infinity()) {
+        
+        search_node(tile, second, c, self, wanted, best);
+        
+    }
+    
+}
+
+// Lowers best[k][o] for every wanted (k, o) with the locations of tile in
+// cone o of class k around c, skipping location self. Subtrees that can't
+// beat or tie a wanted cone's best, or lie outside its cone, are skipped.
+void search_cones(const LoadedTile &tile, const Coordinate &c, uint32_t self, const bool wanted[2][num_octants],
+                  ConeBest &best) {
+    
+    if (!tile.nodes.empty() && node_distance(tile.nodes[0], c, wanted, best) != std::numeric_limits<double>::infinity()) {
+        
+        search_node(tile, 0, c, self, wanted, best);
+        
+    }
+    
+}
+
+// Node of the kd-tree a split pass cuts with: locations with coordinate
+// axis below value go to child[0]. Children >= 0 are nodes, < 0 are
+// -(piece + 1).
+struct SplitNode {
+    
+    int axis;
+    
+    int64_t value;
+    
+    int32_t child[2];
+    
+};
+
+int64_t coordinate_on(const Coordinate &c, int axis) {
+    
+    return (axis == 0) ? c.x : c.y;
+    
+}
+
+// Builds the kd-tree over sample[begin, end) within piece (its cell), at
+// most depth levels deep, adding the leaves to pieces. bounds is the box the
+// cut must fall inside of so that both sides get a location (the sample's
+// own box below the root). Returns the node or leaf reference.
+int32_t build_split(std::vector<Coordinate> &sample, size_t begin, size_t end, const Tile &piece, const Box &bounds,
+                    size_t depth, std::vector<SplitNode> &nodes, std::vector<Tile> &pieces) {
+    
+    int64_t width = bounds.max_x - bounds.min_x;
+    int64_t height = bounds.max_y - bounds.min_y;
+    
+    if (depth == 0 || end - begin < 2 || (width == 0 && height == 0)) {
+        
+        pieces.push_back(piece);
+        
+        return -static_cast<int32_t>(pieces.size());
+        
+    }
+    
+    int axis = (width >= height) ? 0 : 1;
+    int64_t low = (axis == 0) ? bounds.min_x : bounds.min_y;
+    int64_t high = (axis == 0) ? bounds.max_x : bounds.max_y;
+    
+    size_t middle = begin + (end - begin) / 2;
+    
+    std::nth_element(sample.begin() + static_cast<std::ptrdiff_t>(begin), sample.begin() + static_cast<std::ptrdiff_t>(middle),
+                     sample.begin() + static_cast<std::ptrdiff_t>(end), [axis](const Coordinate &a, const Coordinate &b) {
+        
+        return coordinate_on(a, axis) < coordinate_on(b, axis);
+        
+    });
+    
+    int64_t value = std::min(std::max(coordinate_on(sample[middle], axis), low + 1), high);
+    
+    auto split = std::partition(sample.begin() + static_cast<std::ptrdiff_t>(begin), sample.begin() + static_cast<std::ptrdiff_t>(end),
+                                [axis, value](const Coordinate &c) { return coordinate_on(c, axis) < value; });
+    size_t cut = static_cast<size_t>(split - sample.begin());
+    
+    Tile halves[2] = { piece, piece };
+    
+    (axis == 0 ? halves[0].x1 : halves[0].y1) = value;
+    (axis == 0 ? halves[1].x0 : halves[1].y0) = value;
+    
+    size_t node = nodes.size();
+    nodes.push_back({ axis, value, { 0, 0 } });
+    
+    size_t ranges[3] = { begin, cut, end };
+    
+    for (size_t side = 0; side < 2; side++) {
+        
+        Box side_bounds;
+        
+        for (size_t i = ranges[side]; i < ranges[side + 1]; i++) {
+            
+            side_bounds.extend(sample[i]);
+            
+        }
+        
+        if (side_bounds.empty()) {
+            
+            side_bounds = bounds;
+            
+        }
+        
+        int32_t child = build_split(sample, ranges[side], ranges[side + 1], halves[side], side_bounds, depth - 1, nodes, pieces);
+        
+        nodes[node].child[side] = child;
+        
+    }
+    
+    return static_cast<int32_t>(node);
+    
+}
+
+// Splits tile into up to 2^max_split_depth pieces of about half of capacity
+// each (cuts from a sample of its locations, then one pass over them);
+// removes nothing, the caller drops tile's file
+void split_tile(const Tile &tile, uint64_t capacity, SpillDirectory &spill, std::vector<Tile> &pieces,
+                uint64_t &spill_bytes) {
+    
+    uint64_t wanted = (tile.count + capacity / 2 - 1) / (capacity / 2);
+    size_t depth = 1;
+    
+    while (depth < max_split_depth && (uint64_t(1) << depth) < wanted) {
+        
+        depth++;
+        
+    }
+    
+    // Random locations read in place, in file order
+    size_t sample_size = static_cast<size_t>(std::min<uint64_t>(tile.count, samples_per_piece << depth));
+    
+    std::mt19937_64 random(tile.count);
+    std::uniform_int_distribution<uint64_t> any_point(0, tile.count - 1);
+    std::vector<uint64_t> positions(sample_size);
+    
+    for (uint64_t &position : positions) {
+        
+        position = any_point(random);
+        
+    }
+    
+    std::sort(positions.begin(), positions.end());
+    
+    std::vector<Coordinate> sample(sample_size);
+    std::ifstream file(tile.filename, std::ios::binary);
+    
+    for (size_t i = 0; i < sample_size; i++) {
+        
+        TilePoint point;
+        
+        file.seekg(static_cast<std::streamoff>(positions[i] * sizeof(TilePoint)));
+        
+        if (!file.read(reinterpret_cast<char *>(&point), sizeof(point))) {
+            
+            throw DroneError("Error: Cannot read spill file " + tile.filename + ". Program terminating");
+            
+        }
+        
+        sample[i] = point.c;
+        
+    }
+    
+    file.close();
+    
+    // Cells only: counts and boxes are filled in by the pass below
+    Tile cell;
+    
+    cell.x0 = tile.x0;
+    cell.x1 = tile.x1;
+    cell.y0 = tile.y0;
+    cell.y1 = tile.y1;
+    
+    std::vector<SplitNode> nodes;
+    std::vector<Tile> cells;
+    
+    build_split(sample, 0, sample.size(), cell, tile.box(), depth, nodes, cells);
+    
+    std::vector<SpillWriter<TilePoint>> writers;
+    writers.reserve(cells.size());
+    
+    for (Tile &piece : cells) {
+        
+        piece.filename = spill.new_file("tile");
+        
+        writers.emplace_back(piece.filename);
+        
+    }
+    
+    SpillReader<TilePoint> reader(tile.filename);
+    TilePoint point;
+    
+    while (reader.next(point)) {
+        
+        int32_t at = 0;
+        
+        while (at >= 0) {
+            
+            const SplitNode &node = nodes[static_cast<size_t>(at)];
+            
+            at = node.child[coordinate_on(point.c, node.axis) < node.value ? 0 : 1];
+            
+        }
+        
+        size_t piece = static_cast<size_t>(-at - 1);
+        
+        writers[piece].push(point);
+        cells[piece].add(point.c);
+        
+    }
+    
+    for (size_t i = 0; i < cells.size(); i++) {
+        
+        spill_bytes += writers[i].close();
+        
+        if (cells[i].count > 0) {
+            
+            pieces.push_back(cells[i]);
+            
+        }
+        
+        else {
+            
+            std::remove(cells[i].filename.c_str());
+            
+        }
+        
+    }
+    
+}
+
+// Streams the locations on is into a spill file as one tile
+Tile spool_input(std::istream &is, SpillDirectory &spill, uint64_t &spill_bytes) {
+    
+    Tile root;
+    
+    root.filename = spill.new_file("tile");
+    
+    SpillWriter<TilePoint> writer(root.filename);
+    
+    auto add = [&](const Coordinate &c) {
+        
+        writer.push({ static_cast<uint32_t>(root.count), c });
+        root.add(c);
+        
+    };
+    
+    auto check_count = [](uint64_t count) {
+        
+        if (count > no_location) {
+            
+            throw DroneError("Error: The external MST numbers locations in 32 bits. Program terminating");
+            
+        }
+        
+    };
+    
+    if (is_binary_input(is)) {
+        
+        BinaryHeader header;
+        
+        if (!is.read(reinterpret_cast<char *>(&header), sizeof(header)) || std::memcmp(header.magic, "DRONEBIN", 8) != 0 ||
+            header.version != binary_version) {
+            
+            throw DroneError("Error: Invalid binary input header. Program terminating");
+            
+        }
+        
+        check_count(header.count);
+        
+        std::vector<Coordinate> chunk(buffer_records);
+        
+        for (uint64_t done = 0; done < header.count; done += chunk.size()) {
+            
+            chunk.resize(static_cast<size_t>(std::min<uint64_t>(header.count - done, buffer_records)));
+            
+            if (!is.read(reinterpret_cast<char *>(chunk.data()), static_cast<std::streamsize>(chunk.size() * sizeof(Coordinate)))) {
+                
+                throw DroneError("Error: Binary input is cut short. Program terminating");
+                
+            }
+            
+            for (const Coordinate &c : chunk) {
+                
+                add(c);
+                
+            }
+            
+        }
+        
+    }
+    
+    else {
+        
+        // Same reads as read_input()
+        int num_locations_in = 0;
+        
+        is >> num_locations_in;
+        
+        check_count(static_cast<uint64_t>(std::max(num_locations_in, 0)));
+        
+        for (int i = 0; i < num_locations_in; i++) {
+            
+            Coordinate c_in;
+            
+            is >> c_in.x >> c_in.y;
+            
+            add(c_in);
+            
+        }
+        
+    }
+    
+    spill_bytes += writer.close();
+    
+    return root;
+    
+}
+
+// Candidate edges of tile a: the minimum spanning forest of the Yao edges
+// inside it, and every Yao edge from it to another tile
+void tile_candidates(const std::vector<Tile> &tiles, size_t a, LoadedTile &own, LoadedTile &other,
+                     std::vector<TileEdge> &edges, size_t &tile_loads) {
+    
+    const Tile &tile = tiles[a];
+    
+    own.load(tile);
+    
+    size_t count = own.points.size();
+    
+    // A cone whose nearest location could be outside the tile
+    struct ConeQuery {
+        
+        uint32_t slot;
+        
+        uint8_t zone_class;
+        
+        uint8_t octant;
+        
+        int64_t best_d2;
+        
+        uint32_t best_id;
+        
+        bool outside;
+        
+    };
+    
+    std::vector<ConeQuery> queries;
+    
+    // Edges by slot: the slots are in location order, so (d2, low slot,
+    // high slot) orders them like the location numbers
+    std::vector<TileEdge> inside;
+    
+    // Slots are indices into own.points, which is in location order
+    auto slot_of = [&own](uint32_t id) {
+        
+        return static_cast<uint32_t>(std::lower_bound(own.points.begin(), own.points.end(), id,
+                                                      [](const TilePoint &p, uint32_t other) { return p.id < other; }) -
+                                     own.points.begin());
+        
+    };
+    
+    // In tree order, so consecutive searches walk the same part of the tree
+    for (const TilePoint &point : own.tree_points) {
+        
+        uint32_t i = slot_of(point.id);
+        const Coordinate &c = point.c;
+        LocationType zone = zone_of(c);
+        
+        // Medical only needs class 0 and Normal only class 1, as in the
+        // other cone searches
+        bool active[2] = { zone != LocationType::Normal, zone != LocationType::Medical };
+        bool wanted[2][num_octants];
+        
+        for (size_t k = 0; k < 2; k++) {
+            
+            std::fill(wanted[k], wanted[k] + num_octants, active[k]);
+            
+        }
+        
+        ConeBest best;
+        
+        search_cones(own, c, point.id, wanted, best);
+        
+        // Nearest distance to a location outside the cell
+        double outside = static_cast<double>(std::min({ c.x - tile.x0 + 1, tile.x1 - c.x, c.y - tile.y0 + 1, tile.y1 - c.y }));
+        
+        for (size_t k = 0; k < 2; k++) {
+            
+            for (size_t o = 0; o < num_octants && active[k]; o++) {
+                
+                if (best.id[k][o] != no_location) {
+                    
+                    inside.push_back(make_edge(best.d2[k][o], i, slot_of(best.id[k][o])));
+                    
+                }
+                
+                if (may_beat(outside * outside, best.d2[k][o])) {
+                    
+                    queries.push_back({ i, static_cast<uint8_t>(k), static_cast<uint8_t>(o),
+                                        best.d2[k][o], best.id[k][o], false });
+                    
+                }
+                
+            }
+            
+        }
+        
+    }
+    
+    // Minimum spanning forest of the inside edges (everything else inside
+    // closes a cycle of lighter edges)
+    std::sort(inside.begin(), inside.end(), edge_before);
+    
+    std::vector<uint32_t> roots(count);
+    std::iota(roots.begin(), roots.end(), 0);
+    
+    auto find = [&roots](uint32_t slot) {
+        
+        while (roots[slot] != slot) {
+            
+            roots[slot] = roots[roots[slot]];
+            slot = roots[slot];
+            
+        }
+        
+        return slot;
+        
+    };
+    
+    edges.clear();
+    
+    for (const TileEdge &edge : inside) {
+        
+        uint32_t ra = find(edge.a), rb = find(edge.b);
+        
+        if (ra != rb) {
+            
+            roots[ra] = rb;
+            
+            edges.push_back(make_edge(edge.d2, own.points[edge.a].id, own.points[edge.b].id));
+            
+        }
+        
+    }
+    
+    std::vector<TileEdge>().swap(inside);
+    std::vector<uint32_t>().swap(roots);
+    
+    // Other tiles, nearest first
+    Box own_box = tile.box();
+    std::vector<std::pair<double, size_t>> order;
+    
+    for (size_t b = 0; b < tiles.size(); b++) {
+        
+        if (b != a) {
+            
+            Box box = tiles[b].box();
+            
+            double gap_x = std::max({ static_cast<double>(box.min_x - own_box.max_x), 0.0, static_cast<double>(own_box.min_x - box.max_x) });
+            double gap_y = std::max({ static_cast<double>(box.min_y - own_box.max_y), 0.0, static_cast<double>(own_box.min_y - box.max_y) });
+            
+            order.push_back({ gap_x * gap_x + gap_y * gap_y, b });
+            
+        }
+        
+    }
+    
+    std::sort(order.begin(), order.end());
+    
+    // Per (class, cone): box of the querying locations and the farthest
+    // best distance, redone whenever a loaded tile improved the queries
+    Box query_box[2][num_octants];
+    int64_t query_d2[2][num_octants];
+    int64_t farthest = 0;
+    bool stale = true;
+    
+    for (const std::pair<double, size_t> &next : order) {
+        
+        const Tile &candidate = tiles[next.second];
+        
+        if (stale) {
+            
+            farthest = 0;
+            
+            for (size_t k = 0; k < 2; k++) {
+                
+                for (size_t o = 0; o < num_octants; o++) {
+                    
+                    query_box[k][o] = Box();
+                    query_d2[k][o] = 0;
+                    
+                }
+                
+            }
+            
+            for (const ConeQuery &query : queries) {
+                
+                query_box[query.zone_class][query.octant].extend(own.points[query.slot].c);
+                query_d2[query.zone_class][query.octant] = std::max(query_d2[query.zone_class][query.octant], query.best_d2);
+                farthest = std::max(farthest, query.best_d2);
+                
+            }
+            
+            stale = false;
+            
+        }
+        
+        if (!may_beat(next.first, farthest)) {
+            
+            break;
+            
+        }
+        
+        // A location of the candidate in some query's cone, close enough:
+        // the vectors from the query box to the class box form a box too
+        bool needed = false;
+        
+        for (size_t k = 0; k < 2 && !needed; k++) {
+            
+            for (size_t o = 0; o < num_octants && !needed; o++) {
+                
+                if (query_box[k][o].empty() || candidate.class_count[k] == 0) {
+                    
+                    continue;
+                    
+                }
+                
+                const Box &box = candidate.class_box[k];
+                Box offsets;
+                
+                offsets.min_x = box.min_x - query_box[k][o].max_x;
+                offsets.max_x = box.max_x - query_box[k][o].min_x;
+                offsets.min_y = box.min_y - query_box[k][o].max_y;
+                offsets.max_y = box.max_y - query_box[k][o].min_y;
+                
+                needed = may_beat(squared_distance_to(0, 0, offsets), query_d2[k][o]) && (cone_mask(0, 0, offsets) & (1u << o));
+                
+            }
+            
+        }
+        
+        if (!needed) {
+            
+            continue;
+            
+        }
+        
+        other.load(candidate);
+        tile_loads++;
+        
+        // Queries of one location are consecutive, so each location
+        // searches the candidate once for all its cones
+        for (size_t q = 0; q < queries.size(); ) {
+            
+            uint32_t slot = queries[q].slot;
+            const Coordinate &c = own.points[slot].c;
+            
+            size_t end = q;
+            bool wanted[2][num_octants] = {};
+            bool any = false;
+            ConeBest best;
+            
+            for (; end < queries.size() && queries[end].slot == slot; end++) {
+                
+                const ConeQuery &query = queries[end];
+                size_t k = query.zone_class, o = query.octant;
+                
+                if (candidate.class_count[k] > 0 &&
+                    may_beat(squared_distance_to(c.x, c.y, candidate.class_box[k]), query.best_d2) &&
+                    (cone_mask(c.x, c.y, candidate.class_box[k]) & (1u << o))) {
+                    
+                    wanted[k][o] = true;
+                    best.d2[k][o] = query.best_d2;
+                    best.id[k][o] = query.best_id;
+                    
+                    any = true;
+                    
+                }
+                
+            }
+            
+            if (any) {
+                
+                search_cones(other, c, own.points[slot].id, wanted, best);
+                
+                for (; q < end; q++) {
+                    
+                    ConeQuery &query = queries[q];
+                    size_t k = query.zone_class, o = query.octant;
+                    
+                    if (wanted[k][o] && best.id[k][o] != query.best_id) {
+                        
+                        query.best_d2 = best.d2[k][o];
+                        query.best_id = best.id[k][o];
+                        query.outside = true;
+                        
+                        stale = true;
+                        
+                    }
+                    
+                }
+                
+            }
+            
+            q = end;
+            
+        }
+        
+    }
+    
+    for (const ConeQuery &query : queries) {
+        
+        if (query.outside) {
+            
+            edges.push_back(make_edge(query.best_d2, own.points[query.slot].id, query.best_id));
+            
+        }
+        
+    }
+    
+    std::sort(edges.begin(), edges.end(), edge_before);
+    
+    edges.erase(std::unique(edges.begin(), edges.end(), [](const TileEdge &e, const TileEdge &f) {
+        
+        return e.a == f.a && e.b == f.b;
+        
+    }), edges.end());
+    
+}
+
+}
+
+// ----------------------------------------------------------------------------
+//                    External MST
+// ----------------------------------------------------------------------------
+
+double external_mst_weight(std::istream &is, uint64_t memory_bytes, const std::string &spill_dir,
+                           ExternalMSTStats *stats) {
+    
+    ExternalMSTStats local_stats;
+    ExternalMSTStats &counts = (stats != nullptr) ? *stats : local_stats;
+    
+    counts = ExternalMSTStats();
+    
+    uint64_t capacity = std::max(min_tile_points, memory_bytes / bytes_per_point);
+    uint64_t spill_bytes = 0;
+    
+    SpillDirectory spill(spill_dir);
+    
+    Tile root;
+    
+    {
+        PHASE_TIMER("external_mst_spool");
+        
+        root = spool_input(is, spill, spill_bytes);
+    }
+    
+    uint64_t count = root.count;
+    
+    if (count < 2) {
+        
+        return 0;
+        
+    }
+    
+    std::vector<Tile> tiles;
+    
+    {
+        PHASE_TIMER("external_mst_split");
+        
+        std::vector<Tile> pending(1, root);
+        
+        while (!pending.empty()) {
+            
+            std::vector<Tile> oversized;
+            
+            for (Tile &tile : pending) {
+                
+                Box box = tile.box();
+                
+                // Locations sharing one coordinate can't be cut apart
+                bool one_point = (box.min_x == box.max_x && box.min_y == box.max_y);
+                
+                if (tile.count <= capacity || one_point) {
+                    
+                    tiles.push_back(tile);
+                    
+                }
+                
+                else {
+                    
+                    oversized.push_back(tile);
+                    
+                }
+                
+            }
+            
+            pending.clear();
+            
+            if (!oversized.empty()) {
+                
+                counts.split_passes++;
+                
+            }
+            
+            for (const Tile &tile : oversized) {
+                
+                split_tile(tile, capacity, spill, pending, spill_bytes);
+                
+                std::remove(tile.filename.c_str());
+                
+            }
+            
+        }
+    }
+    
+    counts.num_tiles = tiles.size();
+    counts.spill_bytes = spill_bytes;
+    
+    for (const Tile &tile : tiles) {
+        
+        counts.largest_tile = std::max(counts.largest_tile, tile.count);
+        
+    }
+    
+    // One sorted run of candidate edges per tile
+    std::vector<std::string> runs;
+    
+    {
+        PHASE_TIMER("external_mst_tiles");
+        
+        LoadedTile own, other;
+        std::vector<TileEdge> edges;
+        
+        for (size_t a = 0; a < tiles.size(); a++) {
+            
+            tile_candidates(tiles, a, own, other, edges, counts.tile_loads);
+            
+            runs.push_back(spill.new_file("run"));
+            
+            SpillWriter<TileEdge> writer(runs.back());
+            
+            for (const TileEdge &edge : edges) {
+                
+                writer.push(edge);
+                
+            }
+            
+            spill_bytes += writer.close();
+            counts.run_edges += edges.size();
+            
+        }
+    }
+    
+    PHASE_TIMER("external_mst_merge");
+    
+    // Kruskal over the runs merged in edge order
+    std::vector<SpillReader<TileEdge>> readers;
+    readers.reserve(runs.size());
+    
+    auto later = [](const std::pair<TileEdge, size_t> &e, const std::pair<TileEdge, size_t> &f) {
+        
+        return edge_before(f.first, e.first);
+        
+    };
+    
+    std::priority_queue<std::pair<TileEdge, size_t>, std::vector<std::pair<TileEdge, size_t>>, decltype(later)> heads(later);
+    
+    for (size_t r = 0; r < runs.size(); r++) {
+        
+        readers.emplace_back(runs[r]);
+        
+        TileEdge edge;
+        
+        if (readers[r].next(edge)) {
+            
+            heads.push({ edge, r });
+            
+        }
+        
+    }
+    
+    DiskUnionFind components(spill.new_file("roots"), static_cast<size_t>(count));
+    
+    double total_weight = 0;
+    uint64_t joined = 0;
+    
+    while (!heads.empty() && joined + 1 < count) {
+        
+        std::pair<TileEdge, size_t> head = heads.top();
+        heads.pop();
+        
+        if (components.unite(head.first.a, head.first.b)) {
+            
+            total_weight += squared_length(head.first.d2);
+            joined++;
+            
+        }
+        
+        TileEdge edge;
+        
+        if (readers[head.second].next(edge)) {
+            
+            heads.push({ edge, head.second });
+            
+        }
+        
+    }
+    
+    // Medical and Normal locations without a Border location to join them
+    if (joined + 1 < count) {
+        
+        throw DroneError("Error: No closest location found. Program terminating");
+        
+    }
+    
+    return total_weight;
+    
+}
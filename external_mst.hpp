@@ -0,0 +1,95 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  external_mst.hpp
+//  project4
+//
+//  Out-of-core MST weight (--memory-limit), for inputs that don't fit in
+//  memory as coordinates plus Prim's vectors. Only a tile or two of
+//  locations is ever loaded; everything else lives in spill files.
+//
+//  1. The input is streamed once into a spill file of (location, x, y).
+//  2. Tiles holding more than the memory limit allows are split on disk:
+//     a random sample picks kd-tree cuts (up to 256 pieces per pass) and one
+//     pass writes each location to its piece.
+//  3. Per tile, every location finds the nearest location of each zone
+//     class in each of its 8 cones (the Yao graph, which contains the MST,
+//     see octant_of()). Cones whose nearest location could lie outside the
+//     tile search the other tiles whose bounding boxes reach into the cone,
+//     nearest tiles first, one loaded at a time. The searches run on a
+//     kd-tree per loaded tile, pruning subtrees that are too far away or
+//     outside the cone. The tile keeps the minimum spanning forest of its
+//     own candidate edges plus the edges that cross to other tiles, sorted
+//     into a run file.
+//  4. The runs are merged in edge order into Kruskal, with the union-find
+//     in a memory-mapped file.
+//
+//  Edges are ordered by exact squared distance, then location numbers, at
+//  every step, so the total is exactly the MST weight (it may differ from
+//  Prim's in the last bits of the sum only, which follows edge order).
+//
+//  The ceiling is an estimate of the working set per loaded location, so
+//  treat it as approximate; the kernel's page cache for the spill files and
+//  the mapped union-find come on top. A tile whose locations all share one
+//  coordinate can't be split and may exceed it. Text input is parsed with
+//  >> like read_input(), so for very large inputs the binary format
+//  (tools/text_to_binary.cpp) saves most of the first pass.
+//
+//  Measured with bench/bench_external_mst.cpp (1M locations, one core,
+//  spill files on local disk; Borůvka in memory for comparison):
+//
+//      limit       tiles   uniform   clustered
+//      1 MB        256     6.6 s     9.2 s
+//      16 MB       32      7.6 s     7.7 s
+//      256 MB      1       8.1 s     7.6 s
+//      boruvka             2.8 s     71 s
+//
+//  Peak memory of ./drone -m MST on 1M uniform locations (text input):
+//  21 MB with --memory-limit 4, 71 MB with 64, 116 MB for --mst-engine
+//  boruvka. The tiles' kd-trees follow clustered locations, where
+//  Borůvka's uniform grid piles them into a few cells.
+//
+
+#ifndef EXTERNAL_MST_HPP
+#define EXTERNAL_MST_HPP
+
+#include "drone.hpp"
+#include <cstdint>
+#include <istream>
+#include <string>
+
+
+// ----------------------------------------------------------------------------
+//                    External MST
+// ----------------------------------------------------------------------------
+
+struct ExternalMSTStats {
+
+    size_t num_tiles = 0;
+
+    // Locations in the largest tile
+    uint64_t largest_tile = 0;
+
+    // Passes over spill data splitting oversized tiles
+    size_t split_passes = 0;
+
+    // Other tiles loaded by the cross-tile cone searches
+    size_t tile_loads = 0;
+
+    // Edges in the run files (tile forests plus cross-tile candidates)
+    uint64_t run_edges = 0;
+
+    // Bytes written to tile spill files (the input spool and split passes)
+    uint64_t spill_bytes = 0;
+
+};
+
+// Total weight of the MST of the locations on is (text or binary, as
+// read_input() takes them), keeping about memory_bytes of locations and
+// edges in memory. Spill files go in a new directory under spill_dir and
+// are removed before returning. Throws the same DroneError as the other
+// engines when the locations can't be spanned, and one naming the file if
+// a spill file can't be written.
+double external_mst_weight(std::istream &is, uint64_t memory_bytes, const std::string &spill_dir,
+                           ExternalMSTStats *stats = nullptr);
+
+#endif /* EXTERNAL_MST_HPP */
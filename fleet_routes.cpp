@@ -0,0 +1,210 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  fleet_routes.cpp
+//  project4
+//
+
+#include "fleet_routes.hpp"
+#include "phase_timer.hpp"
+#include "spatial.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+
+namespace {
+
+const double full_turn = 2 * std::acos(-1.0);
+
+double distance_between(const Coordinate &a, const Coordinate &b) {
+    
+    return squared_length(squared_distance(a, b));
+    
+}
+
+// Solves the route over the depot and members (location numbers); route.path
+// starts at the depot
+void solve_route(const Coordinate *coords, const size_t *members, size_t size, Drone &drone,
+                 std::vector<Coordinate> &local, TourResult &route) {
+    
+    route.path.assign(1, 0);
+    route.path.insert(route.path.end(), members, members + size);
+    
+    // Too few for FASTTSP/OPTTSP: out and back
+    if (size < 2) {
+        
+        route.total_distance = (size == 0) ? 0 : 2 * distance_between(coords[0], coords[members[0]]);
+        
+        return;
+        
+    }
+    
+    local.resize(size + 1);
+    
+    for (size_t i = 0; i <= size; i++) {
+        
+        local[i] = coords[route.path[i]];
+        
+    }
+    
+    const TourResult &solved = (size + 1 <= fleet_max_exact_locations) ? drone.solve_opt_tsp(local.data(), size + 1)
+    : drone.solve_fast_tsp(local.data(), size + 1);
+    
+    route.total_distance = solved.total_distance;
+    
+    // solved.path starts at local 0, the depot
+    for (size_t i = 0; i <= size; i++) {
+        
+        route.path[i] = (solved.path[i] == 0) ? 0 : members[solved.path[i] - 1];
+        
+    }
+    
+}
+
+}
+
+// ----------------------------------------------------------------------------
+//                    Fleet Routes Definitions
+// ----------------------------------------------------------------------------
+
+void fleet_tsp(const Coordinate *coords, size_t count, size_t num_drones, Precision precision,
+               FleetResult &result, size_t num_threads) {
+    
+    if (count == 0 || num_drones == 0) {
+        
+        throw DroneError("Error: Multi-drone routes need at least 1 location and 1 drone. Program terminating");
+        
+    }
+    
+    if (num_threads == 0) {
+        
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+        
+    }
+    
+    const Coordinate &depot = coords[0];
+    
+    // Everything but the depot, by angle around it (then distance, number)
+    std::vector<size_t> order;
+    std::vector<double> angles(count);
+    
+    {
+        PHASE_TIMER("fleet_partition");
+        
+        for (size_t i = 1; i < count; i++) {
+            
+            angles[i] = std::atan2(static_cast<double>(coords[i].y) - depot.y, static_cast<double>(coords[i].x) - depot.x);
+            
+            order.push_back(i);
+            
+        }
+        
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            
+            if (angles[a] != angles[b]) {
+                
+                return angles[a] < angles[b];
+                
+            }
+            
+            int64_t da = squared_distance(depot, coords[a]);
+            int64_t db = squared_distance(depot, coords[b]);
+            
+            return (da != db) ? (da < db) : (a < b);
+            
+        });
+        
+        // Start after the widest gap, so no sector wraps across a busy angle
+        size_t start = 0;
+        
+        double widest_gap = -1;
+        
+        for (size_t i = 0; i < order.size(); i++) {
+            
+            double gap = (i == 0) ? angles[order[0]] + full_turn - angles[order.back()] : angles[order[i]] - angles[order[i - 1]];
+            
+            if (gap > widest_gap) {
+                
+                widest_gap = gap;
+                start = i;
+                
+            }
+            
+        }
+        
+        std::rotate(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(start), order.end());
+    }
+    
+    result.routes.assign(num_drones, TourResult());
+    
+    {
+        PHASE_TIMER("fleet_routes");
+        
+        std::atomic<size_t> next_route(0);
+        
+        auto worker = [&]() {
+            
+            Drone drone;
+            
+            drone.set_precision(precision);
+            
+            std::vector<Coordinate> local;
+            
+            for (size_t d = next_route++; d < num_drones; d = next_route++) {
+                
+                size_t first = d * order.size() / num_drones;
+                size_t last = (d + 1) * order.size() / num_drones;
+                
+                solve_route(coords, order.data() + first, last - first, drone, local, result.routes[d]);
+                
+            }
+            
+        };
+        
+        std::vector<std::thread> threads;
+        
+        for (size_t t = 1; t < num_threads && t < num_drones; t++) {
+            
+            threads.emplace_back(worker);
+            
+        }
+        
+        worker();
+        
+        for (std::thread &thread : threads) {
+            
+            thread.join();
+            
+        }
+    }
+    
+    result.makespan = 0;
+    
+    for (const TourResult &route : result.routes) {
+        
+        result.makespan = std::max(result.makespan, route.total_distance);
+        
+    }
+    
+}
+
+void FLEET_print(std::ostream &os, const FleetResult &result) {
+    
+    for (size_t d = 0; d < result.routes.size(); d++) {
+        
+        os << "Drone " << (d + 1) << ": " << result.routes[d].total_distance << "\n";
+        
+        for (size_t location : result.routes[d].path) {
+            
+            os << location << " ";
+            
+        }
+        
+        os << "\n";
+        
+    }
+    
+    os << "Makespan: " << result.makespan << "\n";
+    
+}
@@ -0,0 +1,51 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  fleet_routes.hpp
+//  project4
+//
+//  Splits the locations between several drones that all start and end at
+//  the depot (location 0). The other locations are sorted by angle around
+//  the depot, starting after the widest empty sector, and cut into runs of
+//  equal size, one per drone. Each route is then solved on its own thread:
+//  OPTTSP when it is small enough for genPerms(), FASTTSP otherwise.
+//
+//  Routes are balanced by location count, not length; the makespan (the
+//  longest route) is what the fleet waits for.
+//
+
+#ifndef FLEET_ROUTES_HPP
+#define FLEET_ROUTES_HPP
+
+#include "drone.hpp"
+#include <ostream>
+#include <vector>
+
+
+// ----------------------------------------------------------------------------
+//                    Fleet Routes
+// ----------------------------------------------------------------------------
+
+struct FleetResult {
+
+    // Length of the longest route
+    double makespan = 0;
+
+    // One route per drone, each starting at the depot (location 0) with the
+    // closing edge back to it implied; an idle drone's route is just {0}
+    std::vector<TourResult> routes;
+
+};
+
+// Routes with at most this many locations (depot included) are solved
+// exactly
+const size_t fleet_max_exact_locations = 11;
+
+// num_drones routes over the locations, solved on num_threads threads (0:
+// one per core). Throws DroneError if there are no locations or drones.
+void fleet_tsp(const Coordinate *coords, size_t count, size_t num_drones, Precision precision,
+               FleetResult &result, size_t num_threads = 0);
+
+// "Drone k: length" and the route for every drone, then "Makespan: length"
+void FLEET_print(std::ostream &os, const FleetResult &result);
+
+#endif /* FLEET_ROUTES_HPP */
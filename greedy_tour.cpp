@@ -0,0 +1,430 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  greedy_tour.cpp
+//  project4
+//
+
+#include "greedy_tour.hpp"
+#include "neighbor_graph.hpp"
+#include "phase_timer.hpp"
+#include "spatial.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+namespace {
+
+// Candidate neighbors per location
+const size_t num_neighbors = 10;
+
+const uint32_t no_location = std::numeric_limits<uint32_t>::max();
+
+struct CandidateEdge {
+    
+    int64_t squared;
+    
+    uint32_t a, b;
+    
+};
+
+uint32_t find_root(std::vector<uint32_t> &uf_parent, uint32_t x) {
+    
+    while (uf_parent[x] != x) {
+        
+        uf_parent[x] = uf_parent[uf_parent[x]];
+        x = uf_parent[x];
+        
+    }
+    
+    return x;
+    
+}
+
+// links[2 v], links[2 v + 1] = v's neighbors on its fragment (no_location
+// if fewer than 2)
+void link(std::vector<uint32_t> &links, uint32_t a, uint32_t b) {
+    
+    links[2 * a + (links[2 * a] != no_location)] = b;
+    links[2 * b + (links[2 * b] != no_location)] = a;
+    
+}
+
+// Removes the edge (a, b), keeping a location's remaining neighbor first
+void cut(std::vector<uint32_t> &links, uint32_t a, uint32_t b) {
+    
+    for (uint32_t v : { a, b }) {
+        
+        uint32_t w = (v == a) ? b : a;
+        
+        if (links[2 * v] == w) {
+            
+            links[2 * v] = links[2 * v + 1];
+            
+        }
+        
+        links[2 * v + 1] = no_location;
+        
+    }
+    
+}
+
+// Follows a fragment from v (an end, or any location when just looking for
+// an end) until it stops; returns the location it stops at
+uint32_t walk_to_end(const std::vector<uint32_t> &links, uint32_t v) {
+    
+    uint32_t prev = no_location;
+    
+    while (true) {
+        
+        uint32_t next = (links[2 * v] != prev) ? links[2 * v] : links[2 * v + 1];
+        
+        if (next == no_location) {
+            
+            return v;
+            
+        }
+        
+        prev = v;
+        v = next;
+        
+    }
+    
+}
+
+// Fragment ends of one group, for the nearest-end search
+struct FragmentEnds {
+    
+    PointGrid grid;
+    
+    size_t num_fragments = 0;
+    
+};
+
+// Joins tail to the nearest fragment end in ends and continues from that
+// fragment's other end until no fragment is left; returns the last end
+uint32_t join_nearest_ends(const Coordinate *coords, std::vector<uint32_t> &links,
+                           const std::vector<uint32_t> &other_end, FragmentEnds &ends, uint32_t tail) {
+    
+    for (; ends.num_fragments > 0; ends.num_fragments--) {
+        
+        uint32_t nearest = no_location;
+        int64_t nearest_squared = std::numeric_limits<int64_t>::max();
+        
+        auto visit = [&](uint32_t e) {
+            
+            int64_t squared = squared_distance(coords[tail], coords[e]);
+            
+            if (squared < nearest_squared || (squared == nearest_squared && e < nearest)) {
+                
+                nearest_squared = squared;
+                nearest = e;
+                
+            }
+            
+        };
+        
+        ends.grid.visit_rings(coords[tail], visit, [&](int64_t ring) {
+            
+            double bound = ends.grid.ring_lower_bound(ring);
+            
+            return nearest != no_location && bound * bound >= squared_value(nearest_squared);
+            
+        });
+        
+        uint32_t far_end = other_end[nearest];
+        
+        ends.grid.remove(nearest, coords[nearest]);
+        ends.grid.remove(far_end, coords[far_end]);
+        
+        link(links, tail, nearest);
+        
+        tail = far_end;
+        
+    }
+    
+    return tail;
+    
+}
+
+}
+
+// ----------------------------------------------------------------------------
+//                    Greedy Edge Tour
+// ----------------------------------------------------------------------------
+
+void greedy_edge_tour(const Coordinate *coords, size_t count, bool zones, TourResult &result) {
+    
+    if (count < 3) {
+        
+        throw DroneError("Error: FASTTSP needs at least 3 locations. Program terminating");
+        
+    }
+    
+    PHASE_TIMER("greedy_edge");
+    
+    std::vector<uint32_t> links(2 * count, no_location);
+    
+    {
+        NeighborGraph graph;
+        
+        graph.build(coords, count, num_neighbors, zones);
+        
+        std::vector<CandidateEdge> candidates;
+        
+        candidates.reserve(graph.num_edges());
+        
+        for (uint32_t v = 0; v < count; v++) {
+            
+            for (const uint32_t *w = graph.begin(v); w != graph.end(v); w++) {
+                
+                candidates.push_back({ squared_distance(coords[v], coords[*w]), std::min(v, *w), std::max(v, *w) });
+                
+            }
+            
+        }
+        
+        // Ties by location numbers, so the tour doesn't depend on the
+        // neighbor order; an edge listed by both its locations appears twice
+        auto shorter = [](const CandidateEdge &e1, const CandidateEdge &e2) {
+            
+            if (e1.squared != e2.squared) {
+                
+                return e1.squared < e2.squared;
+                
+            }
+            
+            return (e1.a != e2.a) ? e1.a < e2.a : e1.b < e2.b;
+            
+        };
+        
+        std::sort(candidates.begin(), candidates.end(), shorter);
+        
+        std::vector<uint32_t> uf_parent(count);
+        std::vector<uint8_t> degree(count, 0);
+        
+        for (uint32_t v = 0; v < count; v++) {
+            
+            uf_parent[v] = v;
+            
+        }
+        
+        size_t num_kept = 0;
+        
+        for (const CandidateEdge &e : candidates) {
+            
+            if (degree[e.a] == 2 || degree[e.b] == 2) {
+                
+                continue;
+                
+            }
+            
+            uint32_t root_a = find_root(uf_parent, e.a);
+            uint32_t root_b = find_root(uf_parent, e.b);
+            
+            if (root_a == root_b) {
+                
+                continue;
+                
+            }
+            
+            uf_parent[root_a] = root_b;
+            
+            link(links, e.a, e.b);
+            
+            degree[e.a]++;
+            degree[e.b]++;
+            
+            // A single path through everything
+            if (++num_kept == count - 1) {
+                
+                break;
+                
+            }
+            
+        }
+        
+    }
+    
+    // Medical and Normal locations both present: the tour crosses between
+    // them at two Border locations b1 and b2 (the ones nearest the origin,
+    // where the zones meet) like SFCTSP's, and is built as b1, the Medical
+    // side (Medical and the other Border locations), b2, the Normal side
+    uint32_t b1 = no_location, b2 = no_location;
+    
+    std::vector<uint8_t> normal(count, 0);
+    
+    if (zones) {
+        
+        bool any_medical = false;
+        
+        std::vector<uint32_t> borders;
+        
+        for (uint32_t v = 0; v < count; v++) {
+            
+            LocationType type = zone_of(coords[v]);
+            
+            any_medical |= (type == LocationType::Medical);
+            normal[v] = (type == LocationType::Normal);
+            
+            if (type == LocationType::Border) {
+                
+                borders.push_back(v);
+                
+            }
+            
+        }
+        
+        bool any_normal = std::find(normal.begin(), normal.end(), 1) != normal.end();
+        
+        if (!any_medical || !any_normal) {
+            
+            std::fill(normal.begin(), normal.end(), 0);
+            
+        }
+        
+        else {
+            
+            if (borders.size() < 2) {
+                
+                throw DroneError("Error: FASTTSP needs at least 2 Border locations to join Medical and Normal locations. Program terminating");
+                
+            }
+            
+            auto nearer_origin = [&](uint32_t a, uint32_t b) {
+                
+                return squared_distance(coords[a], { 0, 0 }) < squared_distance(coords[b], { 0, 0 }) ||
+                (squared_distance(coords[a], { 0, 0 }) == squared_distance(coords[b], { 0, 0 }) && a < b);
+                
+            };
+            
+            std::partial_sort(borders.begin(), borders.begin() + 2, borders.end(), nearer_origin);
+            
+            b1 = borders[0];
+            b2 = borders[1];
+            
+            // b1 and b2 stand alone, and only Normal locations stay on the
+            // fragments holding Normal locations
+            for (uint32_t v = 0; v < count; v++) {
+                
+                for (int slot = 1; slot >= 0; slot--) {
+                    
+                    uint32_t w = links[2 * v + static_cast<uint32_t>(slot)];
+                    
+                    if (w != no_location && (v == b1 || v == b2 || (normal[v] && !normal[w]))) {
+                        
+                        cut(links, v, w);
+                        
+                    }
+                    
+                }
+                
+            }
+            
+        }
+        
+    }
+    
+    // other_end[e] for every fragment end e (a lone location is both ends);
+    // group 1 is the Normal side
+    std::vector<uint32_t> other_end(count, no_location);
+    
+    std::vector<Coordinate> end_coords[2];
+    
+    for (uint32_t v = 0; v < count; v++) {
+        
+        if (links[2 * v + 1] == no_location && other_end[v] == no_location) {
+            
+            uint32_t end = walk_to_end(links, v);
+            
+            other_end[v] = end;
+            other_end[end] = v;
+            
+            end_coords[normal[v]].push_back(coords[v]);
+            
+            if (end != v) {
+                
+                end_coords[normal[v]].push_back(coords[end]);
+                
+            }
+            
+        }
+        
+    }
+    
+    FragmentEnds ends[2];
+    
+    for (size_t group = 0; group < 2; group++) {
+        
+        ends[group].grid.reset(end_coords[group].data(), end_coords[group].size(), 2.0);
+        
+    }
+    
+    for (uint32_t v = 0; v < count; v++) {
+        
+        if (other_end[v] != no_location) {
+            
+            ends[normal[v]].grid.insert(v, coords[v]);
+            
+            // Counted once, from the smaller end
+            ends[normal[v]].num_fragments += (v <= other_end[v]);
+            
+        }
+        
+    }
+    
+    auto take = [&](uint32_t end) {
+        
+        FragmentEnds &group = ends[normal[end]];
+        
+        group.grid.remove(end, coords[end]);
+        group.grid.remove(other_end[end], coords[other_end[end]]);
+        
+        group.num_fragments--;
+        
+    };
+    
+    if (b1 == no_location) {
+        
+        // One group: the path grows from location 0's fragment
+        uint32_t start = (links[1] == no_location) ? 0 : walk_to_end(links, 0);
+        
+        take(start);
+        
+        link(links, join_nearest_ends(coords, links, other_end, ends[0], other_end[start]), start);
+        
+    }
+    
+    else {
+        
+        take(b1);
+        take(b2);
+        
+        link(links, join_nearest_ends(coords, links, other_end, ends[0], b1), b2);
+        link(links, join_nearest_ends(coords, links, other_end, ends[1], b2), b1);
+        
+    }
+    
+    // Same form as the other engines: from location 0, summed along the way
+    result.path.clear();
+    result.path.reserve(count);
+    
+    result.total_distance = 0;
+    
+    uint32_t prev = links[1], v = 0;
+    
+    do {
+        
+        result.path.push_back(v);
+        
+        uint32_t next = (links[2 * v] != prev) ? links[2 * v] : links[2 * v + 1];
+        
+        result.total_distance += squared_length(squared_distance(coords[v], coords[next]));
+        
+        prev = v;
+        v = next;
+        
+    } while (v != 0);
+    
+}
@@ -0,0 +1,50 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  greedy_tour.hpp
+//  project4
+//
+//  Greedy-edge (matching style) FASTTSP construction:
+//
+//      1. candidates: the k nearest neighbors of every location
+//         (NeighborGraph), sorted by length
+//      2. greedy: shortest first, an edge is kept if both its locations
+//         still have degree < 2 and it joins two different fragments
+//         (union-find), so the kept edges form vertex-disjoint paths
+//      3. close: starting from location 0's fragment, the current end is
+//         joined to the nearest end of a fragment not used yet (grid of
+//         fragment ends) until one path remains, then the path is closed
+//
+//  With zones on, Medical and Normal locations are never joined (the
+//  get_distance() rule in MST mode). They are not each other's candidates,
+//  and when both kinds are present the fragments are closed the way SFCTSP
+//  crosses: two Border locations b1, b2 are taken off their fragments, the
+//  Medical side is chained from b1 to b2 and the Normal side from b2 back
+//  to b1. FASTTSP locations have no zone, so the Drone builds without them.
+//
+//  Measured with bench/bench_insertion.cpp (length against
+//  arbitrary insertion):
+//
+//      locations   uniform             clustered
+//      20k         0.05 s  +2.1%       0.07 s  +6.3%
+//      200k        0.62 s              0.85 s
+//
+//  Candidate edges take 16 bytes each (10 per location) while building.
+//
+
+#ifndef GREEDY_TOUR_HPP
+#define GREEDY_TOUR_HPP
+
+#include "drone.hpp"
+
+
+// ----------------------------------------------------------------------------
+//                    Greedy Edge Tour
+// ----------------------------------------------------------------------------
+
+// Fills result like Drone::solve_fast_tsp() (path from location 0, total
+// summed along it). Throws DroneError for fewer than 3 locations, or with
+// zones on if Medical and Normal locations are present with fewer than 2
+// Border locations.
+void greedy_edge_tour(const Coordinate *coords, size_t count, bool zones, TourResult &result);
+
+#endif /* GREEDY_TOUR_HPP */
@@ -0,0 +1,237 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  indexed_heap.hpp
+//  project4
+//
+//  Binary min-heap over ids 0 .. capacity - 1 that remembers where each id
+//  sits, so an id's key can be raised or lowered in place (O(log n)) instead
+//  of pushing a duplicate and skipping stale entries later. Ties go to the
+//  smaller id, so the order never depends on insertion history.
+//
+
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// ----------------------------------------------------------------------------
+//                    IndexedHeap Declarations
+// ----------------------------------------------------------------------------
+
+template <typename Key>
+class IndexedHeap {
+
+public:
+
+    // Empties the heap; ids must be below capacity
+    void reset(size_t capacity);
+
+    bool empty() const;
+
+    size_t size() const;
+
+    bool contains(uint32_t id) const;
+
+    // Id with the smallest key
+    uint32_t top() const;
+
+    const Key &get_key(uint32_t id) const;
+
+    // Id in heap slot (0 .. size() - 1); slot 0 is the top and no id's key is
+    // smaller than the key in slot (slot - 1) / 2
+    uint32_t at(size_t slot) const;
+
+    // Inserts id, or moves it to its new key if it is already in the heap
+    void push_or_update(uint32_t id, const Key &key);
+
+    void pop();
+
+private:
+
+    static constexpr uint32_t absent = UINT32_MAX;
+
+    bool before(uint32_t a, uint32_t b) const;
+
+    void sift_up(size_t slot);
+
+    void sift_down(size_t slot);
+
+    void place(size_t slot, uint32_t id);
+
+    std::vector<uint32_t> heap;
+
+    // position[id] = slot of id in heap (absent if not in it)
+    std::vector<uint32_t> position;
+
+    std::vector<Key> keys;
+
+};
+
+// ----------------------------------------------------------------------------
+//                    IndexedHeap Template Definitions
+// ----------------------------------------------------------------------------
+
+template <typename Key>
+void IndexedHeap<Key>::reset(size_t capacity) {
+
+    heap.clear();
+
+    position.assign(capacity, absent);
+
+    keys.resize(capacity);
+
+}
+
+template <typename Key>
+bool IndexedHeap<Key>::empty() const {
+
+    return heap.empty();
+
+}
+
+template <typename Key>
+size_t IndexedHeap<Key>::size() const {
+
+    return heap.size();
+
+}
+
+template <typename Key>
+bool IndexedHeap<Key>::contains(uint32_t id) const {
+
+    return position[id] != absent;
+
+}
+
+template <typename Key>
+uint32_t IndexedHeap<Key>::top() const {
+
+    return heap.front();
+
+}
+
+template <typename Key>
+const Key &IndexedHeap<Key>::get_key(uint32_t id) const {
+
+    return keys[id];
+
+}
+
+template <typename Key>
+uint32_t IndexedHeap<Key>::at(size_t slot) const {
+
+    return heap[slot];
+
+}
+
+template <typename Key>
+void IndexedHeap<Key>::push_or_update(uint32_t id, const Key &key) {
+
+    keys[id] = key;
+
+    if (position[id] == absent) {
+
+        heap.push_back(id);
+        position[id] = static_cast<uint32_t>(heap.size() - 1);
+
+    }
+
+    // Only one of these moves anything
+    sift_up(position[id]);
+    sift_down(position[id]);
+
+}
+
+template <typename Key>
+void IndexedHeap<Key>::pop() {
+
+    position[heap.front()] = absent;
+
+    uint32_t last = heap.back();
+
+    heap.pop_back();
+
+    if (!heap.empty()) {
+
+        place(0, last);
+
+        sift_down(0);
+
+    }
+
+}
+
+template <typename Key>
+bool IndexedHeap<Key>::before(uint32_t a, uint32_t b) const {
+
+    if (keys[a] < keys[b]) {
+
+        return true;
+
+    }
+
+    return !(keys[b] < keys[a]) && a < b;
+
+}
+
+template <typename Key>
+void IndexedHeap<Key>::sift_up(size_t slot) {
+
+    uint32_t id = heap[slot];
+
+    while (slot > 0 && before(id, heap[(slot - 1) / 2])) {
+
+        place(slot, heap[(slot - 1) / 2]);
+
+        slot = (slot - 1) / 2;
+
+    }
+
+    place(slot, id);
+
+}
+
+template <typename Key>
+void IndexedHeap<Key>::sift_down(size_t slot) {
+
+    uint32_t id = heap[slot];
+
+    while (2 * slot + 1 < heap.size()) {
+
+        size_t child = 2 * slot + 1;
+
+        if (child + 1 < heap.size() && before(heap[child + 1], heap[child])) {
+
+            child++;
+
+        }
+
+        if (!before(heap[child], id)) {
+
+            break;
+
+        }
+
+        place(slot, heap[child]);
+
+        slot = child;
+
+    }
+
+    place(slot, id);
+
+}
+
+template <typename Key>
+void IndexedHeap<Key>::place(size_t slot, uint32_t id) {
+
+    heap[slot] = id;
+
+    position[id] = static_cast<uint32_t>(slot);
+
+}
+
+#endif /* INDEXED_HEAP_HPP */
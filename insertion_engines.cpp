@@ -0,0 +1,552 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  insertion_engines.cpp
+//  project4
+//
+
+#include "insertion_engines.hpp"
+#include "indexed_heap.hpp"
+#include "neighbor_graph.hpp"
+#include "phase_timer.hpp"
+#include "spatial.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+namespace {
+
+// Neighbors whose tour edges a location considers
+const size_t num_neighbors = 10;
+
+// Edges in the top heap slots of edge_lengths, tried one by one before the
+// ring search (the longest edges, e.g. between far apart clumps)
+const size_t num_long_edges = 63;
+
+const double infinity = std::numeric_limits<double>::infinity();
+
+// ----------------------------------------------------------------------------
+//                    InsertionTour Declarations
+// ----------------------------------------------------------------------------
+
+// The tour being built (a doubly linked list over location numbers, starting
+// as location 0 alone) and the neighbor lists both engines prune with. An
+// edge is named by its first stop: edge a is (a, next a).
+class InsertionTour {
+    
+public:
+    
+    InsertionTour(const Coordinate *coords_in, size_t count_in);
+    
+    double distance(uint32_t a, uint32_t b) const;
+    
+    // Cost of inserting v on edge a
+    double insertion_cost(uint32_t a, uint32_t v) const;
+    
+    // Cheapest of the edges touching v's routed neighbors (and extra, if it
+    // is routed); false if there are none
+    bool best_nearby_edge(uint32_t v, uint32_t extra, uint32_t &edge, double &cost) const;
+    
+    // Cheapest edge of the whole tour: edges with a stop near v and the
+    // longest edges are tried first, then grid rings outward until no
+    // farther edge can be cheaper
+    void best_edge(uint32_t v, uint32_t extra, uint32_t &edge, double &cost) const;
+    
+    // Puts v on edge a
+    void insert(uint32_t v, uint32_t a);
+    
+    bool is_routed(uint32_t v) const;
+    
+    uint32_t get_next(uint32_t a) const;
+    
+    // Locations that have v among their neighbors
+    const uint32_t *users_begin(uint32_t v) const;
+    
+    const uint32_t *users_end(uint32_t v) const;
+    
+    void get_result(TourResult &result) const;
+    
+private:
+    
+    void offer_edges_of(uint32_t w, uint32_t v, uint32_t &edge, double &cost) const;
+    
+    void offer_edge(uint32_t a, uint32_t v, uint32_t &edge, double &cost) const;
+    
+    const Coordinate *coords;
+    
+    size_t count;
+    
+    std::vector<uint32_t> next;
+    std::vector<uint32_t> prev;
+    
+    std::vector<char> routed;
+    
+    NeighborGraph graph;
+    
+    StaticGrid grid;
+    
+    // Keyed by minus the length of edge a: longest on top
+    IndexedHeap<double> edge_lengths;
+    
+    // Reverse of graph, as CSR
+    std::vector<uint64_t> user_offsets;
+    std::vector<uint32_t> users;
+    
+};
+
+// ----------------------------------------------------------------------------
+//                    InsertionTour Definitions
+// ----------------------------------------------------------------------------
+
+InsertionTour::InsertionTour(const Coordinate *coords_in, size_t count_in) {
+    
+    coords = coords_in;
+    
+    count = count_in;
+    
+    next.assign(count, 0);
+    prev.assign(count, 0);
+    
+    routed.assign(count, 0);
+    routed[0] = 1;
+    
+    graph.build(coords, count, num_neighbors, false);
+    
+    std::vector<uint32_t> ids(count);
+    
+    for (size_t v = 0; v < count; v++) {
+        
+        ids[v] = static_cast<uint32_t>(v);
+        
+    }
+    
+    grid.build(coords, ids.data(), count, 2.0);
+    
+    edge_lengths.reset(count);
+    
+    edge_lengths.push_or_update(0, 0);
+    
+    user_offsets.assign(count + 1, 0);
+    
+    for (size_t v = 0; v < count; v++) {
+        
+        for (const uint32_t *w = graph.begin(v); w != graph.end(v); w++) {
+            
+            user_offsets[*w + 1]++;
+            
+        }
+        
+    }
+    
+    for (size_t v = 0; v < count; v++) {
+        
+        user_offsets[v + 1] += user_offsets[v];
+        
+    }
+    
+    users.resize(graph.num_edges());
+    
+    std::vector<uint64_t> fill(user_offsets.begin(), user_offsets.end() - 1);
+    
+    for (size_t v = 0; v < count; v++) {
+        
+        for (const uint32_t *w = graph.begin(v); w != graph.end(v); w++) {
+            
+            users[fill[*w]++] = static_cast<uint32_t>(v);
+            
+        }
+        
+    }
+    
+}
+
+double InsertionTour::distance(uint32_t a, uint32_t b) const {
+    
+    return squared_length(squared_distance(coords[a], coords[b]));
+    
+}
+
+double InsertionTour::insertion_cost(uint32_t a, uint32_t v) const {
+    
+    // Same formula as FAST_distance_change()
+    return distance(a, v) + distance(v, next[a]) - distance(a, next[a]);
+    
+}
+
+bool InsertionTour::best_nearby_edge(uint32_t v, uint32_t extra, uint32_t &edge, double &cost) const {
+    
+    cost = infinity;
+    
+    for (const uint32_t *w = graph.begin(v); w != graph.end(v); w++) {
+        
+        offer_edges_of(*w, v, edge, cost);
+        
+    }
+    
+    if (extra < count) {
+        
+        offer_edges_of(extra, v, edge, cost);
+        
+    }
+    
+    return cost < infinity;
+    
+}
+
+void InsertionTour::offer_edges_of(uint32_t w, uint32_t v, uint32_t &edge, double &cost) const {
+    
+    if (!routed[w]) {
+        
+        return;
+        
+    }
+    
+    // The edges leaving and entering w
+    offer_edge(w, v, edge, cost);
+    offer_edge(prev[w], v, edge, cost);
+    
+}
+
+void InsertionTour::offer_edge(uint32_t a, uint32_t v, uint32_t &edge, double &cost) const {
+    
+    double candidate = insertion_cost(a, v);
+    
+    if (candidate < cost || (candidate == cost && a < edge)) {
+        
+        cost = candidate;
+        edge = a;
+        
+    }
+    
+}
+
+void InsertionTour::best_edge(uint32_t v, uint32_t extra, uint32_t &edge, double &cost) const {
+    
+    best_nearby_edge(v, extra, edge, cost);
+    
+    size_t num_edges = edge_lengths.size();
+    
+    for (size_t slot = 0; slot < std::min(num_edges, num_long_edges); slot++) {
+        
+        offer_edge(edge_lengths.at(slot), v, edge, cost);
+        
+    }
+    
+    // Every other edge sits below one of the next heap slots, so is no
+    // longer than the longest of them
+    double longest = 0;
+    
+    for (size_t slot = num_long_edges; slot < std::min(num_edges, 2 * num_long_edges + 1); slot++) {
+        
+        longest = std::max(longest, -edge_lengths.get_key(edge_lengths.at(slot)));
+        
+    }
+    
+    // An edge (a, b) with both stops at least r from v costs at least
+    // 2r - d(a, b), so rings past (cost + longest) / 2 can't help
+    
+    for (int64_t ring = 0; grid.visit_ring(coords[v], ring, [&](uint32_t w, const Coordinate &) { offer_edges_of(w, v, edge, cost); }); ring++) {
+        
+        if (2 * static_cast<double>(grid.ring_lower_bound(ring)) >= cost + longest) {
+            
+            break;
+            
+        }
+        
+    }
+    
+}
+
+void InsertionTour::insert(uint32_t v, uint32_t a) {
+    
+    uint32_t b = next[a];
+    
+    next[a] = v;
+    prev[v] = a;
+    
+    next[v] = b;
+    prev[b] = v;
+    
+    routed[v] = 1;
+    
+    edge_lengths.push_or_update(a, -distance(a, v));
+    edge_lengths.push_or_update(v, -distance(v, b));
+    
+}
+
+bool InsertionTour::is_routed(uint32_t v) const {
+    
+    return routed[v];
+    
+}
+
+uint32_t InsertionTour::get_next(uint32_t a) const {
+    
+    return next[a];
+    
+}
+
+const uint32_t *InsertionTour::users_begin(uint32_t v) const {
+    
+    return users.data() + user_offsets[v];
+    
+}
+
+const uint32_t *InsertionTour::users_end(uint32_t v) const {
+    
+    return users.data() + user_offsets[v + 1];
+    
+}
+
+void InsertionTour::get_result(TourResult &result) const {
+    
+    result.path.clear();
+    result.path.reserve(count);
+    
+    result.total_distance = 0;
+    
+    uint32_t a = 0;
+    
+    do {
+        
+        result.path.push_back(a);
+        
+        result.total_distance += distance(a, next[a]);
+        
+        a = next[a];
+        
+    } while (a != 0);
+    
+}
+
+}
+
+// ----------------------------------------------------------------------------
+//                    Insertion Engines Definitions
+// ----------------------------------------------------------------------------
+
+void farthest_insertion_tour(const Coordinate *coords, size_t count, TourResult &result) {
+    
+    if (count < 3) {
+        
+        throw DroneError("Error: FASTTSP needs at least 3 locations. Program terminating");
+        
+    }
+    
+    InsertionTour tour(coords, count);
+    
+    // Squared distance to the nearest stop, and that stop
+    std::vector<int64_t> tour_distance(count);
+    std::vector<uint32_t> nearest_stop(count, 0);
+    
+    // Keyed by minus the squared distance: farthest on top
+    IndexedHeap<int64_t> heap;
+    
+    heap.reset(count);
+    
+    std::vector<uint32_t> ids(count);
+    
+    for (uint32_t v = 0; v < count; v++) {
+        
+        ids[v] = v;
+        
+        if (v != 0) {
+            
+            tour_distance[v] = squared_distance(coords[0], coords[v]);
+            
+            heap.push_or_update(v, -tour_distance[v]);
+            
+        }
+        
+    }
+    
+    StaticGrid grid;
+    
+    grid.build(coords, ids.data(), count, 2.0);
+    
+    PHASE_TIMER("farthest_insertion");
+    
+    while (!heap.empty()) {
+        
+        uint32_t v = heap.top();
+        
+        heap.pop();
+        
+        uint32_t edge = 0;
+        double cost = 0;
+        
+        tour.best_edge(v, nearest_stop[v], edge, cost);
+        
+        tour.insert(v, edge);
+        
+        if (heap.empty()) {
+            
+            break;
+            
+        }
+        
+        // Only locations closer to v than to the rest of the tour change,
+        // and none is farther from the tour than the new farthest one
+        int64_t reach = -heap.get_key(heap.top());
+        
+        auto visit = [&](uint32_t w, const Coordinate &c) {
+            
+            if (tour.is_routed(w)) {
+                
+                return;
+                
+            }
+            
+            int64_t d = squared_distance(c, coords[v]);
+            
+            if (d < tour_distance[w]) {
+                
+                tour_distance[w] = d;
+                nearest_stop[w] = v;
+                
+                heap.push_or_update(w, -d);
+                
+            }
+            
+        };
+        
+        for (int64_t ring = 0; grid.visit_ring(coords[v], ring, visit); ring++) {
+            
+            int64_t bound = grid.ring_lower_bound(ring);
+            
+            if (squared_offset(bound, 0) >= reach) {
+                
+                break;
+                
+            }
+            
+        }
+        
+    }
+    
+    tour.get_result(result);
+    
+}
+
+void cheapest_insertion_tour(const Coordinate *coords, size_t count, TourResult &result) {
+    
+    if (count < 3) {
+        
+        throw DroneError("Error: FASTTSP needs at least 3 locations. Program terminating");
+        
+    }
+    
+    InsertionTour tour(coords, count);
+    
+    std::vector<uint32_t> best_edge(count, 0);
+    
+    // watchers[a]: locations that picked edge a (stale entries are skipped)
+    std::vector<std::vector<uint32_t>> watchers(count);
+    
+    // Keyed by insertion cost (infinity: no neighbor routed yet)
+    IndexedHeap<double> heap;
+    
+    heap.reset(count);
+    
+    auto recompute = [&](uint32_t v) {
+        
+        uint32_t edge = 0;
+        double cost = infinity;
+        
+        if (tour.best_nearby_edge(v, UINT32_MAX, edge, cost)) {
+            
+            best_edge[v] = edge;
+            
+            watchers[edge].push_back(v);
+            
+        }
+        
+        heap.push_or_update(v, cost);
+        
+    };
+    
+    auto offer = [&](uint32_t v, uint32_t edge) {
+        
+        if (tour.is_routed(v)) {
+            
+            return;
+            
+        }
+        
+        double cost = tour.insertion_cost(edge, v);
+        
+        if (cost < heap.get_key(v)) {
+            
+            best_edge[v] = edge;
+            
+            watchers[edge].push_back(v);
+            
+            heap.push_or_update(v, cost);
+            
+        }
+        
+    };
+    
+    for (uint32_t v = 1; v < count; v++) {
+        
+        recompute(v);
+        
+    }
+    
+    PHASE_TIMER("cheapest_insertion");
+    
+    std::vector<uint32_t> split;
+    
+    while (!heap.empty()) {
+        
+        uint32_t v = heap.top();
+        
+        // No unrouted location has a routed neighbor: search the whole tour
+        if (heap.get_key(v) == infinity) {
+            
+            double cost = 0;
+            
+            tour.best_edge(v, UINT32_MAX, best_edge[v], cost);
+            
+        }
+        
+        heap.pop();
+        
+        uint32_t a = best_edge[v];
+        uint32_t b = tour.get_next(a);
+        
+        tour.insert(v, a);
+        
+        // Edge (a, b) is gone: whoever still wanted it looks again
+        split.swap(watchers[a]);
+        
+        for (uint32_t w : split) {
+            
+            if (!tour.is_routed(w) && best_edge[w] == a) {
+                
+                recompute(w);
+                
+            }
+            
+        }
+        
+        split.clear();
+        
+        // New edges (a, v) and (v, b) touch a, v and b
+        for (uint32_t stop : { a, v, b }) {
+            
+            for (const uint32_t *w = tour.users_begin(stop); w != tour.users_end(stop); w++) {
+                
+                offer(*w, a);
+                offer(*w, v);
+                
+            }
+            
+        }
+        
+    }
+    
+    tour.get_result(result);
+    
+}
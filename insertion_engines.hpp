@@ -0,0 +1,50 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  insertion_engines.hpp
+//  project4
+//
+//  FASTTSP construction engines besides the Drone's own arbitrary insertion
+//  (TourEngine::Arbitrary). Both grow the tour from location 0, one location
+//  at a time, and place each location on its cheapest tour edge:
+//
+//      farthest   next is the unrouted location farthest from the tour
+//      cheapest   next is the unrouted location that is cheapest to insert
+//
+//  Done naively both are O(n^3). Here every unrouted location keeps its key
+//  in an IndexedHeap and only the entries a new edge split can change are
+//  touched:
+//
+//    - Insertion positions are pruned spatially: a location only considers
+//      tour edges touching its k nearest neighbors (NeighborGraph). When the
+//      edge a location was going to use is split, that location is
+//      recomputed; when a new edge touches one of its neighbors, it is
+//      offered the new edge. Cheapest insertion falls back to a scan of the
+//      whole tour for a location none of whose neighbors is routed yet.
+//    - Farthest insertion keeps each location's exact distance to the tour;
+//      a new tour stop only updates the unrouted locations within the
+//      current farthest distance of it (grid rings around the stop).
+//      Its insertion edge is exact: after the nearby and the longest tour
+//      edges, grid rings are searched outward only while an edge farther
+//      away could still be cheaper.
+//
+//  The tour is a doubly linked list, so an insertion is O(1).
+//  bench/bench_insertion.cpp compares the engines.
+//
+
+#ifndef INSERTION_ENGINES_HPP
+#define INSERTION_ENGINES_HPP
+
+#include "drone.hpp"
+
+
+// ----------------------------------------------------------------------------
+//                    Insertion Engines
+// ----------------------------------------------------------------------------
+
+// Fill result like Drone::solve_fast_tsp() (path from location 0, total
+// summed along it). Throw DroneError for fewer than 3 locations.
+void farthest_insertion_tour(const Coordinate *coords, size_t count, TourResult &result);
+
+void cheapest_insertion_tour(const Coordinate *coords, size_t count, TourResult &result);
+
+#endif /* INSERTION_ENGINES_HPP */
@@ -0,0 +1,989 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  lk_search.cpp
+//  project4
+//
+
+#include "lk_search.hpp"
+#include "neighbor_graph.hpp"
+#include "phase_timer.hpp"
+#include "spatial.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+// Candidate neighbors per location
+const size_t num_neighbors = 8;
+
+// Steps of one LK chain
+const size_t max_depth = 50;
+
+// Longest run Or-opt moves
+const size_t max_run = 3;
+
+// Longest stretch (in stops) a kick cuts out and swaps
+const size_t max_kick_stretch = 50;
+
+// Queue pops between clock checks
+const size_t clock_interval = 256;
+
+const double min_gain = 1e-9;
+
+const uint32_t no_location = std::numeric_limits<uint32_t>::max();
+
+// ----------------------------------------------------------------------------
+//                    TwoLevelTour Declarations
+// ----------------------------------------------------------------------------
+
+// Tour as a list of segments (arrays of location numbers, each with a
+// reversed bit) kept in an array in stored order, plus one bit that flips
+// the direction of the whole tour. Stops are found through the segment they
+// sit in, so next(), prev() and between() are O(1); reverse() splits at
+// most two segments and reverses the shorter run of segments, O(sqrt n).
+// Splits leave small segments behind, so once there are twice as many
+// segments as at the start the tour is cut into even segments again.
+class TwoLevelTour {
+    
+public:
+    
+    void build(const std::vector<size_t> &path);
+    
+    uint32_t next(uint32_t v) const;
+    
+    uint32_t prev(uint32_t v) const;
+    
+    // True if b is on the path from a forward to c
+    bool between(uint32_t a, uint32_t b, uint32_t c) const;
+    
+    // Reverses the path from a forward to b; it then runs from b to a
+    void reverse(uint32_t a, uint32_t b);
+    
+    // Visiting order from location 0
+    void get_path(std::vector<size_t> &path) const;
+    
+private:
+    
+    struct Segment {
+        
+        std::vector<uint32_t> stops;
+        
+        bool reversed = false;
+        
+        // Index into order
+        size_t rank = 0;
+        
+    };
+    
+    // The stored order, ignoring flipped
+    uint32_t stored_next(uint32_t v) const;
+    
+    uint32_t stored_prev(uint32_t v) const;
+    
+    bool stored_between(uint32_t a, uint32_t b, uint32_t c) const;
+    
+    void stored_reverse(uint32_t a, uint32_t b);
+    
+    // Position of v within its segment, in stored order
+    size_t offset(uint32_t v) const;
+    
+    // Stop at position pos (in stored order) of segment s
+    uint32_t stop_at(const Segment &s, size_t pos) const;
+    
+    // Splits v's segment so that v starts one
+    void split_before(uint32_t v);
+    
+    // Cuts path (in stored order) into segments of segment_size
+    void cut(const std::vector<size_t> &path);
+    
+    void renumber(size_t from_rank);
+    
+    size_t segment_size;
+    
+    std::vector<Segment> segments;
+    
+    // Segment numbers in stored order
+    std::vector<uint32_t> order;
+    
+    std::vector<uint32_t> segment_of;
+    std::vector<uint32_t> index_of;
+    
+    // The tour runs against the stored order
+    bool flipped;
+    
+};
+
+// ----------------------------------------------------------------------------
+//                    TwoLevelTour Definitions
+// ----------------------------------------------------------------------------
+
+void TwoLevelTour::build(const std::vector<size_t> &path) {
+    
+    segment_size = std::max<size_t>(8, static_cast<size_t>(std::sqrt(static_cast<double>(path.size()))));
+    
+    flipped = false;
+    
+    cut(path);
+    
+}
+
+void TwoLevelTour::cut(const std::vector<size_t> &path) {
+    
+    segment_of.assign(path.size(), 0);
+    index_of.assign(path.size(), 0);
+    
+    // Segments keep their arrays from the last cut
+    segments.resize((path.size() + segment_size - 1) / segment_size);
+    order.resize(segments.size());
+    
+    for (size_t number = 0; number < segments.size(); number++) {
+        
+        segments[number].stops.clear();
+        segments[number].reversed = false;
+        segments[number].rank = number;
+        
+        order[number] = static_cast<uint32_t>(number);
+        
+    }
+    
+    for (size_t i = 0; i < path.size(); i++) {
+        
+        uint32_t v = static_cast<uint32_t>(path[i]);
+        
+        Segment &s = segments[i / segment_size];
+        
+        segment_of[v] = static_cast<uint32_t>(i / segment_size);
+        index_of[v] = static_cast<uint32_t>(s.stops.size());
+        
+        s.stops.push_back(v);
+        
+    }
+    
+}
+
+size_t TwoLevelTour::offset(uint32_t v) const {
+    
+    const Segment &s = segments[segment_of[v]];
+    
+    return s.reversed ? s.stops.size() - 1 - index_of[v] : index_of[v];
+    
+}
+
+uint32_t TwoLevelTour::stop_at(const Segment &s, size_t pos) const {
+    
+    return s.reversed ? s.stops[s.stops.size() - 1 - pos] : s.stops[pos];
+    
+}
+
+uint32_t TwoLevelTour::next(uint32_t v) const {
+    
+    return flipped ? stored_prev(v) : stored_next(v);
+    
+}
+
+uint32_t TwoLevelTour::prev(uint32_t v) const {
+    
+    return flipped ? stored_next(v) : stored_prev(v);
+    
+}
+
+bool TwoLevelTour::between(uint32_t a, uint32_t b, uint32_t c) const {
+    
+    return flipped ? stored_between(c, b, a) : stored_between(a, b, c);
+    
+}
+
+void TwoLevelTour::reverse(uint32_t a, uint32_t b) {
+    
+    if (flipped) {
+        
+        stored_reverse(b, a);
+        
+    }
+    
+    else {
+        
+        stored_reverse(a, b);
+        
+    }
+    
+}
+
+uint32_t TwoLevelTour::stored_next(uint32_t v) const {
+    
+    const Segment &s = segments[segment_of[v]];
+    
+    size_t pos = offset(v);
+    
+    if (pos + 1 < s.stops.size()) {
+        
+        return stop_at(s, pos + 1);
+        
+    }
+    
+    return stop_at(segments[order[(s.rank + 1) % order.size()]], 0);
+    
+}
+
+uint32_t TwoLevelTour::stored_prev(uint32_t v) const {
+    
+    const Segment &s = segments[segment_of[v]];
+    
+    size_t pos = offset(v);
+    
+    if (pos > 0) {
+        
+        return stop_at(s, pos - 1);
+        
+    }
+    
+    const Segment &before = segments[order[(s.rank + order.size() - 1) % order.size()]];
+    
+    return stop_at(before, before.stops.size() - 1);
+    
+}
+
+bool TwoLevelTour::stored_between(uint32_t a, uint32_t b, uint32_t c) const {
+    
+    auto key = [&](uint32_t v) {
+        
+        return std::make_pair(segments[segment_of[v]].rank, offset(v));
+        
+    };
+    
+    auto ka = key(a), kb = key(b), kc = key(c);
+    
+    if (ka <= kc) {
+        
+        return ka <= kb && kb <= kc;
+        
+    }
+    
+    // The path wraps past the end of order
+    return ka <= kb || kb <= kc;
+    
+}
+
+void TwoLevelTour::stored_reverse(uint32_t a, uint32_t b) {
+    
+    if (a == b) {
+        
+        return;
+        
+    }
+    
+    // A path inside one segment is reversed in place
+    if (segment_of[a] == segment_of[b] && offset(a) < offset(b)) {
+        
+        std::vector<uint32_t> &stops = segments[segment_of[a]].stops;
+        
+        size_t low = std::min(index_of[a], index_of[b]);
+        size_t high = std::max(index_of[a], index_of[b]);
+        
+        std::reverse(stops.begin() + static_cast<std::ptrdiff_t>(low), stops.begin() + static_cast<std::ptrdiff_t>(high + 1));
+        
+        for (size_t i = low; i <= high; i++) {
+            
+            index_of[stops[i]] = static_cast<uint32_t>(i);
+            
+        }
+        
+        return;
+        
+    }
+    
+    uint32_t after = stored_next(b);
+    
+    // The whole tour: only the direction changes
+    if (after == a) {
+        
+        flipped = !flipped;
+        
+        return;
+        
+    }
+    
+    // Reversing the rest of the tour and flipping the direction gives the
+    // same tour; do whichever spans fewer segments
+    size_t span = (segments[segment_of[b]].rank + order.size() - segments[segment_of[a]].rank) % order.size();
+    
+    if (2 * span > order.size()) {
+        
+        uint32_t before = stored_prev(a);
+        
+        flipped = !flipped;
+        
+        stored_reverse(after, before);
+        
+        return;
+        
+    }
+    
+    split_before(a);
+    split_before(after);
+    
+    // Now a starts a segment and b ends one: reverse the run of segments
+    // from a's to b's (wrapping past the end of order) and flip each
+    size_t first = segments[segment_of[a]].rank;
+    size_t last = segments[segment_of[b]].rank;
+    
+    size_t length = (last + order.size() - first) % order.size() + 1;
+    
+    for (size_t i = 0; i < length / 2; i++) {
+        
+        std::swap(order[(first + i) % order.size()], order[(last + order.size() - i) % order.size()]);
+        
+    }
+    
+    for (size_t i = 0; i < length; i++) {
+        
+        Segment &s = segments[order[(first + i) % order.size()]];
+        
+        s.reversed = !s.reversed;
+        s.rank = (first + i) % order.size();
+        
+    }
+    
+    if (order.size() > 2 * (segment_of.size() / segment_size + 1)) {
+        
+        std::vector<size_t> path;
+        
+        path.reserve(segment_of.size());
+        
+        for (uint32_t number : order) {
+            
+            for (size_t pos = 0; pos < segments[number].stops.size(); pos++) {
+                
+                path.push_back(stop_at(segments[number], pos));
+                
+            }
+            
+        }
+        
+        cut(path);
+        
+    }
+    
+}
+
+void TwoLevelTour::split_before(uint32_t v) {
+    
+    size_t pos = offset(v);
+    
+    if (pos == 0) {
+        
+        return;
+        
+    }
+    
+    uint32_t old_number = segment_of[v];
+    
+    Segment tail;
+    
+    for (size_t i = pos; i < segments[old_number].stops.size(); i++) {
+        
+        tail.stops.push_back(stop_at(segments[old_number], i));
+        
+    }
+    
+    Segment &s = segments[old_number];
+    
+    // Keep positions 0 .. pos - 1 (in stored order) in s
+    if (s.reversed) {
+        
+        s.stops.erase(s.stops.begin(), s.stops.end() - static_cast<std::ptrdiff_t>(pos));
+        
+        for (size_t i = 0; i < s.stops.size(); i++) {
+            
+            index_of[s.stops[i]] = static_cast<uint32_t>(i);
+            
+        }
+        
+    }
+    
+    else {
+        
+        s.stops.resize(pos);
+        
+    }
+    
+    size_t rank = s.rank;
+    
+    uint32_t new_number = static_cast<uint32_t>(segments.size());
+    
+    segments.emplace_back();
+    
+    for (size_t i = 0; i < tail.stops.size(); i++) {
+        
+        segment_of[tail.stops[i]] = new_number;
+        index_of[tail.stops[i]] = static_cast<uint32_t>(i);
+        
+    }
+    
+    segments[new_number] = std::move(tail);
+    
+    order.insert(order.begin() + static_cast<std::ptrdiff_t>(rank + 1), new_number);
+    
+    renumber(rank + 1);
+    
+}
+
+void TwoLevelTour::renumber(size_t from_rank) {
+    
+    for (size_t rank = from_rank; rank < order.size(); rank++) {
+        
+        segments[order[rank]].rank = rank;
+        
+    }
+    
+}
+
+void TwoLevelTour::get_path(std::vector<size_t> &path) const {
+    
+    path.clear();
+    path.reserve(segment_of.size());
+    
+    uint32_t v = 0;
+    
+    do {
+        
+        path.push_back(v);
+        
+        v = next(v);
+        
+    } while (v != 0);
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    LKSearch Declarations
+// ----------------------------------------------------------------------------
+
+class LKSearch {
+    
+public:
+    
+    LKSearch(const Coordinate *coords_in, size_t count_in, const std::vector<size_t> &path,
+             std::chrono::steady_clock::time_point deadline_in);
+    
+    // Runs until no queued location improves (or time is up)
+    void local_search();
+    
+    // Double-bridge kicks until time is up
+    void kick_loop();
+    
+    void get_path(std::vector<size_t> &path) const;
+    
+private:
+    
+    double distance(uint32_t a, uint32_t b) const;
+    
+    uint32_t succ(uint32_t v, bool forward) const;
+    
+    uint32_t pred(uint32_t v, bool forward) const;
+    
+    // Reverses the path from a to b walking in direction forward, logged
+    void flip(uint32_t a, uint32_t b, bool forward);
+    
+    // Undoes the logged reversals past mark
+    void undo_to(size_t mark);
+    
+    void enqueue(uint32_t v);
+    
+    // LK chain from t1, breaking (t1, succ t1); true if the tour improved
+    bool lk_chain(uint32_t t1, bool forward);
+    
+    // Moves a run starting at s1 (forward) to a better edge
+    bool or_opt(uint32_t s1);
+    
+    bool out_of_time();
+    
+    const Coordinate *coords;
+    
+    size_t count;
+    
+    TwoLevelTour tour;
+    
+    NeighborGraph graph;
+    
+    double length;
+    
+    std::deque<uint32_t> queue;
+    std::vector<char> queued;
+    
+    // Reversals as (a, b): the path from a forward to b was reversed
+    std::vector<std::pair<uint32_t, uint32_t>> log;
+    
+    std::chrono::steady_clock::time_point deadline;
+    
+    size_t pops;
+    
+    bool expired;
+    
+    // Set while kicks run: the log then has to reach back to the kick
+    bool kicking;
+    
+    std::mt19937 rng;
+    
+};
+
+// ----------------------------------------------------------------------------
+//                    LKSearch Definitions
+// ----------------------------------------------------------------------------
+
+LKSearch::LKSearch(const Coordinate *coords_in, size_t count_in, const std::vector<size_t> &path,
+                   std::chrono::steady_clock::time_point deadline_in) : rng(1) {
+    
+    coords = coords_in;
+    
+    count = count_in;
+    
+    deadline = deadline_in;
+    
+    pops = 0;
+    
+    expired = false;
+    
+    kicking = false;
+    
+    tour.build(path);
+    
+    graph.build(coords, count, num_neighbors, false);
+    
+    length = 0;
+    
+    queued.assign(count, 0);
+    
+    for (size_t v : path) {
+        
+        length += distance(static_cast<uint32_t>(v), tour.next(static_cast<uint32_t>(v)));
+        
+        enqueue(static_cast<uint32_t>(v));
+        
+    }
+    
+}
+
+double LKSearch::distance(uint32_t a, uint32_t b) const {
+    
+    return squared_length(squared_distance(coords[a], coords[b]));
+    
+}
+
+uint32_t LKSearch::succ(uint32_t v, bool forward) const {
+    
+    return forward ? tour.next(v) : tour.prev(v);
+    
+}
+
+uint32_t LKSearch::pred(uint32_t v, bool forward) const {
+    
+    return forward ? tour.prev(v) : tour.next(v);
+    
+}
+
+void LKSearch::flip(uint32_t a, uint32_t b, bool forward) {
+    
+    if (!forward) {
+        
+        std::swap(a, b);
+        
+    }
+    
+    tour.reverse(a, b);
+    
+    log.emplace_back(a, b);
+    
+}
+
+void LKSearch::undo_to(size_t mark) {
+    
+    while (log.size() > mark) {
+        
+        tour.reverse(log.back().second, log.back().first);
+        
+        log.pop_back();
+        
+    }
+    
+}
+
+void LKSearch::enqueue(uint32_t v) {
+    
+    if (!queued[v]) {
+        
+        queued[v] = 1;
+        
+        queue.push_back(v);
+        
+    }
+    
+}
+
+bool LKSearch::out_of_time() {
+    
+    if (!expired && ++pops % clock_interval == 0) {
+        
+        expired = std::chrono::steady_clock::now() >= deadline;
+        
+    }
+    
+    return expired;
+    
+}
+
+void LKSearch::local_search() {
+    
+    while (!queue.empty() && !out_of_time()) {
+        
+        uint32_t v = queue.front();
+        
+        queue.pop_front();
+        
+        queued[v] = 0;
+        
+        // Try again from v until nothing helps
+        while (lk_chain(v, true) || lk_chain(v, false) || or_opt(v)) {}
+        
+        if (!kicking) {
+            
+            log.clear();
+            
+        }
+        
+    }
+    
+}
+
+bool LKSearch::lk_chain(uint32_t t1, bool forward) {
+    
+    size_t mark = log.size();
+    size_t best_mark = mark;
+    
+    double best_gain = 0;
+    
+    uint32_t t2 = succ(t1, forward);
+    
+    // Length of the edges broken minus the edges added so far, not
+    // counting the edge (t1, t2) that would close the tour
+    double gain = distance(t1, t2);
+    
+    std::vector<std::pair<uint32_t, uint32_t>> added;
+    std::vector<uint32_t> touched = { t1, t2 };
+    
+    size_t best_touched = 0;
+    
+    for (size_t depth = 0; depth < max_depth; depth++) {
+        
+        uint32_t best_t3 = no_location, best_t4 = no_location;
+        
+        double best_score = -std::numeric_limits<double>::infinity();
+        
+        for (const uint32_t *t3 = graph.begin(t2); t3 != graph.end(t2); t3++) {
+            
+            double partial = gain - distance(t2, *t3);
+            
+            // Neighbors come nearest first
+            if (partial <= min_gain) {
+                
+                break;
+                
+            }
+            
+            if (*t3 == succ(t2, forward) || *t3 == pred(t2, forward)) {
+                
+                continue;
+                
+            }
+            
+            // Break (t4, t3), join (t2, t3); the tour closes with (t1, t4)
+            uint32_t t4 = pred(*t3, forward);
+            
+            bool was_added = std::any_of(added.begin(), added.end(), [&](const std::pair<uint32_t, uint32_t> &e) {
+                
+                return (e.first == t4 && e.second == *t3) || (e.first == *t3 && e.second == t4);
+                
+            });
+            
+            if (was_added) {
+                
+                continue;
+                
+            }
+            
+            double score = distance(t4, *t3) - distance(t2, *t3);
+            
+            if (score > best_score) {
+                
+                best_score = score;
+                best_t3 = *t3;
+                best_t4 = t4;
+                
+            }
+            
+        }
+        
+        if (best_t3 == no_location) {
+            
+            break;
+            
+        }
+        
+        gain += best_score;
+        
+        flip(t2, best_t4, forward);
+        
+        added.emplace_back(t2, best_t3);
+        
+        touched.insert(touched.end(), { best_t3, best_t4 });
+        
+        t2 = best_t4;
+        
+        double closed = gain - distance(t1, t2);
+        
+        if (closed > best_gain + min_gain) {
+            
+            best_gain = closed;
+            best_mark = log.size();
+            best_touched = touched.size();
+            
+        }
+        
+    }
+    
+    undo_to(best_mark);
+    
+    if (best_mark == mark) {
+        
+        return false;
+        
+    }
+    
+    length -= best_gain;
+    
+    for (size_t i = 0; i < best_touched; i++) {
+        
+        enqueue(touched[i]);
+        
+    }
+    
+    return true;
+    
+}
+
+bool LKSearch::or_opt(uint32_t s1) {
+    
+    uint32_t p = tour.prev(s1);
+    uint32_t s2 = s1;
+    
+    for (size_t run = 1; run <= max_run; run++, s2 = tour.next(s2)) {
+        
+        uint32_t n = tour.next(s2);
+        
+        if (n == p) {
+            
+            break;
+            
+        }
+        
+        double removed = distance(p, s1) + distance(s2, n) - distance(p, n);
+        
+        if (removed <= min_gain) {
+            
+            continue;
+            
+        }
+        
+        for (uint32_t end : { s1, s2 }) {
+            
+            for (const uint32_t *c = graph.begin(end); c != graph.end(end); c++) {
+                
+                // Both edges at c: (c, next c) and (prev c, c)
+                for (uint32_t x : { *c, tour.prev(*c) }) {
+                    
+                    uint32_t y = tour.next(x);
+                    
+                    // x and y must be outside s1 .. s2 (the edge is then
+                    // never (p, s1) or (s2, n))
+                    if (tour.between(s1, x, s2) || tour.between(s1, y, s2)) {
+                        
+                        continue;
+                        
+                    }
+                    
+                    double plain = distance(x, s1) + distance(s2, y) - distance(x, y);
+                    double turned = distance(x, s2) + distance(s1, y) - distance(x, y);
+                    
+                    double gain = removed - std::min(plain, turned);
+                    
+                    if (gain <= min_gain) {
+                        
+                        continue;
+                        
+                    }
+                    
+                    // p s1..s2 n .. x y  ->  p n .. x s2..s1 y
+                    flip(s1, x, true);
+                    flip(x, n, true);
+                    
+                    if (plain < turned) {
+                        
+                        flip(s2, s1, true);
+                        
+                    }
+                    
+                    length -= gain;
+                    
+                    for (uint32_t v : { p, n, s1, s2, x, y }) {
+                        
+                        enqueue(v);
+                        
+                    }
+                    
+                    return true;
+                    
+                }
+                
+            }
+            
+        }
+        
+    }
+    
+    return false;
+    
+}
+
+void LKSearch::kick_loop() {
+    
+    // A kick needs two stretches plus the stop before and after them
+    size_t max_stretch = std::min(max_kick_stretch, (count - 2) / 2);
+    
+    std::uniform_int_distribution<uint32_t> pick_stop(0, static_cast<uint32_t>(count - 1));
+    std::uniform_int_distribution<size_t> pick_length(1, max_stretch);
+    
+    kicking = true;
+    
+    while (std::chrono::steady_clock::now() < deadline) {
+        
+        log.clear();
+        
+        double before = length;
+        
+        // a [b1 .. b2] [c1 .. c2] d  ->  a [c1 .. c2] [b1 .. b2] d
+        uint32_t a = pick_stop(rng);
+        uint32_t b1 = tour.next(a), b2 = b1;
+        
+        for (size_t steps = pick_length(rng); steps > 1; steps--) {
+            
+            b2 = tour.next(b2);
+            
+        }
+        
+        uint32_t c1 = tour.next(b2), c2 = c1;
+        
+        for (size_t steps = pick_length(rng); steps > 1; steps--) {
+            
+            c2 = tour.next(c2);
+            
+        }
+        
+        uint32_t d = tour.next(c2);
+        
+        length += distance(a, c1) + distance(c2, b1) + distance(b2, d) -
+        distance(a, b1) - distance(b2, c1) - distance(c2, d);
+        
+        flip(b1, c2, true);
+        flip(c2, c1, true);
+        flip(b2, b1, true);
+        
+        for (uint32_t v : { a, b1, b2, c1, c2, d }) {
+            
+            enqueue(v);
+            
+        }
+        
+        local_search();
+        
+        if (length > before + min_gain) {
+            
+            undo_to(0);
+            
+            length = before;
+            
+            for (uint32_t v : queue) {
+                
+                queued[v] = 0;
+                
+            }
+            
+            queue.clear();
+            
+        }
+        
+    }
+    
+    kicking = false;
+    
+    log.clear();
+    
+}
+
+void LKSearch::get_path(std::vector<size_t> &path) const {
+    
+    tour.get_path(path);
+    
+}
+
+}
+
+// ----------------------------------------------------------------------------
+//                    LK Search
+// ----------------------------------------------------------------------------
+
+void improve_tour(const Coordinate *coords, size_t count, Improvement improvement, double time_limit,
+                  TourResult &result) {
+    
+    if (improvement == Improvement::None || count < 8) {
+        
+        return;
+        
+    }
+    
+    PHASE_TIMER("lk_search");
+    
+    auto deadline = std::chrono::steady_clock::now() +
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(time_limit));
+    
+    LKSearch search(coords, count, result.path, deadline);
+    
+    search.local_search();
+    
+    if (improvement == Improvement::Kicks) {
+        
+        search.kick_loop();
+        
+    }
+    
+    search.get_path(result.path);
+    
+    // Summed again, not updated by the gains
+    result.total_distance = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        Coordinate from = coords[result.path[i]];
+        Coordinate to = coords[result.path[(i + 1) % count]];
+        
+        result.total_distance += squared_length(squared_distance(from, to));
+        
+    }
+    
+}
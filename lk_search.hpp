@@ -0,0 +1,54 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  lk_search.hpp
+//  project4
+//
+//  Variable-depth improvement of a finished tour (Drone::set_improvement()),
+//  in the style of Lin-Kernighan:
+//
+//    - LK chains: an edge (t1, t2) is broken and t2 joined to a candidate
+//      t3; the step is closed as a 2-opt move and the search goes on from
+//      the new end, up to max_depth steps while the partial gain stays
+//      positive. The best prefix of the chain is kept, the rest undone.
+//      Edges added by a chain are never broken again by it.
+//    - Or-opt: runs of 1 - 3 locations move to a candidate edge, either way
+//      round.
+//    - Candidates are the 8 nearest neighbors (NeighborGraph); locations
+//      wait in a queue and are only looked at again once an edge at them
+//      changes (don't-look bits).
+//    - The tour is a two-level list: ~sqrt(n) segments, each an array with
+//      a reversed bit, kept in an array in tour order. Reversing a path
+//      splits at most two segments and reverses the run of segments
+//      between, O(sqrt n) instead of O(n).
+//    - Improvement::Kicks then restarts from random double-bridge kicks on
+//      short stretches of the tour until the time limit, keeping a kick
+//      only if the tour doesn't get longer (every reversal is logged, so a
+//      rejected kick is undone in reverse).
+//
+//  Measured with bench/bench_lk.cpp (seconds including the greedy edge
+//  tour it starts from, length against that tour; kicks for 10 s):
+//
+//      locations   local, uniform      local, clustered    kicks
+//      20k         0.37 s  -12.0%      0.43 s  -12.6%      -14.0% / -15.3%
+//      200k        5.2 s   -11.3%      6.1 s   -11.2%      -11.9% / -11.7%
+//
+//  Kicks depend on the time limit, so their results vary between runs.
+//
+
+#ifndef LK_SEARCH_HPP
+#define LK_SEARCH_HPP
+
+#include "drone.hpp"
+
+
+// ----------------------------------------------------------------------------
+//                    LK Search
+// ----------------------------------------------------------------------------
+
+// Improves result (path from location 0) in place and sums its total again.
+// Stops after time_limit seconds even short of a local optimum. Tours of
+// fewer than 8 locations are left alone.
+void improve_tour(const Coordinate *coords, size_t count, Improvement improvement, double time_limit,
+                  TourResult &result);
+
+#endif /* LK_SEARCH_HPP */
@@ -0,0 +1,845 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  mst_engines.cpp
+//  project4
+//
+
+#include "mst_engines.hpp"
+#include "phase_timer.hpp"
+#include "spatial.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+
+namespace {
+
+// Squared distance, then the smaller and larger location numbers: a strict
+// order on edges, so the tree it picks is unique (Borůvka, kruskal_mst()
+// and external_mst() all use it)
+bool edge_before(int64_t e_squared, uint32_t e_from, uint32_t e_to, int64_t f_squared, uint32_t f_from, uint32_t f_to) {
+    
+    if (e_squared != f_squared) {
+        
+        return e_squared < f_squared;
+        
+    }
+    
+    uint32_t e_low = std::min(e_from, e_to), f_low = std::min(f_from, f_to);
+    
+    if (e_low != f_low) {
+        
+        return e_low < f_low;
+        
+    }
+    
+    return std::max(e_from, e_to) < std::max(f_from, f_to);
+    
+}
+
+// Array-based Prim (as in Drone::prim_algorithm()) over ids only; appends
+// the tree's edges, breaking ties with edge_before(). All ids must be
+// mutually reachable.
+void subset_prim(const Coordinate *coords, const std::vector<uint32_t> &ids, std::vector<MSTEdge> &edges) {
+    
+    size_t count = ids.size();
+    
+    if (count < 2) {
+        
+        return;
+        
+    }
+    
+    // Local copies keep the quadratic scans sequential
+    std::vector<Coordinate> points(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        points[i] = coords[ids[i]];
+        
+    }
+    
+    std::vector<int64_t> distances(count);
+    std::vector<uint32_t> parents(count, 0);
+    std::vector<bool> visited(count, false);
+    
+    visited[0] = true;
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        distances[i] = squared_distance(points[0], points[i]);
+        
+    }
+    
+    for (size_t added = 1; added < count; added++) {
+        
+        size_t next = count;
+        
+        for (size_t i = 0; i < count; i++) {
+            
+            if (visited[i]) {
+                
+                continue;
+                
+            }
+            
+            // Equal distances fall back to the location numbers
+            if (next == count || distances[i] < distances[next] || (distances[i] == distances[next] && edge_before(distances[i], ids[parents[i]], ids[i], distances[next], ids[parents[next]], ids[next]))) {
+                
+                next = i;
+                
+            }
+            
+        }
+        
+        visited[next] = true;
+        
+        edges.push_back({ distances[next], ids[parents[next]], ids[next] });
+        
+        for (size_t i = 0; i < count; i++) {
+            
+            if (!visited[i]) {
+                
+                int64_t distance = squared_distance(points[next], points[i]);
+                
+                if (distance < distances[i] || (distance == distances[i] && edge_before(distance, ids[next], ids[i], distances[i], ids[parents[i]], ids[i]))) {
+                    
+                    distances[i] = distance;
+                    parents[i] = static_cast<uint32_t>(next);
+                    
+                }
+                
+            }
+            
+        }
+        
+    }
+    
+}
+
+// Runs work(begin, end) over [0, count) in chunks on num_threads threads
+template <typename Work>
+void parallel_for(size_t count, size_t num_threads, Work work) {
+    
+    const size_t chunk_size = 4096;
+    
+    std::atomic<size_t> next_chunk(0);
+    
+    auto worker = [&]() {
+        
+        for (size_t chunk = next_chunk++; chunk * chunk_size < count; chunk = next_chunk++) {
+            
+            work(chunk * chunk_size, std::min(count, (chunk + 1) * chunk_size));
+            
+        }
+        
+    };
+    
+    std::vector<std::thread> threads;
+    
+    for (size_t t = 1; t < num_threads && t * chunk_size < count; t++) {
+        
+        threads.emplace_back(worker);
+        
+    }
+    
+    worker();
+    
+    for (std::thread &thread : threads) {
+        
+        thread.join();
+        
+    }
+    
+}
+
+// Union-find safe to use from several threads at once
+class ConcurrentUnionFind {
+    
+public:
+    
+    explicit ConcurrentUnionFind(size_t count) : parents(count) {
+        
+        for (size_t i = 0; i < count; i++) {
+            
+            parents[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+            
+        }
+        
+    }
+    
+    uint32_t find(uint32_t element) {
+        
+        while (true) {
+            
+            uint32_t parent = parents[element].load(std::memory_order_relaxed);
+            
+            if (parent == element) {
+                
+                return element;
+                
+            }
+            
+            uint32_t grandparent = parents[parent].load(std::memory_order_relaxed);
+            
+            // path halving; losing this race only skips a shortcut
+            parents[element].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+            
+            element = grandparent;
+            
+        }
+        
+    }
+    
+    // Returns false if a and b were already joined
+    bool unite(uint32_t a, uint32_t b) {
+        
+        while (true) {
+            
+            a = find(a);
+            b = find(b);
+            
+            if (a == b) {
+                
+                return false;
+                
+            }
+            
+            // Always hang the larger root under the smaller one
+            if (a < b) {
+                
+                std::swap(a, b);
+                
+            }
+            
+            uint32_t expected = a;
+            
+            if (parents[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) {
+                
+                return true;
+                
+            }
+            
+        }
+        
+    }
+    
+private:
+    
+    std::vector<std::atomic<uint32_t>> parents;
+    
+};
+
+// Atomic minimum; returns true if value became the new minimum
+template <typename T>
+bool atomic_min(std::atomic<T> &target, T value) {
+    
+    T current = target.load(std::memory_order_relaxed);
+    
+    while (value < current) {
+        
+        if (target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            
+            return true;
+            
+        }
+        
+    }
+    
+    return false;
+    
+}
+
+// True if ring_bound^2 is past the squared distance key squared (ties in
+// the key don't count)
+bool beyond(int64_t ring_bound, int64_t squared) {
+    
+    return squared_offset(ring_bound, 0) > squared;
+    
+}
+
+uint32_t find_root(std::vector<uint32_t> &roots, uint32_t location) {
+    
+    while (roots[location] != location) {
+        
+        // path halving
+        roots[location] = roots[roots[location]];
+        location = roots[location];
+        
+    }
+    
+    return location;
+    
+}
+
+// Borůvka rounds (see boruvka_mst()); appends the tree's edges. With
+// epsilon > 0 each component's edge is only within 1 + epsilon of its
+// cheapest, and if certified_bound is given it receives a lower bound on
+// the exact MST weight.
+void boruvka_tree(const Coordinate *coords, size_t count, size_t num_threads, double epsilon, std::vector<MSTEdge> &tree, double *certified_bound);
+
+}
+
+// ----------------------------------------------------------------------------
+//                    MST Engine Definitions
+// ----------------------------------------------------------------------------
+
+void zone_prim_mst(const Coordinate *coords, size_t count, MSTResult &result) {
+    
+    // Medical + Border, Normal + Border
+    std::vector<uint32_t> medical_side, normal_side;
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        LocationType type = zone_of(coords[i]);
+        
+        if (type != LocationType::Normal) {
+            
+            medical_side.push_back(static_cast<uint32_t>(i));
+            
+        }
+        
+        if (type != LocationType::Medical) {
+            
+            normal_side.push_back(static_cast<uint32_t>(i));
+            
+        }
+        
+    }
+    
+    std::vector<MSTEdge> medical_edges, normal_edges;
+    
+    {
+        PHASE_TIMER("zone_prim");
+        
+        std::thread medical_thread(subset_prim, coords, std::cref(medical_side), std::ref(medical_edges));
+        
+        subset_prim(coords, normal_side, normal_edges);
+        
+        medical_thread.join();
+    }
+    
+    medical_edges.insert(medical_edges.end(), normal_edges.begin(), normal_edges.end());
+    
+    PHASE_TIMER("zone_merge");
+    
+    kruskal_mst(coords, count, medical_edges, result);
+    
+}
+
+void boruvka_mst(const Coordinate *coords, size_t count, MSTResult &result, size_t num_threads) {
+    
+    std::vector<MSTEdge> tree;
+    
+    boruvka_tree(coords, count, num_threads, 0, tree, nullptr);
+    
+    root_mst(coords, count, tree, result);
+    
+}
+
+void approximate_mst(const Coordinate *coords, size_t count, double epsilon, MSTResult &result, double &lower_bound, size_t num_threads) {
+    
+    std::vector<MSTEdge> tree;
+    
+    lower_bound = 0;
+    
+    boruvka_tree(coords, count, num_threads, epsilon, tree, &lower_bound);
+    
+    root_mst(coords, count, tree, result);
+    
+    // Rounding in the integral can overshoot an exact tree slightly
+    lower_bound = std::min(lower_bound, result.total_weight);
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    Borůvka Definitions
+// ----------------------------------------------------------------------------
+
+namespace {
+
+void boruvka_tree(const Coordinate *coords, size_t count, size_t num_threads, double epsilon, std::vector<MSTEdge> &tree, double *certified_bound) {
+    
+    if (num_threads == 0) {
+        
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+        
+    }
+    
+    if (count < 2) {
+        
+        return;
+        
+    }
+    
+    bool has_medical = false, has_normal = false, has_border = false;
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        LocationType type = zone_of(coords[i]);
+        
+        has_medical = has_medical || type == LocationType::Medical;
+        has_normal = has_normal || type == LocationType::Normal;
+        has_border = has_border || type == LocationType::Border;
+        
+    }
+    
+    // Nothing can join the zones; Prim fails the same way
+    if (has_medical && has_normal && !has_border) {
+        
+        throw DroneError("Error: No closest location found. Program terminating");
+        
+    }
+    
+    // Everything below works on grid slots (locations in grid order)
+    std::vector<uint32_t> ids(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        ids[i] = static_cast<uint32_t>(i);
+        
+    }
+    
+    StaticGrid grid;
+    
+    grid.build(coords, ids.data(), count, 2.0);
+    
+    const std::vector<uint32_t> &locations = grid.get_points();
+    const std::vector<Coordinate> &points = grid.get_point_coords();
+    
+    std::vector<uint32_t> slot_of(count);
+    
+    for (size_t slot = 0; slot < count; slot++) {
+        
+        slot_of[locations[slot]] = static_cast<uint32_t>(slot);
+        
+    }
+    
+    ConcurrentUnionFind components(count);
+    
+    std::vector<uint32_t> labels(count);
+    
+    // Per slot: squared distance and slot of its nearest other-component point
+    const int64_t no_edge = std::numeric_limits<int64_t>::max();
+    
+    std::vector<int64_t> best_distance(count);
+    std::vector<uint32_t> best_slot(count);
+    
+    // Per slot: next ring to search (no_edge once done) and a lower bound on
+    // the distance to any other-component point, kept across rounds
+    std::vector<int64_t> next_ring(count);
+    std::vector<int64_t> lower_bound(count, 0);
+    
+    // Per component (indexed by root slot): cheapest edge found this round
+    std::vector<std::atomic<int64_t>> component_distance(count);
+    std::vector<std::atomic<uint64_t>> component_tie(count);
+    
+    // Searches may stop once nothing unseen can beat the best edge by more
+    // than a factor of 1 + epsilon
+    const double stretch = (1 + epsilon) * (1 + epsilon);
+    
+    auto search_bound = [&](int64_t bound) {
+        
+        return (epsilon == 0 || bound == no_edge) ? bound : squared_key(squared_value(bound) / stretch);
+        
+    };
+    
+    // Per component: smallest lower bound of its points this round. Each
+    // added edge is credited its component's bound; exchanging the edges
+    // into an exact MST one at a time (each component's edge before the
+    // edges of the components that picked it) pairs every credit with a
+    // distinct MST edge at least that heavy, so the credits sum to a lower
+    // bound on the MST weight.
+    std::vector<std::atomic<int64_t>> component_bound(count);
+    
+    std::vector<double> credits(certified_bound != nullptr ? count : 0, 0);
+    
+    // Tree edges, appended under a lock once per chunk
+    std::mutex tree_lock;
+    
+    size_t num_components = count;
+    
+    while (num_components > 1) {
+        
+        PHASE_TIMER("boruvka_round");
+        
+        parallel_for(count, num_threads, [&](size_t begin, size_t end) {
+            
+            for (size_t slot = begin; slot < end; slot++) {
+                
+                labels[slot] = components.find(static_cast<uint32_t>(slot));
+                
+                best_distance[slot] = no_edge;
+                best_slot[slot] = 0;
+                next_ring[slot] = 0;
+                
+                component_distance[slot].store(no_edge, std::memory_order_relaxed);
+                component_tie[slot].store(UINT64_MAX, std::memory_order_relaxed);
+                component_bound[slot].store(no_edge, std::memory_order_relaxed);
+                
+            }
+            
+        });
+        
+        // Nearest other-component point of every slot, searching rings from
+        // next_ring[slot] until ring 'last_ring' or until the rings are
+        // farther than the point's or (if use_bound) its component's best
+        auto search = [&](size_t slot, int64_t last_ring, bool use_bound) {
+            
+            const Coordinate &c = points[slot];
+            
+            LocationType type = zone_of(c);
+            
+            uint32_t label = labels[slot];
+            
+            int64_t best = best_distance[slot];
+            uint32_t best_other = best_slot[slot];
+            
+            int64_t ring = next_ring[slot];
+            
+            for (; ring <= last_ring; ring++) {
+                
+                bool inside = grid.visit_ring_slots(c, ring, [&](uint32_t other) {
+                    
+                    if (labels[other] == label || !zones_compatible(type, zone_of(points[other]))) {
+                        
+                        return;
+                        
+                    }
+                    
+                    int64_t distance = squared_distance(c, points[other]);
+                    
+                    // Ties: smaller location number of the far end
+                    if (distance < best || (distance == best && locations[other] < locations[best_other])) {
+                        
+                        best = distance;
+                        best_other = other;
+                        
+                    }
+                    
+                });
+                
+                // Every ring searched: best is exact
+                if (!inside) {
+                    
+                    lower_bound[slot] = best;
+                    
+                    ring = no_edge;
+                    
+                    break;
+                    
+                }
+                
+                int64_t bound = best;
+                
+                if (use_bound) {
+                    
+                    bound = std::min(bound, component_distance[label].load(std::memory_order_relaxed));
+                    
+                }
+                
+                if (beyond(grid.ring_lower_bound(ring), search_bound(bound))) {
+                    
+                    // Nothing unseen is closer than this ring
+                    int64_t ring_bound = grid.ring_lower_bound(ring);
+                    
+                    int64_t ring_key = squared_offset(ring_bound, 0);
+                    
+                    lower_bound[slot] = std::min(best, (ring_key == max_squared_key) ? no_edge : ring_key);
+                    
+                    ring = no_edge;
+                    
+                    break;
+                    
+                }
+                
+            }
+            
+            next_ring[slot] = ring;
+            
+            best_distance[slot] = best;
+            best_slot[slot] = best_other;
+            
+            if (best != no_edge) {
+                
+                atomic_min(component_distance[label], best);
+                
+            }
+            
+        };
+        
+        // First the cells around each point, so every component has a bound
+        // before the points deep inside it start searching outward
+        parallel_for(count, num_threads, [&](size_t begin, size_t end) {
+            
+            for (size_t slot = begin; slot < end; slot++) {
+                
+                if (lower_bound[slot] != no_edge) {
+                    
+                    search(slot, 1, false);
+                    
+                }
+                
+            }
+            
+        });
+        
+        parallel_for(count, num_threads, [&](size_t begin, size_t end) {
+            
+            for (size_t slot = begin; slot < end; slot++) {
+                
+                // Components only grow, so last round's bound still holds
+                if (next_ring[slot] != no_edge &&
+                    lower_bound[slot] <= search_bound(component_distance[labels[slot]].load(std::memory_order_relaxed))) {
+                    
+                    search(slot, no_edge, true);
+                    
+                }
+                
+            }
+            
+        });
+        
+        // Among each component's cheapest edges: smallest (low, high) location pair
+        auto tie_key = [&](size_t slot) {
+            
+            uint64_t a = locations[slot], b = locations[best_slot[slot]];
+            
+            return (std::min(a, b) << 32) | std::max(a, b);
+            
+        };
+        
+        parallel_for(count, num_threads, [&](size_t begin, size_t end) {
+            
+            for (size_t slot = begin; slot < end; slot++) {
+                
+                int64_t distance = best_distance[slot];
+                
+                if (distance != no_edge && distance == component_distance[labels[slot]].load(std::memory_order_relaxed)) {
+                    
+                    atomic_min(component_tie[labels[slot]], tie_key(slot));
+                    
+                }
+                
+            }
+            
+        });
+        
+        if (certified_bound != nullptr) {
+            
+            parallel_for(count, num_threads, [&](size_t begin, size_t end) {
+                
+                for (size_t slot = begin; slot < end; slot++) {
+                    
+                    atomic_min(component_bound[labels[slot]], lower_bound[slot]);
+                    
+                }
+                
+            });
+            
+        }
+        
+        // Every component adds its edge; the shared tie order rules out
+        // cycles (and with epsilon > 0, unite() skips the edges that close one)
+        std::atomic<size_t> merged(0);
+        
+        parallel_for(count, num_threads, [&](size_t begin, size_t end) {
+            
+            std::vector<MSTEdge> added;
+            
+            for (size_t slot = begin; slot < end; slot++) {
+                
+                uint64_t key = component_tie[slot].load(std::memory_order_relaxed);
+                
+                if (labels[slot] != slot || key == UINT64_MAX) {
+                    
+                    continue;
+                    
+                }
+                
+                uint32_t a = static_cast<uint32_t>(key >> 32);
+                uint32_t b = static_cast<uint32_t>(key & 0xffffffffu);
+                
+                if (components.unite(slot_of[a], slot_of[b])) {
+                    
+                    added.push_back({ squared_distance(coords[a], coords[b]), a, b });
+                    
+                    if (certified_bound != nullptr) {
+                        
+                        credits[slot] += squared_length(component_bound[slot].load(std::memory_order_relaxed));
+                        
+                    }
+                    
+                }
+                
+            }
+            
+            if (!added.empty()) {
+                
+                merged += added.size();
+                
+                std::lock_guard<std::mutex> guard(tree_lock);
+                
+                tree.insert(tree.end(), added.begin(), added.end());
+                
+            }
+            
+        });
+        
+        // Only possible if some location has no reachable location at all
+        if (merged == 0) {
+            
+            break;
+            
+        }
+        
+        num_components -= merged;
+        
+    }
+    
+    if (certified_bound != nullptr) {
+        
+        // Summed in slot order, so the bound doesn't depend on thread timing
+        *certified_bound = std::accumulate(credits.begin(), credits.end(), 0.0);
+        
+    }
+    
+}
+
+}
+
+// ----------------------------------------------------------------------------
+//                    Shared Helper Definitions
+// ----------------------------------------------------------------------------
+
+double edge_weight(const Coordinate &a, const Coordinate &b) {
+    
+    double dx = static_cast<double>(b.x) - static_cast<double>(a.x);
+    double dy = static_cast<double>(b.y) - static_cast<double>(a.y);
+    
+    return std::sqrt(dx * dx + dy * dy);
+    
+}
+
+void kruskal_mst(const Coordinate *coords, size_t count, std::vector<MSTEdge> &candidates, MSTResult &result) {
+    
+    std::sort(candidates.begin(), candidates.end(), [](const MSTEdge &a, const MSTEdge &b) {
+        
+        return edge_before(a.squared, a.from, a.to, b.squared, b.from, b.to);
+        
+    });
+    
+    std::vector<uint32_t> roots(count);
+    std::iota(roots.begin(), roots.end(), 0);
+    
+    std::vector<MSTEdge> tree;
+    tree.reserve(count);
+    
+    for (const MSTEdge &edge : candidates) {
+        
+        uint32_t a = find_root(roots, edge.from);
+        uint32_t b = find_root(roots, edge.to);
+        
+        if (a != b) {
+            
+            roots[a] = b;
+            
+            tree.push_back(edge);
+            
+            if (tree.size() + 1 == count) {
+                
+                break;
+                
+            }
+            
+        }
+        
+    }
+    
+    root_mst(coords, count, tree, result);
+    
+}
+
+void root_mst(const Coordinate *coords, size_t count, const std::vector<MSTEdge> &tree, MSTResult &result) {
+    
+    result.total_weight = 0;
+    result.parents.clear();
+    
+    if (count == 0) {
+        
+        return;
+        
+    }
+    
+    // Prim reports an unreachable location this way
+    if (tree.size() + 1 != count) {
+        
+        throw DroneError("Error: No closest location found. Program terminating");
+        
+    }
+    
+    // Adjacency in CSR form
+    std::vector<size_t> starts(count + 1, 0);
+    std::vector<uint32_t> adjacent(2 * tree.size());
+    
+    for (const MSTEdge &edge : tree) {
+        
+        starts[edge.from + 1]++;
+        starts[edge.to + 1]++;
+        
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        starts[i + 1] += starts[i];
+        
+    }
+    
+    std::vector<size_t> next(starts.begin(), starts.end() - 1);
+    
+    for (const MSTEdge &edge : tree) {
+        
+        adjacent[next[edge.from]++] = edge.to;
+        adjacent[next[edge.to]++] = edge.from;
+        
+    }
+    
+    // Depth-first from 0
+    result.parents.assign(count, SIZE_MAX);
+    result.parents[0] = 0;
+    
+    std::vector<uint32_t> stack(1, 0);
+    
+    while (!stack.empty()) {
+        
+        uint32_t location = stack.back();
+        stack.pop_back();
+        
+        for (size_t i = starts[location]; i < starts[location + 1]; i++) {
+            
+            uint32_t child = adjacent[i];
+            
+            if (result.parents[child] == SIZE_MAX) {
+                
+                result.parents[child] = location;
+                
+                stack.push_back(child);
+                
+            }
+            
+        }
+        
+    }
+    
+    // Summed in location order, like MST_get_total_distance()
+    for (size_t i = 1; i < count; i++) {
+        
+        result.total_weight += edge_weight(coords[i], coords[result.parents[i]]);
+        
+    }
+    
+}
@@ -0,0 +1,79 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  mst_engines.hpp
+//  project4
+//
+//  MST engines besides the Drone's own Prim (MSTEngine::Prim). Each one
+//  takes the locations as coordinates and fills an MSTResult rooted at
+//  location 0, with the total summed in location order like Prim's. A
+//  graph that cannot be spanned (Medical and Normal locations without a
+//  Border location) throws the same DroneError as Prim.
+//
+//  With distinct squared distances the MST is unique, so every engine
+//  prints exactly what Prim prints. With ties only the edge weights (and so
+//  the total, up to summation order) are guaranteed to match Prim's: Prim's
+//  choice among equal edges depends on the order it reaches locations,
+//  which no fixed edge order reproduces. The exact engines break ties by
+//  squared distance, then the smaller and larger location numbers, so
+//  zones and Borůvka always print the same tree.
+//
+
+#ifndef MST_ENGINES_HPP
+#define MST_ENGINES_HPP
+
+#include "drone.hpp"
+#include <cstdint>
+#include <vector>
+
+
+// ----------------------------------------------------------------------------
+//                    MST Engines
+// ----------------------------------------------------------------------------
+
+// Prim on Medical + Border and on Normal + Border (in parallel), then
+// Kruskal over the union of the two trees. Under the shared tie order every
+// MST edge lies in one of the two trees, and no Medical - Normal pair is
+// ever evaluated.
+void zone_prim_mst(const Coordinate *coords, size_t count, MSTResult &result);
+
+// Borůvka rounds on num_threads threads (0: one per core). Each location
+// searches grid rings outward for its nearest reachable location in another
+// component, stopping once the rings are farther than the best edge its
+// component has found so far; each component then takes its cheapest edge
+// (by squared distance, then the smaller and larger location numbers) and
+// the components merge through a lock-free union-find. Squared distances
+// are the keys from spatial.hpp, exact up to 2^62 and ordered beyond it.
+void boruvka_mst(const Coordinate *coords, size_t count, MSTResult &result, size_t num_threads = 0);
+
+// Borůvka as above, but a location stops searching once nothing unseen can
+// beat its component's best edge by more than a factor of 1 + epsilon. The
+// tree is valid but may be heavier than the MST; lower_bound receives a
+// certified lower bound on the exact MST weight, built from the distances
+// each round proved no other component is closer than (so the tree is
+// within total_weight / lower_bound - 1 of optimal).
+void approximate_mst(const Coordinate *coords, size_t count, double epsilon, MSTResult &result, double &lower_bound, size_t num_threads = 0);
+
+// ----------------------------------------------------------------------------
+//                    Shared Helpers
+// ----------------------------------------------------------------------------
+
+struct MSTEdge {
+
+    int64_t squared;
+    uint32_t from;
+    uint32_t to;
+
+};
+
+// Same formula as Drone::get_distance() (zones not checked)
+double edge_weight(const Coordinate &a, const Coordinate &b);
+
+// Kruskal over candidate edges (sorted here, by squared distance then
+// location numbers), then roots the tree at 0. Throws if the candidates don't span.
+void kruskal_mst(const Coordinate *coords, size_t count, std::vector<MSTEdge> &candidates, MSTResult &result);
+
+// Fills result.parents (rooted at 0) and result.total_weight from the n - 1
+// edges of a spanning tree
+void root_mst(const Coordinate *coords, size_t count, const std::vector<MSTEdge> &tree, MSTResult &result);
+
+#endif /* MST_ENGINES_HPP */
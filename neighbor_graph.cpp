@@ -0,0 +1,250 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  neighbor_graph.cpp
+//  project4
+//
+
+#include "neighbor_graph.hpp"
+#include "spatial.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+
+namespace {
+
+struct Candidate {
+    
+    int64_t distance;
+    uint32_t location;
+    bool border;
+    
+    bool operator<(const Candidate &other) const {
+        
+        return distance < other.distance || (distance == other.distance && location < other.location);
+        
+    }
+    
+};
+
+// Points handed to a worker at a time (in grid order, for locality)
+const size_t knn_chunk_size = 4096;
+
+}
+
+// ----------------------------------------------------------------------------
+//                    NeighborGraph Definitions
+// ----------------------------------------------------------------------------
+
+NeighborGraph::NeighborGraph() {
+    
+    offsets.assign(1, 0);
+    
+}
+
+void NeighborGraph::build(const Coordinate *coords, size_t count, size_t k, bool zones, size_t num_threads) {
+    
+    if (num_threads == 0) {
+        
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+        
+    }
+    
+    std::vector<uint32_t> ids(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        ids[i] = static_cast<uint32_t>(i);
+        
+    }
+    
+    StaticGrid grid;
+    
+    grid.build(coords, ids.data(), count, 2.0);
+    
+    BorderIndex borders;
+    
+    if (zones) {
+        
+        borders.build(coords, count);
+        
+    }
+    
+    // Fixed stride while building: k nearest plus room for a Border location
+    size_t stride = k + 1;
+    
+    neighbors.resize(count * stride);
+    
+    std::vector<uint32_t> degrees(count, 0);
+    
+    std::atomic<size_t> next_chunk(0);
+    
+    auto worker = [&]() {
+        
+        // Sorted nearest first
+        std::vector<Candidate> best;
+        best.reserve(k + 1);
+        
+        // Walking the grid's own copies keeps every read close to the last
+        const std::vector<uint32_t> &order = grid.get_points();
+        const std::vector<Coordinate> &order_coords = grid.get_point_coords();
+        
+        for (size_t chunk = next_chunk++; chunk * knn_chunk_size < count; chunk = next_chunk++) {
+            
+            size_t chunk_end = std::min(count, (chunk + 1) * knn_chunk_size);
+            
+            for (size_t position = chunk * knn_chunk_size; position < chunk_end; position++) {
+                
+                uint32_t location = order[position];
+                
+                const Coordinate &c = order_coords[position];
+                
+                LocationType type = zones ? zone_of(c) : LocationType::Empty;
+                
+                best.clear();
+                
+                for (int64_t ring = 0; ; ring++) {
+                    
+                    bool inside = grid.visit_ring(c, ring, [&](uint32_t other, const Coordinate &other_c) {
+                        
+                        if (other == location || (zones && !zones_compatible(type, zone_of(other_c)))) {
+                            
+                            return;
+                            
+                        }
+                        
+                        Candidate candidate = { squared_distance(c, other_c), other, false };
+                        
+                        if (best.size() == k && !(candidate < best.back())) {
+                            
+                            return;
+                            
+                        }
+                        
+                        if (best.size() == k) {
+                            
+                            best.pop_back();
+                            
+                        }
+                        
+                        candidate.border = zones && zone_of(other_c) == LocationType::Border;
+                        
+                        best.insert(std::upper_bound(best.begin(), best.end(), candidate), candidate);
+                        
+                    });
+                    
+                    if (!inside) {
+                        
+                        break;
+                        
+                    }
+                    
+                    // Nothing beyond this ring can be closer than the k-th
+                    int64_t bound = grid.ring_lower_bound(ring);
+                    
+                    if (best.size() == k && best.back().distance <= squared_offset(bound, 0)) {
+                        
+                        break;
+                        
+                    }
+                    
+                }
+                
+                uint32_t *out = &neighbors[location * stride];
+                uint32_t degree = 0;
+                
+                bool has_border = false;
+                
+                for (const Candidate &entry : best) {
+                    
+                    out[degree++] = entry.location;
+                    
+                    has_border = has_border || entry.border;
+                    
+                }
+                
+                // Keep a way across the zones
+                if (zones && !has_border && type != LocationType::Border && !borders.empty()) {
+                    
+                    out[degree++] = static_cast<uint32_t>(borders.nearest(c));
+                    
+                }
+                
+                degrees[location] = degree;
+                
+            }
+            
+        }
+        
+    };
+    
+    std::vector<std::thread> workers;
+    
+    for (size_t t = 1; t < num_threads; t++) {
+        
+        workers.emplace_back(worker);
+        
+    }
+    
+    worker();
+    
+    for (std::thread &t : workers) {
+        
+        t.join();
+        
+    }
+    
+    // Squeeze the fixed-stride rows together (each row only moves left)
+    offsets.resize(count + 1);
+    offsets[0] = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        offsets[i + 1] = offsets[i] + degrees[i];
+        
+        std::copy(neighbors.begin() + static_cast<std::ptrdiff_t>(i * stride),
+                  neighbors.begin() + static_cast<std::ptrdiff_t>(i * stride + degrees[i]),
+                  neighbors.begin() + static_cast<std::ptrdiff_t>(offsets[i]));
+        
+    }
+    
+    neighbors.resize(offsets[count]);
+    neighbors.shrink_to_fit();
+    
+}
+
+size_t NeighborGraph::size() const {
+    
+    return offsets.size() - 1;
+    
+}
+
+const uint32_t *NeighborGraph::begin(size_t location) const {
+    
+    return neighbors.data() + offsets[location];
+    
+}
+
+const uint32_t *NeighborGraph::end(size_t location) const {
+    
+    return neighbors.data() + offsets[location + 1];
+    
+}
+
+size_t NeighborGraph::degree(size_t location) const {
+    
+    return static_cast<size_t>(offsets[location + 1] - offsets[location]);
+    
+}
+
+size_t NeighborGraph::num_edges() const {
+    
+    return neighbors.size();
+    
+}
+
+size_t NeighborGraph::memory_bytes() const {
+    
+    return offsets.capacity() * sizeof(uint64_t) + neighbors.capacity() * sizeof(uint32_t);
+    
+}
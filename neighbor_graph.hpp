@@ -0,0 +1,75 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  neighbor_graph.hpp
+//  project4
+//
+//  k-nearest-neighbor candidate graph, for the solvers that only need to
+//  look at nearby locations (sparse MSTs, local search, insertion).
+//
+//  Built from a StaticGrid by std::thread workers. With zones on, the MST
+//  reachability rule applies (Medical and Normal locations are never each
+//  other's neighbors) and every Medical/Normal location also keeps its
+//  nearest Border location, so the graph can always cross between zones.
+//
+//  Stored as CSR: neighbors of location i are
+//  neighbors[offsets[i] .. offsets[i + 1]), nearest first (the added Border
+//  location, if any, comes last). Memory is 8 bytes per location for the
+//  offsets plus 4 bytes per edge, about (8 + 4 * k) bytes per location; a
+//  fixed-stride scratch array of 4 * (k + 1) bytes per location is used
+//  while building.
+//
+//  Measured with bench/bench_knn.cpp (uniform locations, zones on, k = 10,
+//  one core):
+//
+//      locations    build       graph
+//      1M           1.3 s        52 MB
+//      10M         17.4 s       520 MB
+//
+//  Queries run in grid order, so the build scales with the thread count
+//  apart from the final compaction.
+//
+
+#ifndef NEIGHBOR_GRAPH_HPP
+#define NEIGHBOR_GRAPH_HPP
+
+#include "drone.hpp"
+#include <cstdint>
+#include <vector>
+
+
+// ----------------------------------------------------------------------------
+//                    NeighborGraph Declarations
+// ----------------------------------------------------------------------------
+
+class NeighborGraph {
+
+public:
+
+    NeighborGraph();
+
+    // zones: apply the MST reachability rule (MST mode); num_threads = 0
+    // uses one thread per core
+    void build(const Coordinate *coords, size_t count, size_t k, bool zones, size_t num_threads = 0);
+
+    size_t size() const;
+
+    const uint32_t *begin(size_t location) const;
+
+    const uint32_t *end(size_t location) const;
+
+    size_t degree(size_t location) const;
+
+    size_t num_edges() const;
+
+    // Bytes held by the CSR arrays
+    size_t memory_bytes() const;
+
+private:
+
+    std::vector<uint64_t> offsets;
+
+    std::vector<uint32_t> neighbors;
+
+};
+
+#endif /* NEIGHBOR_GRAPH_HPP */
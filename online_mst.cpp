@@ -0,0 +1,641 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  online_mst.cpp
+//  project4
+//
+
+#include "online_mst.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+
+namespace {
+
+const uint32_t no_location = std::numeric_limits<uint32_t>::max();
+
+uint32_t find_root(std::vector<uint32_t> &uf_parent, uint32_t x) {
+    
+    while (uf_parent[x] != x) {
+        
+        uf_parent[x] = uf_parent[uf_parent[x]];
+        x = uf_parent[x];
+        
+    }
+    
+    return x;
+    
+}
+
+}
+
+// ----------------------------------------------------------------------------
+//                    OnlineMST Definitions
+// ----------------------------------------------------------------------------
+
+OnlineMST::OnlineMST() {
+    
+    total_weight = 0;
+    
+    num_alive = 0;
+    num_edges = 0;
+    
+    current_stamp = 0;
+    
+}
+
+void OnlineMST::seed(const Coordinate *coords_in, size_t count, const MSTResult &mst) {
+    
+    coords.assign(coords_in, coords_in + count);
+    
+    zones.resize(count);
+    alive.assign(count, 1);
+    
+    adjacency.assign(count, std::vector<uint32_t>());
+    
+    visit_stamp.assign(count, 0);
+    path_parent.assign(count, no_location);
+    piece_of.assign(count, 0);
+    current_stamp = 0;
+    
+    total_weight = 0;
+    num_alive = count;
+    num_edges = 0;
+    
+    // ~2 locations per cell
+    grid.reset(coords_in, count, 2.0);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        zones[i] = zone_of(coords[i]);
+        
+        grid.insert(static_cast<uint32_t>(i), coords[i]);
+        
+    }
+    
+    // Location 0 is the root; every other location hangs off its parent
+    for (size_t i = 1; i < mst.parents.size() && i < count; i++) {
+        
+        add_edge(static_cast<uint32_t>(i), static_cast<uint32_t>(mst.parents[i]));
+        
+    }
+    
+}
+
+size_t OnlineMST::add_location(const Coordinate &c) {
+    
+    uint32_t id = static_cast<uint32_t>(coords.size());
+    
+    coords.push_back(c);
+    zones.push_back(zone_of(c));
+    alive.push_back(1);
+    adjacency.emplace_back();
+    
+    visit_stamp.push_back(0);
+    path_parent.push_back(no_location);
+    piece_of.push_back(0);
+    
+    grid.insert(id, c);
+    num_alive++;
+    
+    cone_candidates(id, candidates);
+    
+    // Shortest candidates first, so later cycles are closed by longer edges
+    std::sort(candidates.begin(), candidates.end(), [&](uint32_t a, uint32_t b) {
+        
+        int64_t da = squared_distance(coords[id], coords[a]);
+        int64_t db = squared_distance(coords[id], coords[b]);
+        
+        return (da != db) ? (da < db) : (a < b);
+        
+    });
+    
+    for (uint32_t u : candidates) {
+        
+        // First edge, or u is in another tree: nothing to replace
+        if (adjacency[id].empty() || !find_path(id, u)) {
+            
+            add_edge(id, u);
+            
+            continue;
+            
+        }
+        
+        // Heaviest edge on the tree path u -> id
+        int64_t max_d2 = -1;
+        uint32_t max_a = no_location, max_b = no_location;
+        
+        for (uint32_t w = u; w != id; w = path_parent[w]) {
+            
+            int64_t d2 = squared_distance(coords[w], coords[path_parent[w]]);
+            
+            if (d2 > max_d2) {
+                
+                max_d2 = d2;
+                max_a = w;
+                max_b = path_parent[w];
+                
+            }
+            
+        }
+        
+        if (max_d2 > squared_distance(coords[id], coords[u])) {
+            
+            remove_edge(max_a, max_b);
+            
+            add_edge(id, u);
+            
+        }
+        
+    }
+    
+    return id;
+    
+}
+
+void OnlineMST::remove_location(size_t location_num) {
+    
+    if (location_num >= coords.size() || !alive[location_num]) {
+        
+        throw DroneError("Error: location " + std::to_string(location_num) + " does not exist");
+        
+    }
+    
+    uint32_t v = static_cast<uint32_t>(location_num);
+    
+    std::vector<uint32_t> neighbors = adjacency[v];
+    
+    for (uint32_t u : neighbors) {
+        
+        remove_edge(v, u);
+        
+    }
+    
+    alive[v] = 0;
+    
+    grid.remove(v, coords[v]);
+    num_alive--;
+    
+    // A leaf leaves the rest of the tree intact
+    if (neighbors.size() > 1) {
+        
+        reconnect_pieces(neighbors);
+        
+    }
+    
+}
+
+bool OnlineMST::is_connected() const {
+    
+    return num_alive <= 1 || num_edges + 1 == num_alive;
+    
+}
+
+double OnlineMST::get_total_weight() const {
+    
+    return total_weight;
+    
+}
+
+void OnlineMST::print(std::ostream &os) {
+    
+    if (!is_connected()) {
+        
+        os << "Cannot construct MST\n";
+        
+        return;
+        
+    }
+    
+    os << total_weight << "\n";
+    
+    uint32_t root = no_location;
+    
+    for (uint32_t i = 0; i < coords.size(); i++) {
+        
+        if (alive[i]) {
+            
+            root = i;
+            
+            break;
+            
+        }
+        
+    }
+    
+    if (root == no_location) {
+        
+        return;
+        
+    }
+    
+    // Root the tree so each location prints the edge to its parent
+    uint32_t stamp = next_stamp();
+    
+    work_stack.clear();
+    work_stack.push_back(root);
+    visit_stamp[root] = stamp;
+    path_parent[root] = root;
+    
+    while (!work_stack.empty()) {
+        
+        uint32_t u = work_stack.back();
+        work_stack.pop_back();
+        
+        for (uint32_t w : adjacency[u]) {
+            
+            if (visit_stamp[w] != stamp) {
+                
+                visit_stamp[w] = stamp;
+                path_parent[w] = u;
+                
+                work_stack.push_back(w);
+                
+            }
+            
+        }
+        
+    }
+    
+    for (uint32_t i = 0; i < coords.size(); i++) {
+        
+        if (!alive[i] || i == root) {
+            
+            continue;
+            
+        }
+        
+        uint32_t parent = path_parent[i];
+        
+        os << std::min(i, parent) << " " << std::max(i, parent) << "\n";
+        
+    }
+    
+}
+
+uint32_t OnlineMST::next_stamp() {
+    
+    // Start over before the counter wraps around
+    if (++current_stamp == 0) {
+        
+        std::fill(visit_stamp.begin(), visit_stamp.end(), 0);
+        
+        current_stamp = 1;
+        
+    }
+    
+    return current_stamp;
+    
+}
+
+double OnlineMST::edge_length(uint32_t a, uint32_t b) const {
+    
+    return squared_length(squared_distance(coords[a], coords[b]));
+    
+}
+
+void OnlineMST::add_edge(uint32_t a, uint32_t b) {
+    
+    adjacency[a].push_back(b);
+    adjacency[b].push_back(a);
+    
+    total_weight += edge_length(a, b);
+    
+    num_edges++;
+    
+}
+
+void OnlineMST::remove_edge(uint32_t a, uint32_t b) {
+    
+    for (uint32_t end = 0; end < 2; end++) {
+        
+        std::vector<uint32_t> &list = adjacency[end == 0 ? a : b];
+        uint32_t other = (end == 0) ? b : a;
+        
+        auto it = std::find(list.begin(), list.end(), other);
+        
+        *it = list.back();
+        list.pop_back();
+        
+    }
+    
+    total_weight -= edge_length(a, b);
+    
+    num_edges--;
+    
+}
+
+void OnlineMST::cone_candidates(uint32_t v, std::vector<uint32_t> &out) {
+    
+    const Coordinate &c = coords[v];
+    LocationType zone = zones[v];
+    
+    // Medical only needs class 0 and Normal only class 1. A Border location
+    // needs both, so that a Medical and a Normal candidate can't hide each
+    // other (they can't be joined directly).
+    bool active[2] = { zone != LocationType::Normal, zone != LocationType::Medical };
+    
+    int64_t best_d2[2][num_octants];
+    uint32_t best_id[2][num_octants];
+    
+    for (size_t k = 0; k < 2; k++) {
+        
+        for (size_t o = 0; o < num_octants; o++) {
+            
+            best_d2[k][o] = std::numeric_limits<int64_t>::max();
+            best_id[k][o] = no_location;
+            
+        }
+        
+    }
+    
+    grid.visit_rings(c, [&](uint32_t id) {
+        
+        if (id == v || !zones_compatible(zone, zones[id])) {
+            
+            return;
+            
+        }
+        
+        size_t o = octant_of(c, coords[id]);
+        int64_t d2 = squared_distance(c, coords[id]);
+        
+        for (size_t k = 0; k < 2; k++) {
+            
+            if (active[k] && in_zone_class(zones[id], k) &&
+                (d2 < best_d2[k][o] || (d2 == best_d2[k][o] && id < best_id[k][o]))) {
+                
+                best_d2[k][o] = d2;
+                best_id[k][o] = id;
+                
+            }
+            
+        }
+        
+    }, [&](int64_t ring) {
+        
+        // Done once nothing further out can beat any cone's best
+        double bound = grid.ring_lower_bound(ring);
+        
+        for (size_t k = 0; k < 2; k++) {
+            
+            for (size_t o = 0; o < num_octants; o++) {
+                
+                if (active[k] && squared_value(best_d2[k][o]) > bound * bound) {
+                    
+                    return false;
+                    
+                }
+                
+            }
+            
+        }
+        
+        return true;
+        
+    });
+    
+    out.clear();
+    
+    for (size_t k = 0; k < 2; k++) {
+        
+        for (size_t o = 0; o < num_octants; o++) {
+            
+            if (best_id[k][o] != no_location) {
+                
+                out.push_back(best_id[k][o]);
+                
+            }
+            
+        }
+        
+    }
+    
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    
+}
+
+bool OnlineMST::find_path(uint32_t from, uint32_t to) {
+    
+    uint32_t stamp = next_stamp();
+    
+    work_stack.clear();
+    work_stack.push_back(from);
+    visit_stamp[from] = stamp;
+    path_parent[from] = from;
+    
+    while (!work_stack.empty()) {
+        
+        uint32_t u = work_stack.back();
+        work_stack.pop_back();
+        
+        if (u == to) {
+            
+            return true;
+            
+        }
+        
+        for (uint32_t w : adjacency[u]) {
+            
+            if (visit_stamp[w] != stamp) {
+                
+                visit_stamp[w] = stamp;
+                path_parent[w] = u;
+                
+                work_stack.push_back(w);
+                
+            }
+            
+        }
+        
+    }
+    
+    return false;
+    
+}
+
+void OnlineMST::reconnect_pieces(const std::vector<uint32_t> &neighbors) {
+    
+    uint32_t num_pieces = static_cast<uint32_t>(neighbors.size());
+    uint32_t stamp = next_stamp();
+    
+    // Grow every piece one location at a time; the last piece still growing
+    // is the largest and is never walked in full
+    std::vector<std::vector<uint32_t>> piece_members(num_pieces);
+    std::vector<size_t> heads(num_pieces, 0);
+    std::vector<char> finished(num_pieces, 0);
+    
+    for (uint32_t i = 0; i < num_pieces; i++) {
+        
+        visit_stamp[neighbors[i]] = stamp;
+        piece_of[neighbors[i]] = i;
+        
+        piece_members[i].push_back(neighbors[i]);
+        
+    }
+    
+    uint32_t num_growing = num_pieces;
+    uint32_t rest = num_pieces - 1;
+    
+    while (num_growing > 1) {
+        
+        for (uint32_t i = 0; i < num_pieces && num_growing > 1; i++) {
+            
+            if (finished[i]) {
+                
+                continue;
+                
+            }
+            
+            if (heads[i] == piece_members[i].size()) {
+                
+                finished[i] = 1;
+                num_growing--;
+                
+                continue;
+                
+            }
+            
+            uint32_t u = piece_members[i][heads[i]++];
+            
+            for (uint32_t w : adjacency[u]) {
+                
+                if (visit_stamp[w] != stamp) {
+                    
+                    visit_stamp[w] = stamp;
+                    piece_of[w] = i;
+                    
+                    piece_members[i].push_back(w);
+                    
+                }
+                
+            }
+            
+        }
+        
+    }
+    
+    for (uint32_t i = 0; i < num_pieces; i++) {
+        
+        if (!finished[i]) {
+            
+            rest = i;
+            
+        }
+        
+    }
+    
+    // Union-find over pieces; unlabeled locations belong to 'rest'
+    std::vector<uint32_t> uf_parent(num_pieces);
+    
+    for (uint32_t i = 0; i < num_pieces; i++) {
+        
+        uf_parent[i] = i;
+        
+    }
+    
+    auto piece_root = [&](uint32_t location) {
+        
+        return find_root(uf_parent, (visit_stamp[location] == stamp) ? piece_of[location] : rest);
+        
+    };
+    
+    std::vector<int64_t> best_d2(num_pieces);
+    std::vector<uint32_t> best_a(num_pieces), best_b(num_pieces);
+    
+    while (true) {
+        
+        uint32_t rest_root = find_root(uf_parent, rest);
+        
+        std::fill(best_d2.begin(), best_d2.end(), std::numeric_limits<int64_t>::max());
+        
+        // Cheapest edge leaving each piece that isn't part of 'rest' yet
+        for (uint32_t i = 0; i < num_pieces; i++) {
+            
+            uint32_t root = find_root(uf_parent, i);
+            
+            if (root == rest_root) {
+                
+                continue;
+                
+            }
+            
+            for (uint32_t p : piece_members[i]) {
+                
+                const Coordinate &c = coords[p];
+                
+                grid.visit_rings(c, [&](uint32_t id) {
+                    
+                    if (!zones_compatible(zones[p], zones[id]) || piece_root(id) == root) {
+                        
+                        return;
+                        
+                    }
+                    
+                    int64_t d2 = squared_distance(c, coords[id]);
+                    
+                    if (d2 < best_d2[root]) {
+                        
+                        best_d2[root] = d2;
+                        best_a[root] = p;
+                        best_b[root] = id;
+                        
+                    }
+                    
+                }, [&](int64_t ring) {
+                    
+                    double bound = grid.ring_lower_bound(ring);
+                    
+                    return squared_value(best_d2[root]) <= bound * bound;
+                    
+                });
+                
+            }
+            
+        }
+        
+        bool merged = false;
+        
+        for (uint32_t i = 0; i < num_pieces; i++) {
+            
+            if (best_d2[i] == std::numeric_limits<int64_t>::max()) {
+                
+                continue;
+                
+            }
+            
+            uint32_t root_a = piece_root(best_a[i]);
+            uint32_t root_b = piece_root(best_b[i]);
+            
+            if (root_a != root_b) {
+                
+                uf_parent[root_a] = root_b;
+                
+                add_edge(best_a[i], best_b[i]);
+                
+                merged = true;
+                
+            }
+            
+        }
+        
+        bool all_joined = true;
+        
+        for (uint32_t i = 0; i < num_pieces; i++) {
+            
+            all_joined = all_joined && (find_root(uf_parent, i) == find_root(uf_parent, rest));
+            
+        }
+        
+        // Everything joined, or the remaining pieces can't be reached
+        if (all_joined || !merged) {
+            
+            break;
+            
+        }
+        
+    }
+    
+}
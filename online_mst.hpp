@@ -0,0 +1,109 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  online_mst.hpp
+//  project4
+//
+//  Minimum spanning tree that follows insertions and deletions of
+//  locations without being rebuilt.
+//
+//  Adding a location: the new tree is contained in the old tree plus the
+//  edges of the new location, and of those only the nearest compatible
+//  location in each of 8 cones can be an MST edge. Each candidate edge is
+//  added and the heaviest edge on the cycle it closes is dropped.
+//
+//  Removing a location: every other tree edge stays in the tree. The pieces
+//  left behind are joined Boruvka-style, each piece except the largest
+//  searching the grid for its cheapest edge to another piece.
+//
+//  Cost: the cycle of each candidate edge is found by walking the tree
+//  (find_path()), so an add is O(n) per candidate, up to 16 candidates:
+//  O(n) per update, not polylogarithmic. Measured on uniform locations
+//  (one core): about 1.7 ms per add at 20000 locations and 25 ms at
+//  100000, against 50 ms and 0.27 s for a Borůvka rebuild. That is cheaper
+//  than a rebuild by a constant factor only; a link-cut tree for the path
+//  maxima would make adds logarithmic.
+//
+
+#ifndef ONLINE_MST_HPP
+#define ONLINE_MST_HPP
+
+#include "drone.hpp"
+#include "spatial.hpp"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+
+// ----------------------------------------------------------------------------
+//                    OnlineMST Declarations
+// ----------------------------------------------------------------------------
+
+class OnlineMST {
+
+public:
+
+    OnlineMST();
+
+    // Seeds the tree from prim_algorithm()'s output for the same locations
+    void seed(const Coordinate *coords, size_t count, const MSTResult &mst);
+
+    // Returns the new location's number (locations are numbered in order of
+    // arrival; numbers of removed locations are not reused)
+    size_t add_location(const Coordinate &c);
+
+    // Throws DroneError if the location doesn't exist
+    void remove_location(size_t location_num);
+
+    // false when Medical and Normal locations are no longer joined through a
+    // Border location
+    bool is_connected() const;
+
+    double get_total_weight() const;
+
+    // Same format as MST_print(); the smallest remaining location is the root
+    void print(std::ostream &os);
+
+private:
+
+    uint32_t next_stamp();
+
+    double edge_length(uint32_t a, uint32_t b) const;
+
+    void add_edge(uint32_t a, uint32_t b);
+
+    void remove_edge(uint32_t a, uint32_t b);
+
+    // Nearest compatible location in each cone around location v
+    void cone_candidates(uint32_t v, std::vector<uint32_t> &candidates);
+
+    // Walks the tree from 'from' to 'to'; fills path_parent. Returns false if
+    // they are in different trees
+    bool find_path(uint32_t from, uint32_t to);
+
+    void reconnect_pieces(const std::vector<uint32_t> &neighbors);
+
+    std::vector<Coordinate> coords;
+    std::vector<LocationType> zones;
+    std::vector<char> alive;
+
+    std::vector<std::vector<uint32_t>> adjacency;
+
+    PointGrid grid;
+
+    double total_weight;
+
+    size_t num_alive;
+    size_t num_edges;
+
+    // Scratch space reused by every update
+    std::vector<uint32_t> visit_stamp;
+    uint32_t current_stamp;
+
+    std::vector<uint32_t> path_parent;
+    std::vector<uint32_t> piece_of;
+    std::vector<uint32_t> work_stack;
+    std::vector<uint32_t> candidates;
+
+};
+
+#endif /* ONLINE_MST_HPP */
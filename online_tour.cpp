@@ -0,0 +1,554 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  online_tour.cpp
+//  project4
+//
+
+#include "online_tour.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+
+namespace {
+
+// Stops looked at around a location (their tour edges are the candidates)
+const size_t num_nearest = 8;
+
+// Longest stretch of the tour a repair move may reverse
+const size_t max_reverse = 50;
+
+// Improving moves allowed per update
+const size_t max_repair_moves = 32;
+
+const double min_gain = 1e-9;
+
+}
+
+// ----------------------------------------------------------------------------
+//                    OnlineTour Definitions
+// ----------------------------------------------------------------------------
+
+OnlineTour::OnlineTour() {
+    
+    total_distance = 0;
+    
+    num_stops = 0;
+    
+    repair_enabled = false;
+    
+}
+
+void OnlineTour::seed(const Coordinate *coords_in, size_t count, const std::vector<size_t> &path) {
+    
+    reset(coords_in, count);
+    
+    for (size_t i = 0; i < path.size(); i++) {
+        
+        uint32_t a = static_cast<uint32_t>(path[i]);
+        uint32_t b = static_cast<uint32_t>(path[(i + 1) % path.size()]);
+        
+        next[a] = b;
+        prev[b] = a;
+        
+        total_distance += distance(a, b);
+        
+        alive[a] = 1;
+        grid.insert(a, coords[a]);
+        
+    }
+    
+    num_stops = path.size();
+    
+}
+
+void OnlineTour::build(const Coordinate *coords_in, size_t count) {
+    
+    reset(coords_in, count);
+    
+    bool repair_setting = repair_enabled;
+    repair_enabled = false;
+    
+    for (uint32_t i = 0; i < count; i++) {
+        
+        alive[i] = 1;
+        
+        insert_cheapest(i);
+        
+    }
+    
+    repair_enabled = repair_setting;
+    
+}
+
+void OnlineTour::set_repair(bool repair_in) {
+    
+    repair_enabled = repair_in;
+    
+}
+
+size_t OnlineTour::add_location(const Coordinate &c) {
+    
+    append_location(c);
+    
+    uint32_t id = static_cast<uint32_t>(coords.size() - 1);
+    
+    insert_cheapest(id);
+    
+    return id;
+    
+}
+
+void OnlineTour::remove_location(size_t location_num) {
+    
+    if (location_num >= coords.size() || !alive[location_num]) {
+        
+        throw DroneError("Error: location " + std::to_string(location_num) + " does not exist");
+        
+    }
+    
+    uint32_t v = static_cast<uint32_t>(location_num);
+    uint32_t a = prev[v];
+    uint32_t b = next[v];
+    
+    if (num_stops <= 2) {
+        
+        // Zero or one stop left: no edges
+        total_distance = 0;
+        
+        next[b] = b;
+        prev[b] = b;
+        
+    }
+    
+    else {
+        
+        // Splice v out: a -> v -> b becomes a -> b
+        total_distance += distance(a, b) - distance(a, v) - distance(v, b);
+        
+        next[a] = b;
+        prev[b] = a;
+        
+    }
+    
+    alive[v] = 0;
+    
+    grid.remove(v, coords[v]);
+    num_stops--;
+    
+    if (repair_enabled && num_stops >= 4) {
+        
+        worklist.clear();
+        worklist.push_back(a);
+        worklist.push_back(b);
+        
+        repair();
+        
+    }
+    
+}
+
+void OnlineTour::insert_location(size_t location_num) {
+    
+    if (location_num >= coords.size() || alive[location_num]) {
+        
+        throw DroneError("Error: location " + std::to_string(location_num) + " can't be inserted");
+        
+    }
+    
+    alive[location_num] = 1;
+    
+    insert_cheapest(static_cast<uint32_t>(location_num));
+    
+}
+
+void OnlineTour::repair_around(size_t location_num) {
+    
+    if (!repair_enabled || num_stops < 4 || !alive[location_num]) {
+        
+        return;
+        
+    }
+    
+    worklist.clear();
+    worklist.push_back(prev[location_num]);
+    worklist.push_back(static_cast<uint32_t>(location_num));
+    
+    repair();
+    
+}
+
+double OnlineTour::get_total_distance() const {
+    
+    return total_distance;
+    
+}
+
+size_t OnlineTour::size() const {
+    
+    return num_stops;
+    
+}
+
+void OnlineTour::get_path(std::vector<size_t> &path) const {
+    
+    path.clear();
+    
+    if (num_stops == 0) {
+        
+        return;
+        
+    }
+    
+    uint32_t start = 0;
+    
+    while (!alive[start]) {
+        
+        start++;
+        
+    }
+    
+    uint32_t current = start;
+    
+    do {
+        
+        path.push_back(current);
+        
+        current = next[current];
+        
+    } while (current != start);
+    
+}
+
+void OnlineTour::print(std::ostream &os) const {
+    
+    TourResult result;
+    
+    result.total_distance = total_distance;
+    
+    get_path(result.path);
+    
+    FAST_print(os, result);
+    
+    // each answer on its own line in the command stream
+    os << "\n";
+    
+}
+
+double OnlineTour::distance(uint32_t a, uint32_t b) const {
+    
+    return squared_length(squared_distance(coords[a], coords[b]));
+    
+}
+
+void OnlineTour::reset(const Coordinate *coords_in, size_t count) {
+    
+    coords.assign(coords_in, coords_in + count);
+    
+    alive.assign(count, 0);
+    
+    next.resize(count);
+    prev.resize(count);
+    
+    for (uint32_t i = 0; i < count; i++) {
+        
+        next[i] = prev[i] = i;
+        
+    }
+    
+    total_distance = 0;
+    
+    num_stops = 0;
+    
+    // ~2 stops per cell
+    grid.reset(coords_in, count, 2.0);
+    
+}
+
+void OnlineTour::append_location(const Coordinate &c) {
+    
+    uint32_t id = static_cast<uint32_t>(coords.size());
+    
+    coords.push_back(c);
+    alive.push_back(1);
+    
+    next.push_back(id);
+    prev.push_back(id);
+    
+}
+
+void OnlineTour::insert_cheapest(uint32_t id) {
+    
+    if (num_stops == 0) {
+        
+        next[id] = prev[id] = id;
+        
+    }
+    
+    else {
+        
+        nearest_stops(coords[id], id);
+        
+        uint32_t best_a = nearby[0];
+        double best_change = std::numeric_limits<double>::infinity();
+        
+        for (uint32_t s : nearby) {
+            
+            // Both tour edges touching this stop
+            uint32_t ends[2] = { prev[s], s };
+            
+            for (uint32_t a : ends) {
+                
+                uint32_t b = next[a];
+                
+                // Formula: change in distance = d(i, k) + d(k, j) - d(i, j)
+                double change = distance(a, id) + distance(id, b) - ((a == b) ? 0 : distance(a, b));
+                
+                if (change < best_change) {
+                    
+                    best_change = change;
+                    best_a = a;
+                    
+                }
+                
+            }
+            
+        }
+        
+        uint32_t best_b = next[best_a];
+        
+        next[best_a] = id;
+        prev[id] = best_a;
+        next[id] = best_b;
+        prev[best_b] = id;
+        
+        total_distance += best_change;
+        
+    }
+    
+    grid.insert(id, coords[id]);
+    num_stops++;
+    
+    if (repair_enabled && num_stops >= 4) {
+        
+        worklist.clear();
+        worklist.push_back(prev[id]);
+        worklist.push_back(id);
+        
+        repair();
+        
+    }
+    
+}
+
+void OnlineTour::nearest_stops(const Coordinate &c, uint32_t exclude) {
+    
+    nearby.clear();
+    
+    auto closer = [&](uint32_t a, uint32_t b) {
+        
+        int64_t da = squared_distance(c, coords[a]);
+        int64_t db = squared_distance(c, coords[b]);
+        
+        return (da != db) ? (da < db) : (a < b);
+        
+    };
+    
+    // Bounded even for a stop far from the tour (see visit_rings())
+    grid.visit_rings(c, [&](uint32_t id) {
+        
+        if (id != exclude) {
+            
+            nearby.push_back(id);
+            
+        }
+        
+    }, [&](int64_t ring) {
+        
+        // Stop once the num_nearest-th closest can't be beaten further out
+        if (nearby.size() < num_nearest) {
+            
+            return false;
+            
+        }
+        
+        // The rest can't be among the closest; dropping them keeps each
+        // ring's selection small
+        std::nth_element(nearby.begin(), nearby.begin() + num_nearest - 1, nearby.end(), closer);
+        
+        nearby.resize(num_nearest);
+        
+        double bound = grid.ring_lower_bound(ring);
+        
+        return squared_value(squared_distance(c, coords[nearby[num_nearest - 1]])) <= bound * bound;
+        
+    });
+    
+    // Only the closest num_nearest are sorted (a far stop may have
+    // collected every other one)
+    if (nearby.size() > num_nearest) {
+        
+        std::nth_element(nearby.begin(), nearby.begin() + num_nearest - 1, nearby.end(), closer);
+        
+        nearby.resize(num_nearest);
+        
+    }
+    
+    std::sort(nearby.begin(), nearby.end(), closer);
+    
+}
+
+void OnlineTour::repair() {
+    
+    size_t moves = 0;
+    
+    while (!worklist.empty() && moves < max_repair_moves) {
+        
+        uint32_t a = worklist.back();
+        worklist.pop_back();
+        
+        if (alive[a] && try_2opt(a)) {
+            
+            moves++;
+            
+        }
+        
+    }
+    
+}
+
+bool OnlineTour::try_2opt(uint32_t a) {
+    
+    nearest_stops(coords[a], a);
+    
+    // nearest_stops() reuses 'nearby', so work from a copy
+    uint32_t candidates[num_nearest];
+    size_t num_candidates = nearby.size();
+    
+    std::copy(nearby.begin(), nearby.end(), candidates);
+    
+    for (size_t i = 0; i < num_candidates; i++) {
+        
+        uint32_t c = candidates[i];
+        
+        // Successor side: (a, next a) and (c, next c) -> (a, c) and (next a, next c)
+        uint32_t b = next[a];
+        uint32_t d = next[c];
+        
+        if (c != b && d != a) {
+            
+            double gain = distance(a, b) + distance(c, d) - distance(a, c) - distance(b, d);
+            
+            if (gain > min_gain && apply_2opt(a, c)) {
+                
+                total_distance -= gain;
+                
+                worklist.insert(worklist.end(), { a, b, c, d });
+                
+                return true;
+                
+            }
+            
+        }
+        
+        // Predecessor side: (prev a, a) and (prev c, c) -> (a, c) and (prev a, prev c)
+        uint32_t p = prev[a];
+        uint32_t e = prev[c];
+        
+        if (c != p && e != a) {
+            
+            double gain = distance(p, a) + distance(e, c) - distance(a, c) - distance(p, e);
+            
+            if (gain > min_gain && apply_2opt(e, p)) {
+                
+                total_distance -= gain;
+                
+                worklist.insert(worklist.end(), { a, p, c, e });
+                
+                return true;
+                
+            }
+            
+        }
+        
+    }
+    
+    return false;
+    
+}
+
+bool OnlineTour::apply_2opt(uint32_t a, uint32_t c) {
+    
+    uint32_t b = next[a];
+    uint32_t d = next[c];
+    
+    // Either b..c or d..a can be reversed; only do it if one of them is short
+    uint32_t current = b;
+    
+    for (size_t steps = 0; steps < max_reverse; steps++) {
+        
+        if (current == c) {
+            
+            reverse_path(b, c);
+            
+            return true;
+            
+        }
+        
+        current = next[current];
+        
+    }
+    
+    current = d;
+    
+    for (size_t steps = 0; steps < max_reverse; steps++) {
+        
+        if (current == a) {
+            
+            reverse_path(d, a);
+            
+            return true;
+            
+        }
+        
+        current = next[current];
+        
+    }
+    
+    return false;
+    
+}
+
+void OnlineTour::reverse_path(uint32_t from, uint32_t to) {
+    
+    uint32_t before = prev[from];
+    uint32_t after = next[to];
+    
+    segment.clear();
+    
+    for (uint32_t current = from; ; current = next[current]) {
+        
+        segment.push_back(current);
+        
+        if (current == to) {
+            
+            break;
+            
+        }
+        
+    }
+    
+    for (uint32_t s : segment) {
+        
+        std::swap(next[s], prev[s]);
+        
+    }
+    
+    next[before] = to;
+    prev[to] = before;
+    
+    next[from] = after;
+    prev[after] = from;
+    
+}
@@ -0,0 +1,116 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  online_tour.hpp
+//  project4
+//
+//  A FASTTSP tour that stays live while locations are added and removed.
+//
+//  The tour is a doubly linked list over location numbers. A new location is
+//  placed with the same cheapest-insertion rule as FAST_distance_change(),
+//  but only the tour edges touching its nearest stops (found through a
+//  PointGrid over the stops) are tried. A removed location is spliced out.
+//  Optionally a 2-opt pass repairs the tour around each change, only
+//  reversing short stretches so an update stays cheap on large tours.
+//
+//  Updates take microseconds on locations spread like the tour's. The
+//  nearest stops of a location far from the tour are found in at most
+//  about one pass over the grid (PointGrid::visit_rings()), a few
+//  milliseconds at 100000 stops (bench/bench_online.cpp).
+//
+
+#ifndef ONLINE_TOUR_HPP
+#define ONLINE_TOUR_HPP
+
+#include "drone.hpp"
+#include "spatial.hpp"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+
+// ----------------------------------------------------------------------------
+//                    OnlineTour Declarations
+// ----------------------------------------------------------------------------
+
+class OnlineTour {
+
+public:
+
+    OnlineTour();
+
+    // Seeds the service with an existing tour over these locations
+    void seed(const Coordinate *coords, size_t count, const std::vector<size_t> &path);
+
+    // Builds the tour from scratch by inserting the locations in order
+    void build(const Coordinate *coords, size_t count);
+
+    // Run a local 2-opt repair after every change
+    void set_repair(bool repair_in);
+
+    // Returns the new location's number (numbers are never reused)
+    size_t add_location(const Coordinate &c);
+
+    // Throws DroneError if the location doesn't exist
+    void remove_location(size_t location_num);
+
+    // Puts a location given to seed() but left out of its tour into the tour
+    void insert_location(size_t location_num);
+
+    // Runs the 2-opt repair around one stop (if repair is enabled)
+    void repair_around(size_t location_num);
+
+    double get_total_distance() const;
+
+    size_t size() const;
+
+    // Visiting order, starting from location 0 (or the smallest remaining)
+    void get_path(std::vector<size_t> &path) const;
+
+    // Same format as FAST_print()
+    void print(std::ostream &os) const;
+
+private:
+
+    double distance(uint32_t a, uint32_t b) const;
+
+    void reset(const Coordinate *coords_in, size_t count);
+
+    void append_location(const Coordinate &c);
+
+    void insert_cheapest(uint32_t id);
+
+    // Nearest stops to c (up to num_nearest of them)
+    void nearest_stops(const Coordinate &c, uint32_t exclude);
+
+    // Local 2-opt around the stops on the worklist
+    void repair();
+
+    bool try_2opt(uint32_t a);
+
+    // Replaces (a, b = next a) and (c, d = next c) with (a, c) and (b, d)
+    bool apply_2opt(uint32_t a, uint32_t c);
+
+    void reverse_path(uint32_t from, uint32_t to);
+
+    std::vector<Coordinate> coords;
+    std::vector<char> alive;
+
+    std::vector<uint32_t> next;
+    std::vector<uint32_t> prev;
+
+    PointGrid grid;
+
+    double total_distance;
+
+    size_t num_stops;
+
+    bool repair_enabled;
+
+    // Scratch space reused by every update
+    std::vector<uint32_t> nearby;
+    std::vector<uint32_t> worklist;
+    std::vector<uint32_t> segment;
+
+};
+
+#endif /* ONLINE_TOUR_HPP */
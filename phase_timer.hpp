@@ -0,0 +1,393 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  phase_timer.hpp
+//  project4
+//
+//  Scoped (RAII) phase timers. Each PHASE_TIMER("name") measures wall time
+//  from its declaration to the end of the enclosing scope and, on Linux, can
+//  read hardware counters (cycles, instructions, LLC misses, branch misses)
+//  through perf_event_open.
+//
+//  Everything here compiles out unless DRONE_PROFILE is defined:
+//
+//      g++ -std=c++17 -O3 -DDRONE_PROFILE *.cpp -o drone
+//
+//  At runtime:
+//      DRONE_PROFILE_FORMAT=json   print the report as JSON instead of a table
+//      DRONE_PROFILE_PERF=0        skip hardware counters (wall time only)
+//
+//  If perf events are not permitted (perf_event_paranoid, containers, ...)
+//  the counters are reported as n/a and only wall time is measured.
+//
+//  Counters are opened per thread, on the thread itself, the first time it
+//  starts a phase. A phase's counts are those of the thread it runs on plus
+//  any threads that thread starts and joins inside the phase (an inherited
+//  counter adds a child's counts when the child exits), so phases on
+//  --batch workers count their own work and phases that fan out to worker
+//  threads count all of it.
+//
+
+#ifndef PHASE_TIMER_HPP
+#define PHASE_TIMER_HPP
+
+#ifdef DRONE_PROFILE
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ----------------------------------------------------------------------------
+//                    PerfCounters Declarations
+// ----------------------------------------------------------------------------
+
+class PerfCounters {
+
+public:
+
+    // cycles, instructions, LLC misses, branch misses
+    static const size_t num_counters = 4;
+
+    // The calling thread's counters
+    static PerfCounters &instance() {
+
+        thread_local PerfCounters counters;
+
+        return counters;
+
+    }
+
+    bool available() const {
+
+        return is_available;
+
+    }
+
+    // Fills values with the current running counts (0 if unavailable)
+    void read(uint64_t values[num_counters]) const {
+
+        for (size_t i = 0; i < num_counters; i++) {
+
+            values[i] = 0;
+
+#ifdef __linux__
+            if (fds[i] != -1) {
+
+                uint64_t count = 0;
+
+                if (::read(fds[i], &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count))) {
+
+                    values[i] = count;
+
+                }
+
+            }
+#endif
+
+        }
+
+    }
+
+private:
+
+    int fds[num_counters];
+
+    bool is_available;
+
+    PerfCounters() {
+
+        is_available = false;
+
+        for (size_t i = 0; i < num_counters; i++) {
+
+            fds[i] = -1;
+
+        }
+
+        const char *perf_env = std::getenv("DRONE_PROFILE_PERF");
+
+        if (perf_env != nullptr && std::strcmp(perf_env, "0") == 0) {
+
+            return;
+
+        }
+
+#ifdef __linux__
+        const uint64_t configs[num_counters] = { PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES };
+
+        for (size_t i = 0; i < num_counters; i++) {
+
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+
+            // count threads this thread starts from here on as well, once
+            // they exit
+            attr.inherit = 1;
+
+            long fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+
+            // Not permitted / not supported: keep going with what we have
+            if (fd < 0) {
+
+                continue;
+
+            }
+
+            fds[i] = static_cast<int>(fd);
+
+            is_available = true;
+
+        }
+#endif
+
+    }
+
+    ~PerfCounters() {
+
+#ifdef __linux__
+        for (size_t i = 0; i < num_counters; i++) {
+
+            if (fds[i] != -1) {
+
+                close(fds[i]);
+
+            }
+
+        }
+#endif
+
+    }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+};
+
+// ----------------------------------------------------------------------------
+//                    PhaseTimer Declarations
+// ----------------------------------------------------------------------------
+
+class PhaseTimer {
+
+public:
+
+    explicit PhaseTimer(const char *name_in) : name(name_in) {
+
+        PerfCounters::instance().read(start_counts);
+
+        start_time = std::chrono::steady_clock::now();
+
+    }
+
+    ~PhaseTimer() {
+
+        auto end_time = std::chrono::steady_clock::now();
+
+        uint64_t end_counts[PerfCounters::num_counters];
+        PerfCounters::instance().read(end_counts);
+
+        // Phases can run on several threads at once (e.g. --batch)
+        std::lock_guard<std::mutex> guard(records_lock());
+
+        Record &record = find_record(name);
+
+        record.calls++;
+        record.seconds += std::chrono::duration<double>(end_time - start_time).count();
+
+        for (size_t i = 0; i < PerfCounters::num_counters; i++) {
+
+            record.counts[i] += end_counts[i] - start_counts[i];
+
+        }
+
+    }
+
+    // Prints every phase seen so far, in the order they first ran
+    static void report(std::ostream &os) {
+
+        const char *format = std::getenv("DRONE_PROFILE_FORMAT");
+
+        bool json = (format != nullptr && std::strcmp(format, "json") == 0);
+
+        bool perf = PerfCounters::instance().available();
+
+        std::ios_base::fmtflags old_flags = os.flags();
+        std::streamsize old_precision = os.precision();
+
+        os.setf(std::ios_base::fixed, std::ios_base::floatfield);
+        os.precision(6);
+
+        if (json) {
+
+            os << "{\"perf_available\": " << (perf ? "true" : "false") << ", \"phases\": [";
+
+            for (size_t i = 0; i < records().size(); i++) {
+
+                const Record &r = records()[i];
+
+                os << (i == 0 ? "" : ", ") << "{\"name\": \"" << r.name << "\", \"calls\": " << r.calls
+                << ", \"seconds\": " << r.seconds;
+
+                for (size_t c = 0; c < PerfCounters::num_counters; c++) {
+
+                    os << ", \"" << counter_name(c) << "\": ";
+
+                    if (perf) {
+
+                        os << r.counts[c];
+
+                    }
+
+                    else {
+
+                        os << "null";
+
+                    }
+
+                }
+
+                os << "}";
+
+            }
+
+            os << "]}\n";
+
+        }
+
+        else {
+
+            os << "phase                    calls      seconds         cycles   instructions     llc_misses  branch_misses\n";
+
+            for (const Record &r : records()) {
+
+                std::string padded = r.name;
+                padded.resize(std::max<size_t>(padded.size(), 22), ' ');
+
+                os << padded << " " << pad_left(std::to_string(r.calls), 7) << " "
+                << pad_left(std::to_string(r.seconds).substr(0, 12), 12);
+
+                for (size_t c = 0; c < PerfCounters::num_counters; c++) {
+
+                    os << " " << pad_left(perf ? std::to_string(r.counts[c]) : "n/a", 14);
+
+                }
+
+                os << "\n";
+
+            }
+
+            if (!perf) {
+
+                os << "(hardware counters unavailable; wall time only)\n";
+
+            }
+
+        }
+
+        os.flags(old_flags);
+        os.precision(old_precision);
+
+    }
+
+private:
+
+    struct Record {
+
+        std::string name;
+        uint64_t calls = 0;
+        double seconds = 0;
+        uint64_t counts[PerfCounters::num_counters] = {};
+
+    };
+
+    const char *name;
+
+    std::chrono::steady_clock::time_point start_time;
+
+    uint64_t start_counts[PerfCounters::num_counters];
+
+    static std::vector<Record> &records() {
+
+        static std::vector<Record> all_records;
+
+        return all_records;
+
+    }
+
+    static std::mutex &records_lock() {
+
+        static std::mutex lock;
+
+        return lock;
+
+    }
+
+    static Record &find_record(const char *name_in) {
+
+        for (Record &r : records()) {
+
+            if (r.name == name_in) {
+
+                return r;
+
+            }
+
+        }
+
+        records().emplace_back();
+        records().back().name = name_in;
+
+        return records().back();
+
+    }
+
+    static const char *counter_name(size_t index) {
+
+        static const char *names[PerfCounters::num_counters] = { "cycles", "instructions", "llc_misses", "branch_misses" };
+
+        return names[index];
+
+    }
+
+    static std::string pad_left(const std::string &s, size_t width) {
+
+        return (s.size() >= width) ? s : std::string(width - s.size(), ' ') + s;
+
+    }
+
+};
+
+#define PHASE_TIMER_CONCAT_INNER(a, b) a##b
+#define PHASE_TIMER_CONCAT(a, b) PHASE_TIMER_CONCAT_INNER(a, b)
+
+#define PHASE_TIMER(name) PhaseTimer PHASE_TIMER_CONCAT(phase_timer_, __LINE__)(name)
+#define PHASE_REPORT() PhaseTimer::report(std::cerr)
+
+#else
+
+#define PHASE_TIMER(name)
+#define PHASE_REPORT()
+
+#endif
+
+#endif /* PHASE_TIMER_HPP */
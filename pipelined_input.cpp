@@ -0,0 +1,345 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  pipelined_input.cpp
+//  project4
+//
+
+#include "pipelined_input.hpp"
+#include "binary_input.hpp"
+#include "phase_timer.hpp"
+#include "spatial.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+
+namespace {
+
+// Bytes read per block (small enough that a few MB of input already keep
+// several workers busy)
+const size_t block_bytes = 256 * 1024;
+
+struct Block {
+    
+    std::string text;
+    
+    // Integers in text, in order, up to the first malformed one
+    std::vector<int> numbers;
+    
+    // A token that is not an integer ends the input (as it stops >>)
+    bool malformed = false;
+    
+    // hilbert_index() of (numbers[first + 2 i], numbers[first + 2 i + 1]),
+    // first = 1 in block 0 (skipping the count) and 0 elsewhere
+    std::vector<uint64_t> keys;
+    
+};
+
+bool is_space(char c) {
+    
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    
+}
+
+// Reads integers like >> does, stopping at the first character that can't
+// continue a number (values beyond int clamp)
+void parse_block(Block &block, bool first_block) {
+    
+    const char *p = block.text.data();
+    const char *end = p + block.text.size();
+    
+    block.numbers.reserve(block.text.size() / 7);
+    
+    while (true) {
+        
+        while (p != end && is_space(*p)) {
+            
+            p++;
+            
+        }
+        
+        if (p == end) {
+            
+            break;
+            
+        }
+        
+        bool negative = (*p == '-');
+        
+        if (*p == '-' || *p == '+') {
+            
+            p++;
+            
+        }
+        
+        if (p == end || *p < '0' || *p > '9') {
+            
+            block.malformed = true;
+            
+            break;
+            
+        }
+        
+        int64_t value = 0;
+        
+        for (; p != end && *p >= '0' && *p <= '9'; p++) {
+            
+            value = std::min<int64_t>(value * 10 + (*p - '0'), int64_t(1) << 32);
+            
+        }
+        
+        value = negative ? -value : value;
+        
+        block.numbers.push_back(static_cast<int>(std::max<int64_t>(std::min<int64_t>(value, INT32_MAX), INT32_MIN)));
+        
+        if (p != end && !is_space(*p)) {
+            
+            block.malformed = true;
+            
+            break;
+            
+        }
+        
+    }
+    
+    size_t first = first_block ? 1 : 0;
+    
+    block.keys.reserve(block.numbers.size() / 2);
+    
+    for (size_t i = first; i + 1 < block.numbers.size(); i += 2) {
+        
+        block.keys.push_back(hilbert_index({ block.numbers[i], block.numbers[i + 1] }));
+        
+    }
+    
+    std::string().swap(block.text);
+    
+}
+
+}
+
+// ----------------------------------------------------------------------------
+//                    Pipelined Input
+// ----------------------------------------------------------------------------
+
+void read_input_pipelined(std::istream &is, std::vector<Coordinate> &coords, std::vector<uint64_t> &hilbert_keys,
+                          size_t num_threads) {
+    
+    PHASE_TIMER("read_input_pipelined");
+    
+    if (num_threads == 0) {
+        
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+        
+    }
+    
+    // Binary input has nothing to parse
+    if (is_binary_input(is)) {
+        
+        read_binary_input(is, coords);
+        
+        hilbert_keys.resize(coords.size());
+        
+        for (size_t i = 0; i < coords.size(); i++) {
+            
+            hilbert_keys[i] = hilbert_index(coords[i]);
+            
+        }
+        
+        return;
+        
+    }
+    
+    // Blocks never move once added (deque), so workers keep references
+    std::deque<Block> blocks;
+    
+    size_t next_block = 0;
+    bool reading = true;
+    
+    std::mutex lock;
+    std::condition_variable block_ready;
+    
+    // Parses blocks until the reader is done and none are left
+    auto worker = [&]() {
+        
+        std::unique_lock<std::mutex> guard(lock);
+        
+        while (true) {
+            
+            block_ready.wait(guard, [&]() { return next_block < blocks.size() || !reading; });
+            
+            if (next_block == blocks.size()) {
+                
+                return;
+                
+            }
+            
+            size_t number = next_block++;
+            Block &block = blocks[number];
+            
+            guard.unlock();
+            parse_block(block, number == 0);
+            guard.lock();
+            
+        }
+        
+    };
+    
+    std::vector<std::thread> threads;
+    
+    for (size_t t = 1; t < num_threads; t++) {
+        
+        threads.emplace_back(worker);
+        
+    }
+    
+    // The reader: each block ends after its last whitespace character, the
+    // rest (the start of a number) carries over to the next block
+    std::string carry;
+    std::vector<char> buffer(block_bytes);
+    
+    while (is) {
+        
+        is.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        
+        size_t length = static_cast<size_t>(is.gcount());
+        size_t cut = length;
+        
+        if (is) {
+            
+            while (cut > 0 && !is_space(buffer[cut - 1])) {
+                
+                cut--;
+                
+            }
+            
+        }
+        
+        Block block;
+        
+        block.text.reserve(carry.size() + cut);
+        block.text.append(carry);
+        block.text.append(buffer.data(), cut);
+        
+        carry.assign(buffer.data() + cut, length - cut);
+        
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            
+            blocks.push_back(std::move(block));
+        }
+        
+        block_ready.notify_one();
+        
+    }
+    
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        
+        reading = false;
+    }
+    
+    block_ready.notify_all();
+    
+    // The reader parses too once the stream is done
+    worker();
+    
+    for (std::thread &thread : threads) {
+        
+        thread.join();
+        
+    }
+    
+    // Copy into place: the first number is the count, then x y pairs
+    size_t count = 0;
+    
+    for (const Block &block : blocks) {
+        
+        if (!block.numbers.empty()) {
+            
+            count = static_cast<size_t>(std::max(block.numbers[0], 0));
+            
+            break;
+            
+        }
+        
+        if (block.malformed) {
+            
+            break;
+            
+        }
+        
+    }
+    
+    coords.assign(count, Coordinate{ 0, 0 });
+    hilbert_keys.assign(count, hilbert_index(Coordinate{ 0, 0 }));
+    
+    size_t location = 0;
+    
+    // Numbers seen so far (the count included), and a pending x coordinate
+    // when that is even
+    size_t seen = 0;
+    int pending_x = 0;
+    
+    for (size_t number = 0; number < blocks.size() && location < count; number++) {
+        
+        const Block &block = blocks[number];
+        
+        size_t i = 0;
+        
+        // Pairs start where the worker assumed: take its keys
+        if (number == 0 || seen % 2 == 1) {
+            
+            i = (number == 0) ? std::min<size_t>(1, block.numbers.size()) : 0;
+            
+            size_t pairs = std::min(block.keys.size(), count - location);
+            
+            for (size_t k = 0; k < pairs; k++, i += 2) {
+                
+                coords[location + k] = { block.numbers[i], block.numbers[i + 1] };
+                hilbert_keys[location + k] = block.keys[k];
+                
+            }
+            
+            location += pairs;
+            seen += i;
+            
+        }
+        
+        // Whatever is left (a block starting at a y coordinate, or an x
+        // whose y is in the next block) pairs up one number at a time
+        for (; i < block.numbers.size() && location < count; i++, seen++) {
+            
+            if (seen == 0) {
+                
+                continue;
+                
+            }
+            
+            if (seen % 2 == 1) {
+                
+                pending_x = block.numbers[i];
+                
+                continue;
+                
+            }
+            
+            coords[location] = { pending_x, block.numbers[i] };
+            hilbert_keys[location] = hilbert_index(coords[location]);
+            
+            location++;
+            
+        }
+        
+        if (block.malformed) {
+            
+            break;
+            
+        }
+        
+    }
+    
+}
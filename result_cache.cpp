@@ -0,0 +1,371 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  result_cache.cpp
+//  project4
+//
+
+#include "result_cache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <unistd.h>
+
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char cache_magic[4] = { 'D', 'R', 'C', '1' };
+
+const char *entry_extension = ".drc";
+
+// Temporary files are "<entry>.drc.tmp.<pid>.<thread>.<n>"
+const char *temp_suffix = ".tmp.";
+
+// A temporary file this old was left by a writer that died before its
+// rename; any live writer renames within seconds
+const std::chrono::hours temp_max_age(1);
+
+struct EntryHeader {
+    
+    char magic[4];
+    uint32_t version;
+    uint32_t mode;
+    uint64_t count;
+    uint64_t check_hash;
+    double total;
+    
+};
+
+// 64-bit multiply-xorshift mixing, one word at a time
+uint64_t mix(uint64_t h, uint64_t word) {
+    
+    h ^= word + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    
+    return h;
+    
+}
+
+uint64_t hash_instance(uint64_t seed, char mode, const std::string &variant, const Coordinate *coords, size_t count) {
+    
+    uint64_t h = mix(mix(seed, cache_version), static_cast<uint64_t>(mode));
+    
+    for (char c : variant) {
+        
+        h = mix(h, static_cast<uint64_t>(static_cast<unsigned char>(c)));
+        
+    }
+    
+    h = mix(h, count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        uint64_t word = (static_cast<uint64_t>(static_cast<uint32_t>(coords[i].x)) << 32) | static_cast<uint32_t>(coords[i].y);
+        
+        h = mix(h, word);
+        
+    }
+    
+    return h;
+    
+}
+
+}
+
+// ----------------------------------------------------------------------------
+//                    ResultCache Definitions
+// ----------------------------------------------------------------------------
+
+ResultCache::ResultCache(const std::string &directory_in, uint64_t max_bytes_in) {
+    
+    directory = directory_in;
+    
+    max_bytes = max_bytes_in;
+    
+    estimated_bytes = 0;
+    
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    
+    evict();
+    
+}
+
+bool ResultCache::load(char mode, const std::string &variant, const Coordinate *coords, size_t count, MSTResult &result) {
+    
+    return read_entry(mode, make_key(mode, variant, coords, count), count, result.total_weight, result.parents);
+    
+}
+
+bool ResultCache::load(char mode, const std::string &variant, const Coordinate *coords, size_t count, TourResult &result) {
+    
+    return read_entry(mode, make_key(mode, variant, coords, count), count, result.total_distance, result.path);
+    
+}
+
+void ResultCache::store(char mode, const std::string &variant, const Coordinate *coords, size_t count, const MSTResult &result) {
+    
+    write_entry(mode, make_key(mode, variant, coords, count), result.total_weight, result.parents);
+    
+}
+
+void ResultCache::store(char mode, const std::string &variant, const Coordinate *coords, size_t count, const TourResult &result) {
+    
+    write_entry(mode, make_key(mode, variant, coords, count), result.total_distance, result.path);
+    
+}
+
+ResultCache::Key ResultCache::make_key(char mode, const std::string &variant, const Coordinate *coords, size_t count) const {
+    
+    Key key;
+    
+    key.name_hash = hash_instance(0x243f6a8885a308d3ULL, mode, variant, coords, count);
+    key.check_hash = hash_instance(0x13198a2e03707344ULL, mode, variant, coords, count);
+    
+    return key;
+    
+}
+
+std::string ResultCache::entry_path(const Key &key) const {
+    
+    char name[32];
+    
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key.name_hash));
+    
+    return (fs::path(directory) / (std::string(name) + entry_extension)).string();
+    
+}
+
+bool ResultCache::read_entry(char mode, const Key &key, size_t count, double &total, std::vector<size_t> &values) {
+    
+    std::string path = entry_path(key);
+    
+    std::ifstream file(path, std::ios::binary);
+    
+    if (!file) {
+        
+        return false;
+        
+    }
+    
+    EntryHeader header;
+    
+    if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0 || header.version != cache_version ||
+        header.mode != static_cast<uint32_t>(mode) || header.check_hash != key.check_hash) {
+        
+        return false;
+        
+    }
+    
+    // MST entries hold a parent per location; tours hold the whole path
+    // (FASTTSP/OPTTSP tours always visit every location too)
+    if (header.count != count) {
+        
+        return false;
+        
+    }
+    
+    std::vector<uint32_t> packed(count);
+    
+    if (!file.read(reinterpret_cast<char *>(packed.data()), static_cast<std::streamsize>(count * sizeof(uint32_t)))) {
+        
+        return false;
+        
+    }
+    
+    total = header.total;
+    
+    values.assign(packed.begin(), packed.end());
+    
+    // Refresh the entry for LRU eviction
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    
+    return true;
+    
+}
+
+void ResultCache::write_entry(char mode, const Key &key, double total, const std::vector<size_t> &values) {
+    
+    if (values.size() > UINT32_MAX) {
+        
+        return;
+        
+    }
+    
+    // Zeroed so the padding after mode isn't written out uninitialised
+    EntryHeader header{};
+    
+    std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+    header.version = cache_version;
+    header.mode = static_cast<uint32_t>(mode);
+    header.count = values.size();
+    header.check_hash = key.check_hash;
+    header.total = total;
+    
+    std::vector<uint32_t> packed(values.begin(), values.end());
+    
+    // Unique temporary name per process and thread, then an atomic rename
+    static std::atomic<uint64_t> temp_counter(0);
+    
+    std::string final_path = entry_path(key);
+    std::string temp_path = final_path + temp_suffix + std::to_string(getpid()) + "." +
+    std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "." + std::to_string(temp_counter++);
+    
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        
+        if (!file) {
+            
+            return;
+            
+        }
+        
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(packed.data()), static_cast<std::streamsize>(packed.size() * sizeof(uint32_t)));
+        
+        if (!file) {
+            
+            std::error_code ec;
+            fs::remove(temp_path, ec);
+            
+            return;
+            
+        }
+    }
+    
+    std::error_code ec;
+    fs::rename(temp_path, final_path, ec);
+    
+    if (ec) {
+        
+        fs::remove(temp_path, ec);
+        
+        return;
+        
+    }
+    
+    uint64_t entry_bytes = sizeof(header) + packed.size() * sizeof(uint32_t);
+    
+    if (estimated_bytes.fetch_add(entry_bytes) + entry_bytes > max_bytes) {
+        
+        evict();
+        
+    }
+    
+}
+
+void ResultCache::evict() {
+    
+    std::unique_lock<std::mutex> lock(evict_mutex, std::try_to_lock);
+    
+    if (!lock.owns_lock()) {
+        
+        return;
+        
+    }
+    
+    struct Entry {
+        
+        fs::path path;
+        uint64_t size;
+        fs::file_time_type last_used;
+        
+    };
+    
+    std::vector<Entry> entries;
+    uint64_t total_bytes = 0;
+    
+    std::error_code ec;
+    
+    fs::file_time_type now = fs::file_time_type::clock::now();
+    
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        
+        bool temporary = it->path().filename().string().find(std::string(entry_extension) + temp_suffix) != std::string::npos;
+        
+        if (!temporary && it->path().extension() != entry_extension) {
+            
+            continue;
+            
+        }
+        
+        std::error_code entry_ec;
+        
+        uint64_t size = it->file_size(entry_ec);
+        fs::file_time_type last_used = it->last_write_time(entry_ec);
+        
+        // Another process may have evicted it already
+        if (entry_ec) {
+            
+            continue;
+            
+        }
+        
+        // Temporary files count against the cap; abandoned ones go now and
+        // the rest are left to their writers
+        if (temporary) {
+            
+            if (now - last_used > temp_max_age) {
+                
+                fs::remove(it->path(), entry_ec);
+                
+            }
+            
+            else {
+                
+                total_bytes += size;
+                
+            }
+            
+            continue;
+            
+        }
+        
+        entries.push_back({ it->path(), size, last_used });
+        total_bytes += size;
+        
+    }
+    
+    if (total_bytes <= max_bytes) {
+        
+        estimated_bytes = total_bytes;
+        
+        return;
+        
+    }
+    
+    uint64_t target_bytes = max_bytes - max_bytes / 8;
+    
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        
+        return a.last_used < b.last_used;
+        
+    });
+    
+    for (const Entry &entry : entries) {
+        
+        if (total_bytes <= target_bytes) {
+            
+            break;
+            
+        }
+        
+        fs::remove(entry.path, ec);
+        
+        total_bytes -= entry.size;
+        
+    }
+    
+    estimated_bytes = total_bytes;
+    
+}
@@ -0,0 +1,103 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  result_cache.hpp
+//  project4
+//
+//  On-disk cache of solved instances, keyed by a hash of cache_version, the
+//  mode, any option that changes the answer, and the location list
+//  (coordinates in input order, since the printed numbers depend on that
+//  order).
+//
+//  Each entry is one small binary file: a header (magic, cache_version,
+//  mode, count, a second hash to catch collisions, total) followed by
+//  32-bit location numbers (MST parents or the tour). Entries are written to a temporary
+//  file and renamed into place, so processes sharing a directory never see
+//  partial entries. A hit refreshes the entry's modification time; when the
+//  directory grows past its size cap the least recently used entries go.
+//
+//  Stores don't scan the directory: each ResultCache keeps a running
+//  estimate of its size (one scan at construction, plus the bytes it
+//  writes) and only rescans when the estimate passes the cap. A scan then
+//  trims the directory to 7/8 of the cap, so a cache at its cap rescans
+//  about once per eighth of the cap written rather than on every store.
+//  Other processes' writes are only seen at the next scan, so a directory
+//  shared by several processes can overshoot the cap by what they wrote
+//  in between.
+//
+//  Temporary files count against the cap too, and a scan deletes any left
+//  for over an hour by a writer that died before renaming its entry.
+//
+//  Cache problems (unwritable directory, corrupt entry, ...) never fail a
+//  solve: the entry is treated as a miss.
+//
+
+#ifndef RESULT_CACHE_HPP
+#define RESULT_CACHE_HPP
+
+#include "drone.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+// Part of every key and entry header, so entries written by older builds
+// miss. Bump it with any change to a solver that changes what it returns
+// (a fix, a new tie-break, ...) as well as with any change to the entry
+// format.
+const uint32_t cache_version = 2;
+
+// ----------------------------------------------------------------------------
+//                    ResultCache Declarations
+// ----------------------------------------------------------------------------
+
+class ResultCache {
+
+public:
+
+    ResultCache(const std::string &directory_in, uint64_t max_bytes_in);
+
+    // 'variant' names any setting besides the mode that changes the result
+    bool load(char mode, const std::string &variant, const Coordinate *coords, size_t count, MSTResult &result);
+
+    bool load(char mode, const std::string &variant, const Coordinate *coords, size_t count, TourResult &result);
+
+    void store(char mode, const std::string &variant, const Coordinate *coords, size_t count, const MSTResult &result);
+
+    void store(char mode, const std::string &variant, const Coordinate *coords, size_t count, const TourResult &result);
+
+private:
+
+    struct Key {
+
+        uint64_t name_hash;
+        uint64_t check_hash;
+
+    };
+
+    Key make_key(char mode, const std::string &variant, const Coordinate *coords, size_t count) const;
+
+    std::string entry_path(const Key &key) const;
+
+    bool read_entry(char mode, const Key &key, size_t count, double &total, std::vector<size_t> &values);
+
+    void write_entry(char mode, const Key &key, double total, const std::vector<size_t> &values);
+
+    // Rescans the directory, resetting estimated_bytes. Past the cap, removes
+    // least recently used entries until the cache fits 7/8 of it.
+    void evict();
+
+    std::string directory;
+
+    uint64_t max_bytes;
+
+    // Directory size as of the last scan plus the entries stored since
+    std::atomic<uint64_t> estimated_bytes;
+
+    // One scan at a time; stores that find it taken skip theirs
+    std::mutex evict_mutex;
+
+};
+
+#endif /* RESULT_CACHE_HPP */
@@ -0,0 +1,647 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  spatial.cpp
+//  project4
+//
+
+#include "spatial.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+// ----------------------------------------------------------------------------
+//                    Squared Distance Definitions
+// ----------------------------------------------------------------------------
+
+int64_t wide_squared_offset(uint64_t ax, uint64_t ay) {
+    
+    const uint64_t limit = uint64_t(1) << 33;
+    
+    if (ax >= limit || ay >= limit) {
+        
+        return max_squared_key;
+        
+    }
+    
+    // With a = 4h + l, a^2 / 8 = 2h^2 + hl + l^2 / 8, and 2h^2 < 2^63
+    uint64_t hx = ax >> 2, lx = ax & 3;
+    uint64_t hy = ay >> 2, ly = ay & 3;
+    
+    uint64_t eighth_x = 2 * hx * hx + hx * lx;
+    uint64_t eighth_y = 2 * hy * hy + hy * ly;
+    
+    // Keys past this eighth of the squared distance would reach max_squared_key
+    const uint64_t max_eighth = static_cast<uint64_t>(max_squared_key - exact_squared_limit) + (exact_squared_limit >> 3);
+    
+    if (eighth_x >= max_eighth || eighth_y >= max_eighth) {
+        
+        return max_squared_key;
+        
+    }
+    
+    uint64_t eighth = eighth_x + eighth_y + (lx * lx + ly * ly) / 8;
+    
+    if (eighth >= max_eighth) {
+        
+        return max_squared_key;
+        
+    }
+    
+    if (eighth < static_cast<uint64_t>(exact_squared_limit >> 3)) {
+        
+        // Below the limit: the exact square fits
+        return static_cast<int64_t>(ax * ax + ay * ay);
+        
+    }
+    
+    return exact_squared_limit + static_cast<int64_t>(eighth - static_cast<uint64_t>(exact_squared_limit >> 3));
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    Octant Definitions
+// ----------------------------------------------------------------------------
+
+size_t octant_of(const Coordinate &from, const Coordinate &to) {
+    
+    return octant_of(static_cast<int64_t>(to.x) - from.x, static_cast<int64_t>(to.y) - from.y);
+    
+}
+
+size_t octant_of(int64_t dx, int64_t dy) {
+    
+    size_t octant = 0;
+    
+    // Rotate by 180 degrees into the upper half plane [0, 180)
+    if (dy < 0 || (dy == 0 && dx < 0)) {
+        
+        dx = -dx;
+        dy = -dy;
+        
+        octant += 4;
+        
+    }
+    
+    // Rotate by -90 degrees into the first quadrant [0, 90)
+    if (dx <= 0) {
+        
+        int64_t temp = dx;
+        
+        dx = dy;
+        dy = -temp;
+        
+        octant += 2;
+        
+    }
+    
+    // [45, 90)
+    if (dy >= dx) {
+        
+        octant += 1;
+        
+    }
+    
+    return octant;
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    Hilbert Curve Definitions
+// ----------------------------------------------------------------------------
+
+namespace {
+
+// The curve is walked 4 bits of x and y at a time. Orientation of the
+// current square: bit 0 = x/y swapped, bit 1 = both complemented.
+// hilbert_table[orientation][x nibble << 4 | y nibble] holds the 8 index bits
+// of that step and, above them, the orientation for the next step.
+struct HilbertTable {
+    
+    uint16_t entries[4][256];
+    
+    HilbertTable() {
+        
+        for (uint16_t orientation = 0; orientation < 4; orientation++) {
+            
+            for (uint16_t nibbles = 0; nibbles < 256; nibbles++) {
+                
+                uint16_t state = orientation;
+                uint16_t digits = 0;
+                
+                for (int bit = 3; bit >= 0; bit--) {
+                    
+                    uint16_t rx = (nibbles >> (4 + bit)) & 1;
+                    uint16_t ry = (nibbles >> bit) & 1;
+                    
+                    if (state & 1) {
+                        
+                        std::swap(rx, ry);
+                        
+                    }
+                    
+                    if (state & 2) {
+                        
+                        rx ^= 1;
+                        ry ^= 1;
+                        
+                    }
+                    
+                    digits = static_cast<uint16_t>((digits << 2) | ((3 * rx) ^ ry));
+                    
+                    // Lower quadrants are rotated (and flipped on the right)
+                    if (ry == 0) {
+                        
+                        state = static_cast<uint16_t>(state ^ (1 | (rx << 1)));
+                        
+                    }
+                    
+                }
+                
+                entries[orientation][nibbles] = static_cast<uint16_t>(digits | (state << 8));
+                
+            }
+            
+        }
+        
+    }
+    
+};
+
+const HilbertTable hilbert_table;
+
+// Stable LSD radix sort on the 64-bit keys, 16 bits per pass. Passes where
+// every key has the same digit are skipped (small coordinate ranges leave
+// the high digits constant).
+void radix_sort(std::vector<std::pair<uint64_t, size_t>> &keys) {
+    
+    std::vector<std::pair<uint64_t, size_t>> buffer(keys.size());
+    std::vector<size_t> counts(1 << 16);
+    
+    for (unsigned shift = 0; shift < 64; shift += 16) {
+        
+        std::fill(counts.begin(), counts.end(), 0);
+        
+        for (const auto &key : keys) {
+            
+            counts[(key.first >> shift) & 0xffff]++;
+            
+        }
+        
+        if (keys.empty() || counts[(keys[0].first >> shift) & 0xffff] == keys.size()) {
+            
+            continue;
+            
+        }
+        
+        size_t offset = 0;
+        
+        for (size_t &count : counts) {
+            
+            size_t bucket_size = count;
+            
+            count = offset;
+            offset += bucket_size;
+            
+        }
+        
+        for (const auto &key : keys) {
+            
+            buffer[counts[(key.first >> shift) & 0xffff]++] = key;
+            
+        }
+        
+        keys.swap(buffer);
+        
+    }
+    
+}
+
+// Sorts (key, location) pairs and keeps the locations
+void sort_by_keys(std::vector<std::pair<uint64_t, size_t>> &keys, std::vector<size_t> &order) {
+    
+    radix_sort(keys);
+    
+    order.resize(keys.size());
+    
+    for (size_t i = 0; i < keys.size(); i++) {
+        
+        order[i] = keys[i].second;
+        
+    }
+    
+}
+
+}
+
+uint64_t hilbert_index(const Coordinate &c) {
+    
+    // Flipping the sign bit maps int order onto unsigned order
+    uint32_t x = static_cast<uint32_t>(c.x) ^ 0x80000000u;
+    uint32_t y = static_cast<uint32_t>(c.y) ^ 0x80000000u;
+    
+    uint64_t index = 0;
+    uint16_t orientation = 0;
+    
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        
+        uint16_t nibbles = static_cast<uint16_t>((((x >> shift) & 0xf) << 4) | ((y >> shift) & 0xf));
+        uint16_t entry = hilbert_table.entries[orientation][nibbles];
+        
+        index = (index << 8) | (entry & 0xff);
+        orientation = static_cast<uint16_t>(entry >> 8);
+        
+    }
+    
+    return index;
+    
+}
+
+void hilbert_order(const Coordinate *coords, size_t count, std::vector<size_t> &order) {
+    
+    std::vector<std::pair<uint64_t, size_t>> keys(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        keys[i] = { hilbert_index(coords[i]), i };
+        
+    }
+    
+    sort_by_keys(keys, order);
+    
+}
+
+void hilbert_order(const uint64_t *keys_in, size_t count, std::vector<size_t> &order) {
+    
+    std::vector<std::pair<uint64_t, size_t>> keys(count);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        keys[i] = { keys_in[i], i };
+        
+    }
+    
+    sort_by_keys(keys, order);
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    PointGrid Definitions
+// ----------------------------------------------------------------------------
+
+PointGrid::PointGrid() {
+    
+    cell_size = 1;
+    
+    min_cx = min_cy = std::numeric_limits<int64_t>::max();
+    max_cx = max_cy = std::numeric_limits<int64_t>::min();
+    
+}
+
+void PointGrid::reset(const Coordinate *coords, size_t count, double per_cell) {
+    
+    cells.clear();
+    
+    min_cx = min_cy = std::numeric_limits<int64_t>::max();
+    max_cx = max_cy = std::numeric_limits<int64_t>::min();
+    
+    cell_size = 1;
+    
+    if (count == 0) {
+        
+        return;
+        
+    }
+    
+    int64_t min_x = coords[0].x, max_x = coords[0].x;
+    int64_t min_y = coords[0].y, max_y = coords[0].y;
+    
+    for (size_t i = 1; i < count; i++) {
+        
+        min_x = std::min<int64_t>(min_x, coords[i].x);
+        max_x = std::max<int64_t>(max_x, coords[i].x);
+        min_y = std::min<int64_t>(min_y, coords[i].y);
+        max_y = std::max<int64_t>(max_y, coords[i].y);
+        
+    }
+    
+    double area = static_cast<double>(max_x - min_x + 1) * static_cast<double>(max_y - min_y + 1);
+    
+    // side of a square holding per_cell points on average
+    double side = std::sqrt(area * per_cell / static_cast<double>(count));
+    
+    cell_size = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(side)));
+    
+    cells.reserve(count);
+    
+}
+
+void PointGrid::insert(uint32_t id, const Coordinate &c) {
+    
+    int64_t cx = cell_of(c.x);
+    int64_t cy = cell_of(c.y);
+    
+    cells[key_of(cx, cy)].push_back(id);
+    
+    min_cx = std::min(min_cx, cx);
+    max_cx = std::max(max_cx, cx);
+    min_cy = std::min(min_cy, cy);
+    max_cy = std::max(max_cy, cy);
+    
+}
+
+void PointGrid::remove(uint32_t id, const Coordinate &c) {
+    
+    auto it = cells.find(key_of(cell_of(c.x), cell_of(c.y)));
+    
+    if (it == cells.end()) {
+        
+        return;
+        
+    }
+    
+    std::vector<uint32_t> &cell = it->second;
+    
+    auto found = std::find(cell.begin(), cell.end(), id);
+    
+    if (found != cell.end()) {
+        
+        // order within a cell doesn't matter
+        *found = cell.back();
+        cell.pop_back();
+        
+    }
+    
+}
+
+int64_t PointGrid::get_cell_size() const {
+    
+    return cell_size;
+    
+}
+
+int64_t PointGrid::first_ring(const Coordinate &c) const {
+    
+    if (min_cx > max_cx) {
+        
+        return 0;
+        
+    }
+    
+    int64_t cx = cell_of(c.x);
+    int64_t cy = cell_of(c.y);
+    
+    int64_t gap_x = std::max<int64_t>({ min_cx - cx, cx - max_cx, 0 });
+    int64_t gap_y = std::max<int64_t>({ min_cy - cy, cy - max_cy, 0 });
+    
+    return std::max(gap_x, gap_y);
+    
+}
+
+double PointGrid::ring_lower_bound(int64_t ring) const {
+    
+    return static_cast<double>(ring * cell_size);
+    
+}
+
+int64_t PointGrid::cell_of(int coord) const {
+    
+    // floor division (coordinates can be negative)
+    int64_t value = coord;
+    
+    return (value >= 0) ? value / cell_size : -((-value + cell_size - 1) / cell_size);
+    
+}
+
+uint64_t PointGrid::key_of(int64_t cx, int64_t cy) {
+    
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    StaticGrid Definitions
+// ----------------------------------------------------------------------------
+
+StaticGrid::StaticGrid() {
+    
+    min_x = min_y = 0;
+    
+    cell_size = 1;
+    
+    num_columns = num_rows = 1;
+    
+    cell_start.assign(2, 0);
+    
+}
+
+void StaticGrid::build(const Coordinate *coords, const uint32_t *ids, size_t count, double per_cell) {
+    
+    if (count == 0) {
+        
+        *this = StaticGrid();
+        
+        return;
+        
+    }
+    
+    min_x = coords[ids[0]].x;
+    min_y = coords[ids[0]].y;
+    
+    int64_t max_x = min_x, max_y = min_y;
+    
+    for (size_t i = 1; i < count; i++) {
+        
+        const Coordinate &c = coords[ids[i]];
+        
+        min_x = std::min<int64_t>(min_x, c.x);
+        max_x = std::max<int64_t>(max_x, c.x);
+        min_y = std::min<int64_t>(min_y, c.y);
+        max_y = std::max<int64_t>(max_y, c.y);
+        
+    }
+    
+    double area = static_cast<double>(max_x - min_x + 1) * static_cast<double>(max_y - min_y + 1);
+    
+    // side of a square holding per_cell points on average
+    double side = std::sqrt(area * per_cell / static_cast<double>(count));
+    
+    cell_size = std::max<int64_t>(1, static_cast<int64_t>(std::ceil(side)));
+    
+    num_columns = (max_x - min_x) / cell_size + 1;
+    num_rows = (max_y - min_y) / cell_size + 1;
+    
+    // Points on a line make a long thin grid; cap it at a few cells per point
+    while (static_cast<uint64_t>(num_columns) * static_cast<uint64_t>(num_rows) > 4 * count + 16) {
+        
+        cell_size *= 2;
+        
+        num_columns = (max_x - min_x) / cell_size + 1;
+        num_rows = (max_y - min_y) / cell_size + 1;
+        
+    }
+    
+    size_t num_cells = static_cast<size_t>(num_columns * num_rows);
+    
+    // Counting sort of the points by cell
+    std::vector<uint32_t> cell_of_point(count);
+    
+    cell_start.assign(num_cells + 1, 0);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        const Coordinate &c = coords[ids[i]];
+        
+        cell_of_point[i] = static_cast<uint32_t>(row_of(c.y) * num_columns + column_of(c.x));
+        
+        cell_start[cell_of_point[i] + 1]++;
+        
+    }
+    
+    for (size_t cell = 0; cell < num_cells; cell++) {
+        
+        cell_start[cell + 1] += cell_start[cell];
+        
+    }
+    
+    points.resize(count);
+    point_coords.resize(count);
+    
+    std::vector<uint32_t> next(cell_start.begin(), cell_start.end() - 1);
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        uint32_t slot = next[cell_of_point[i]]++;
+        
+        points[slot] = ids[i];
+        point_coords[slot] = coords[ids[i]];
+        
+    }
+    
+}
+
+int64_t StaticGrid::get_cell_size() const {
+    
+    return cell_size;
+    
+}
+
+const std::vector<uint32_t> &StaticGrid::get_points() const {
+    
+    return points;
+    
+}
+
+const std::vector<Coordinate> &StaticGrid::get_point_coords() const {
+    
+    return point_coords;
+    
+}
+
+int64_t StaticGrid::ring_lower_bound(int64_t ring) const {
+    
+    return ring * cell_size;
+    
+}
+
+int64_t StaticGrid::column_of(int x) const {
+    
+    // floor division (x can lie left of the grid)
+    int64_t offset = x - min_x;
+    
+    return (offset >= 0) ? offset / cell_size : -((-offset + cell_size - 1) / cell_size);
+    
+}
+
+int64_t StaticGrid::row_of(int y) const {
+    
+    int64_t offset = y - min_y;
+    
+    return (offset >= 0) ? offset / cell_size : -((-offset + cell_size - 1) / cell_size);
+    
+}
+
+// ----------------------------------------------------------------------------
+//                    BorderIndex Definitions
+// ----------------------------------------------------------------------------
+
+void BorderIndex::build(const Coordinate *coords, size_t count) {
+    
+    x_axis.clear();
+    y_axis.clear();
+    
+    for (size_t i = 0; i < count; i++) {
+        
+        if (zone_of(coords[i]) != LocationType::Border) {
+            
+            continue;
+            
+        }
+        
+        // (0, 0) goes with the x axis
+        if (coords[i].y == 0) {
+            
+            x_axis.emplace_back(coords[i].x, static_cast<uint32_t>(i));
+            
+        }
+        
+        else {
+            
+            y_axis.emplace_back(coords[i].y, static_cast<uint32_t>(i));
+            
+        }
+        
+    }
+    
+    std::sort(x_axis.begin(), x_axis.end());
+    std::sort(y_axis.begin(), y_axis.end());
+    
+}
+
+bool BorderIndex::empty() const {
+    
+    return x_axis.empty() && y_axis.empty();
+    
+}
+
+size_t BorderIndex::nearest(const Coordinate &c) const {
+    
+    size_t best = SIZE_MAX;
+    int64_t best_distance = std::numeric_limits<int64_t>::max();
+    
+    // Points on one ray, seen from 'along' (c's position along the ray) at
+    // perpendicular offset 'across': the closest is next to where 'along'
+    // would be inserted
+    auto search = [&](const std::vector<std::pair<int, uint32_t>> &ray, int along, int across) {
+        
+        auto it = std::lower_bound(ray.begin(), ray.end(), std::make_pair(along, uint32_t(0)));
+        
+        for (auto candidate : { it, (it == ray.begin()) ? ray.end() : it - 1 }) {
+            
+            if (candidate == ray.end()) {
+                
+                continue;
+                
+            }
+            
+            int64_t d_along = static_cast<int64_t>(candidate->first) - along;
+            int64_t d_across = across;
+            int64_t distance = squared_offset(d_along, d_across);
+            
+            if (distance < best_distance || (distance == best_distance && candidate->second < best)) {
+                
+                best_distance = distance;
+                best = candidate->second;
+                
+            }
+            
+        }
+        
+    };
+    
+    search(x_axis, c.x, c.y);
+    search(y_axis, c.y, c.x);
+    
+    return best;
+    
+}
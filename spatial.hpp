@@ -0,0 +1,564 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  spatial.hpp
+//  project4
+//
+//  Spatial helpers shared by the solvers: squared distance keys, zone
+//  rules, octant (cone) classification, Hilbert curve ordering, point grids
+//  for neighbor queries and a nearest-Border lookup.
+//
+
+#ifndef SPATIAL_HPP
+#define SPATIAL_HPP
+
+#include "drone.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+
+
+// ----------------------------------------------------------------------------
+//                    Zone Helpers
+// ----------------------------------------------------------------------------
+
+// Same classification the Location constructor uses in MST mode
+inline LocationType zone_of(const Coordinate &c) {
+
+    if (c.x < 0 && c.y < 0) {
+
+        return LocationType::Medical;
+
+    }
+
+    if ((c.x < 0 && c.y == 0) || (c.y < 0 && c.x == 0) || (c.x == 0 && c.y == 0)) {
+
+        return LocationType::Border;
+
+    }
+
+    return LocationType::Normal;
+
+}
+
+// false only for Medical <-> Normal (get_distance() returns infinity)
+inline bool zones_compatible(LocationType t1, LocationType t2) {
+
+    return !((t1 == LocationType::Medical && t2 == LocationType::Normal) ||
+             (t2 == LocationType::Medical && t1 == LocationType::Normal));
+
+}
+
+// Zone classes used by the cone searches:
+// class 0 = Medical + Border, class 1 = Normal + Border
+// (Border and Empty locations belong to both)
+inline bool in_zone_class(LocationType t, size_t zone_class) {
+
+    return (zone_class == 0) ? (t != LocationType::Normal) : (t != LocationType::Medical);
+
+}
+
+// ----------------------------------------------------------------------------
+//                    Squared Distances
+// ----------------------------------------------------------------------------
+
+// Distances are compared as int64 squared distance keys. Below
+// exact_squared_limit a key is the exact dx^2 + dy^2; above it, where int
+// coordinates can reach 2^65, it is exact_squared_limit + (dx^2 + dy^2 -
+// exact_squared_limit) / 8, rounded down. Keys never put two distances in
+// the wrong order; above the limit, squares less than 8 apart may tie.
+const int64_t exact_squared_limit = int64_t(1) << 62;
+
+// Above the key of any two int coordinates (and below unreachable_distance)
+const int64_t max_squared_key = INT64_MAX - 1;
+
+// squared_offset() for offsets of 2^30 or more, whose squares can overflow
+int64_t wide_squared_offset(uint64_t ax, uint64_t ay);
+
+// Key of the offset (dx, dy). Works for any offset below 2^33 on each axis
+// (search bounds can pass the farthest location); keys of longer offsets
+// are max_squared_key.
+inline int64_t squared_offset(int64_t dx, int64_t dy) {
+
+    uint64_t ax = static_cast<uint64_t>(std::abs(dx));
+    uint64_t ay = static_cast<uint64_t>(std::abs(dy));
+
+    if ((ax | ay) < (uint64_t(1) << 30)) {
+
+        return static_cast<int64_t>(ax * ax + ay * ay);
+
+    }
+
+    return wide_squared_offset(ax, ay);
+
+}
+
+inline int64_t squared_distance(const Coordinate &a, const Coordinate &b) {
+
+    return squared_offset(static_cast<int64_t>(a.x) - b.x, static_cast<int64_t>(a.y) - b.y);
+
+}
+
+// The squared distance a key stands for
+inline double squared_value(int64_t key) {
+
+    if (key < exact_squared_limit) {
+
+        return static_cast<double>(key);
+
+    }
+
+    return static_cast<double>(exact_squared_limit) + 8 * static_cast<double>(key - exact_squared_limit);
+
+}
+
+// The key of a squared distance given as a double, rounded down (for
+// search bounds scaled in double)
+inline int64_t squared_key(double value) {
+
+    if (value < static_cast<double>(exact_squared_limit)) {
+
+        return static_cast<int64_t>(std::max(value, 0.0));
+
+    }
+
+    double eighths = (value - static_cast<double>(exact_squared_limit)) / 8;
+
+    if (eighths >= static_cast<double>(max_squared_key - exact_squared_limit)) {
+
+        return max_squared_key;
+
+    }
+
+    return exact_squared_limit + static_cast<int64_t>(eighths);
+
+}
+
+// The distance a key stands for: one sqrt of an exact integer below
+// exact_squared_limit, so the same double on every machine
+inline double squared_length(int64_t key) {
+
+    return std::sqrt(squared_value(key));
+
+}
+
+// ----------------------------------------------------------------------------
+//                    Octants
+// ----------------------------------------------------------------------------
+
+const size_t num_octants = 8;
+
+// Which 45 degree cone around 'from' the point 'to' lies in (0 - 7).
+// Two points in the same cone make an angle below 60 degrees at 'from', so
+// only the nearest point of each cone can be a Euclidean MST neighbor (the
+// Yao graph with 8 cones contains the MST).
+size_t octant_of(const Coordinate &from, const Coordinate &to);
+
+// Same for the offset (dx, dy) = to - from, which may exceed 32 bits
+size_t octant_of(int64_t dx, int64_t dy);
+
+// ----------------------------------------------------------------------------
+//                    Hilbert Curve
+// ----------------------------------------------------------------------------
+
+// Position of c along a Hilbert curve covering the whole int plane. Points
+// close on the curve are close in the plane.
+uint64_t hilbert_index(const Coordinate &c);
+
+// order[k] = the location visited k-th along the Hilbert curve
+void hilbert_order(const Coordinate *coords, size_t count, std::vector<size_t> &order);
+
+// Same order from keys[i] = hilbert_index() of location i, computed earlier
+void hilbert_order(const uint64_t *keys, size_t count, std::vector<size_t> &order);
+
+// ----------------------------------------------------------------------------
+//                    PointGrid Declarations
+// ----------------------------------------------------------------------------
+
+// Uniform grid over an unbounded plane (cells are hashed), supporting point
+// insertion and removal. Points are identified by their location number.
+class PointGrid {
+
+public:
+
+    PointGrid();
+
+    // Picks a cell size giving roughly 'per_cell' points per cell
+    void reset(const Coordinate *coords, size_t count, double per_cell);
+
+    void insert(uint32_t id, const Coordinate &c);
+
+    void remove(uint32_t id, const Coordinate &c);
+
+    int64_t get_cell_size() const;
+
+    // Calls visit(id) for every point in the ring of cells at Chebyshev
+    // distance 'ring' from the cell containing c. Returns false once the
+    // ring lies entirely outside the cells that have ever been occupied.
+    template <typename Visit>
+    bool visit_ring(const Coordinate &c, int64_t ring, Visit visit) const;
+
+    // Chebyshev distance (in cells) from the cell containing c to the
+    // occupied area: the rings below it are empty, so a search around a far
+    // outlier starts here (0 inside the area or for an empty grid)
+    int64_t first_ring(const Coordinate &c) const;
+
+    // Visits rings outward from first_ring(c), calling done(ring) after
+    // each, until it returns true or no points are left. Once the rings
+    // have walked more cells than are occupied (an outlier stretched the
+    // occupied area), the rest is visited in one pass over the occupied
+    // cells instead, so a search never costs more than about two passes.
+    template <typename Visit, typename Done>
+    void visit_rings(const Coordinate &c, Visit visit, Done done) const;
+
+    // Every point of ring r + 1 and beyond is at least this far from c
+    double ring_lower_bound(int64_t ring) const;
+
+private:
+
+    // visit_ring(), adding the number of cells looked up to walked
+    template <typename Visit>
+    bool walk_ring(const Coordinate &c, int64_t ring, Visit visit, size_t &walked) const;
+
+    int64_t cell_of(int coord) const;
+
+    static uint64_t key_of(int64_t cx, int64_t cy);
+
+    int64_t cell_size;
+
+    // Bounding box (in cells) of everything ever inserted
+    int64_t min_cx, max_cx, min_cy, max_cy;
+
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+
+};
+
+// ----------------------------------------------------------------------------
+//                    PointGrid Template Definitions
+// ----------------------------------------------------------------------------
+
+template <typename Visit>
+bool PointGrid::visit_ring(const Coordinate &c, int64_t ring, Visit visit) const {
+
+    size_t walked = 0;
+
+    return walk_ring(c, ring, visit, walked);
+
+}
+
+template <typename Visit, typename Done>
+void PointGrid::visit_rings(const Coordinate &c, Visit visit, Done done) const {
+
+    size_t walked = 0;
+
+    for (int64_t ring = first_ring(c); ; ring++) {
+
+        if (walked > cells.size()) {
+
+            int64_t cx = cell_of(c.x);
+            int64_t cy = cell_of(c.y);
+
+            // Everything from this ring outwards, cell by cell
+            for (const auto &cell : cells) {
+
+                int64_t x = static_cast<int32_t>(cell.first >> 32);
+                int64_t y = static_cast<int32_t>(cell.first & 0xffffffffu);
+
+                if (std::max(std::abs(x - cx), std::abs(y - cy)) >= ring) {
+
+                    for (uint32_t id : cell.second) {
+
+                        visit(id);
+
+                    }
+
+                }
+
+            }
+
+            return;
+
+        }
+
+        if (!walk_ring(c, ring, visit, walked) || done(ring)) {
+
+            return;
+
+        }
+
+    }
+
+}
+
+template <typename Visit>
+bool PointGrid::walk_ring(const Coordinate &c, int64_t ring, Visit visit, size_t &walked) const {
+
+    int64_t cx = cell_of(c.x);
+    int64_t cy = cell_of(c.y);
+
+    // Ring is completely outside the occupied area
+    if (cx - ring < min_cx && cx + ring > max_cx && cy - ring < min_cy && cy + ring > max_cy) {
+
+        return false;
+
+    }
+
+    auto visit_cell = [&](int64_t x, int64_t y) {
+
+        walked++;
+
+        auto it = cells.find(key_of(x, y));
+
+        if (it != cells.end()) {
+
+            for (uint32_t id : it->second) {
+
+                visit(id);
+
+            }
+
+        }
+
+    };
+
+    // Only the part of the ring inside the occupied area is walked
+    int64_t low_x = std::max(cx - ring, min_cx);
+    int64_t high_x = std::min(cx + ring, max_cx);
+
+    // Top and bottom rows of the ring
+    for (int64_t y : { cy - ring, cy + ring }) {
+
+        if (y >= min_cy && y <= max_cy) {
+
+            for (int64_t x = low_x; x <= high_x; x++) {
+
+                visit_cell(x, y);
+
+            }
+
+        }
+
+        if (ring == 0) {
+
+            return true;
+
+        }
+
+    }
+
+    // Side columns, between those rows
+    int64_t low_y = std::max(cy - ring + 1, min_cy);
+    int64_t high_y = std::min(cy + ring - 1, max_cy);
+
+    for (int64_t x : { cx - ring, cx + ring }) {
+
+        if (x >= min_cx && x <= max_cx) {
+
+            for (int64_t y = low_y; y <= high_y; y++) {
+
+                visit_cell(x, y);
+
+            }
+
+        }
+
+    }
+
+    return true;
+
+}
+
+// ----------------------------------------------------------------------------
+//                    StaticGrid Declarations
+// ----------------------------------------------------------------------------
+
+// Grid over a fixed set of points, stored cell by cell (CSR): one array of
+// cell starts and the points (ids and coordinates) sorted by cell. Cheaper
+// to build and faster to scan than PointGrid when nothing moves.
+class StaticGrid {
+
+public:
+
+    StaticGrid();
+
+    // ids[0 .. count - 1] are the points (location numbers) to index
+    void build(const Coordinate *coords, const uint32_t *ids, size_t count, double per_cell);
+
+    int64_t get_cell_size() const;
+
+    // Points in cell order (neighbors in the plane are close in this order)
+    const std::vector<uint32_t> &get_points() const;
+
+    // Coordinates of get_points(), same order
+    const std::vector<Coordinate> &get_point_coords() const;
+
+    // Calls visit(id, coordinate) for every point in the ring of cells at
+    // Chebyshev distance 'ring' from the cell containing c. Returns false
+    // once the ring encloses the whole grid.
+    template <typename Visit>
+    bool visit_ring(const Coordinate &c, int64_t ring, Visit visit) const;
+
+    // Same, calling visit(slot) with the point's index into get_points()
+    template <typename Visit>
+    bool visit_ring_slots(const Coordinate &c, int64_t ring, Visit visit) const;
+
+    // Every point of ring r + 1 and beyond is at least this far from c
+    int64_t ring_lower_bound(int64_t ring) const;
+
+private:
+
+    // Calls visit_slots(begin, end) with the slot range of every cell in
+    // the ring
+    template <typename VisitCell>
+    bool visit_ring_cells(const Coordinate &c, int64_t ring, VisitCell visit_slots) const;
+
+    int64_t column_of(int x) const;
+
+    int64_t row_of(int y) const;
+
+    int64_t min_x, min_y;
+
+    int64_t cell_size;
+
+    int64_t num_columns, num_rows;
+
+    // Points of cell (column, row) are [cell_start[row * num_columns + column],
+    // cell_start[... + 1])
+    std::vector<uint32_t> cell_start;
+
+    std::vector<uint32_t> points;
+
+    std::vector<Coordinate> point_coords;
+
+};
+
+// ----------------------------------------------------------------------------
+//                    BorderIndex Declarations
+// ----------------------------------------------------------------------------
+
+// Border locations lie on two rays (x <= 0 on the x axis, y < 0 on the y
+// axis); kept sorted along each, the nearest one is a binary search away.
+class BorderIndex {
+
+public:
+
+    void build(const Coordinate *coords, size_t count);
+
+    bool empty() const;
+
+    // Nearest Border location to c (SIZE_MAX if there are none)
+    size_t nearest(const Coordinate &c) const;
+
+private:
+
+    // (position along the ray, location number), sorted
+    std::vector<std::pair<int, uint32_t>> x_axis;
+    std::vector<std::pair<int, uint32_t>> y_axis;
+
+};
+
+// ----------------------------------------------------------------------------
+//                    StaticGrid Template Definitions
+// ----------------------------------------------------------------------------
+
+template <typename Visit>
+bool StaticGrid::visit_ring(const Coordinate &c, int64_t ring, Visit visit) const {
+    
+    return visit_ring_cells(c, ring, [&](uint32_t begin, uint32_t end) {
+        
+        for (uint32_t slot = begin; slot < end; slot++) {
+            
+            visit(points[slot], point_coords[slot]);
+            
+        }
+        
+    });
+    
+}
+
+template <typename Visit>
+bool StaticGrid::visit_ring_slots(const Coordinate &c, int64_t ring, Visit visit) const {
+    
+    return visit_ring_cells(c, ring, [&](uint32_t begin, uint32_t end) {
+        
+        for (uint32_t slot = begin; slot < end; slot++) {
+            
+            visit(slot);
+            
+        }
+        
+    });
+    
+}
+
+template <typename VisitCell>
+bool StaticGrid::visit_ring_cells(const Coordinate &c, int64_t ring, VisitCell visit_slots) const {
+    
+    int64_t cx = column_of(c.x);
+    int64_t cy = row_of(c.y);
+    
+    // Ring is completely outside the grid (the rings inside it covered it)
+    if (cx - ring < 0 && cx + ring >= num_columns && cy - ring < 0 && cy + ring >= num_rows) {
+        
+        return false;
+        
+    }
+    
+    auto visit_cell = [&](int64_t x, int64_t y) {
+        
+        size_t cell = static_cast<size_t>(y * num_columns + x);
+        
+        visit_slots(cell_start[cell], cell_start[cell + 1]);
+        
+    };
+    
+    int64_t low_x = std::max<int64_t>(cx - ring, 0);
+    int64_t high_x = std::min<int64_t>(cx + ring, num_columns - 1);
+    
+    // Top and bottom rows of the ring
+    for (int64_t y : { cy - ring, cy + ring }) {
+        
+        if (y >= 0 && y < num_rows) {
+            
+            for (int64_t x = low_x; x <= high_x; x++) {
+                
+                visit_cell(x, y);
+                
+            }
+            
+        }
+        
+        if (ring == 0) {
+            
+            return true;
+            
+        }
+        
+    }
+    
+    // Side columns, between those rows
+    int64_t low_y = std::max<int64_t>(cy - ring + 1, 0);
+    int64_t high_y = std::min<int64_t>(cy + ring - 1, num_rows - 1);
+    
+    for (int64_t x : { cx - ring, cx + ring }) {
+        
+        if (x >= 0 && x < num_columns) {
+            
+            for (int64_t y = low_y; y <= high_y; y++) {
+                
+                visit_cell(x, y);
+                
+            }
+            
+        }
+        
+    }
+    
+    return true;
+    
+}
+
+#endif /* SPATIAL_HPP */
@@ -0,0 +1,96 @@
+// Project Identifier: 1761414855B69983BD8035097EFBD312EB0527F0
+//
+//  text_to_binary.cpp
+//  project4
+//
+//  Converts a location list from the text input format to the binary
+//  format of binary_input.hpp, which the drone maps in place when it is
+//  given as stdin:
+//
+//      ./text_to_binary [--zones] < campus.txt > campus.bin
+//      ./drone -m MST < campus.bin
+//
+//  --zones also stores each location's LocationType. The header (count,
+//  locations per zone, bounding box) is printed to stderr.
+//
+//  Build from the project directory:
+//
+//      g++ -std=c++17 -O3 -pthread -I. tools/text_to_binary.cpp binary_input.cpp drone_solver.cpp cluster_tour.cpp greedy_tour.cpp insertion_engines.cpp lk_search.cpp mst_engines.cpp neighbor_graph.cpp online_tour.cpp spatial.cpp -o text_to_binary
+//
+
+#include "drone.hpp"
+#include "binary_input.hpp"
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+
+int main(int argc, char** argv) {
+    
+    bool with_zones = false;
+    
+    for (int i = 1; i < argc; i++) {
+        
+        if (std::strcmp(argv[i], "--zones") == 0) {
+            
+            with_zones = true;
+            
+        }
+        
+        else {
+            
+            std::cerr << "Usage: ./text_to_binary [--zones] < input.txt > output.bin\n";
+            
+            return 1;
+            
+        }
+        
+    }
+    
+    std::ios_base::sync_with_stdio(false);
+    
+    std::vector<Coordinate> coords;
+    
+    try {
+        
+        read_input(std::cin, coords);
+        
+    }
+    
+    catch (const DroneError &e) {
+        
+        std::cerr << e.what() << "\n";
+        
+        return 1;
+        
+    }
+    
+    // Written to memory first, so the summary can echo the header
+    std::ostringstream os;
+    
+    write_binary_input(os, coords.data(), coords.size(), with_zones);
+    
+    std::string bytes = os.str();
+    
+    BinaryHeader header;
+    
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    
+    std::cout.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    
+    if (!std::cout) {
+        
+        std::cerr << "Error: Could not write the binary file\n";
+        
+        return 1;
+        
+    }
+    
+    std::cerr << header.count << " locations (" << header.zone_counts[0] << " Medical, " << header.zone_counts[1]
+    << " Border, " << header.zone_counts[2] << " Normal), x in [" << header.min_x << ", " << header.max_x
+    << "], y in [" << header.min_y << ", " << header.max_y << "], " << bytes.size() << " bytes\n";
+    
+    return 0;
+    
+}